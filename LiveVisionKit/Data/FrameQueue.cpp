@@ -0,0 +1,274 @@
+//     *************************** LiveVisionKit ****************************
+//     Copyright (C) 2022  Sebastian Di Marco (crowsinc.dev@gmail.com)
+//
+//     This program is free software: you can redistribute it and/or modify
+//     it under the terms of the GNU General Public License as published by
+//     the Free Software Foundation, either version 3 of the License, or
+//     (at your option) any later version.
+//
+//     This program is distributed in the hope that it will be useful,
+//     but WITHOUT ANY WARRANTY; without even the implied warranty of
+//     MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//     GNU General Public License for more details.
+//
+//     You should have received a copy of the GNU General Public License
+//     along with this program.  If not, see <https://www.gnu.org/licenses/>.
+//     **********************************************************************
+
+#include "FrameQueue.hpp"
+
+#include "Directives.hpp"
+
+namespace lvk
+{
+
+//---------------------------------------------------------------------------------------------------------------------
+
+    // NOTE: the number of oldest frames which are always kept resident.
+    constexpr size_t PREFETCH_FRAMES = 2;
+
+    constexpr size_t BYTES_PER_MB = 1024 * 1024;
+
+//---------------------------------------------------------------------------------------------------------------------
+
+    static size_t device_bytes(const VideoFrame& frame)
+    {
+        size_t bytes = frame.total() * frame.elemSize();
+        for(const auto& plane : frame.chroma)
+            bytes += plane.total() * plane.elemSize();
+
+        return bytes;
+    }
+
+//---------------------------------------------------------------------------------------------------------------------
+
+    FrameQueue::FrameQueue(const size_t capacity, const FrameQueueSettings& settings)
+        : m_Entries(capacity)
+    {
+        configure(settings);
+    }
+
+//---------------------------------------------------------------------------------------------------------------------
+
+    void FrameQueue::configure(const FrameQueueSettings& settings)
+    {
+        m_Settings = settings;
+
+        // Apply the new memory limit to the frames already queued.
+        enforce_memory_limit();
+    }
+
+//---------------------------------------------------------------------------------------------------------------------
+
+    void FrameQueue::push(VideoFrame&& frame)
+    {
+        LVK_ASSERT(frame.has_known_format());
+
+        // Re-use the entry being overwritten, along with its buffers.
+        auto& entry = m_Entries.advance();
+        entry.format = frame.format;
+        entry.spilled = false;
+        entry.ready = ocl::Event();
+
+        if(m_Settings.compact_frame_storage && !frame.is_planar())
+            frame.reformatTo(entry.frame, VideoFrame::NV12);
+        else
+            std::swap(entry.frame, frame);
+
+        enforce_memory_limit();
+    }
+
+//---------------------------------------------------------------------------------------------------------------------
+
+    void FrameQueue::pop(VideoFrame& dst)
+    {
+        LVK_ASSERT(!is_empty());
+
+        auto& entry = m_Entries.oldest();
+        if(entry.spilled)
+            restore(entry);
+
+        // Ensure any prefetch of the frame has finished before we use it.
+        auto& context = ocl::ExecutionContext::Default();
+        context.wait(ocl::ExecutionContext::COMPUTE, entry.ready);
+
+        // NOTE: compacted entries keep their buffers for re-use, as they're never shared.
+        if(entry.frame.format != entry.format)
+            entry.frame.reformatTo(dst, entry.format);
+        else
+            dst = std::move(entry.frame);
+
+        m_Entries.skip();
+        prefetch();
+    }
+
+//---------------------------------------------------------------------------------------------------------------------
+
+    void FrameQueue::resize(const size_t capacity)
+    {
+        m_Entries.resize(capacity);
+
+        enforce_memory_limit();
+        prefetch();
+    }
+
+//---------------------------------------------------------------------------------------------------------------------
+
+    void FrameQueue::clear()
+    {
+        m_Entries.clear();
+    }
+
+//---------------------------------------------------------------------------------------------------------------------
+
+    VideoFrame& FrameQueue::newest()
+    {
+        LVK_ASSERT(!is_empty());
+
+        auto& entry = m_Entries.newest();
+        if(entry.spilled)
+            restore(entry);
+
+        auto& context = ocl::ExecutionContext::Default();
+        context.wait(ocl::ExecutionContext::COMPUTE, entry.ready);
+
+        return entry.frame;
+    }
+
+//---------------------------------------------------------------------------------------------------------------------
+
+    const VideoFrame& FrameQueue::oldest() const
+    {
+        LVK_ASSERT(!is_empty());
+
+        return m_Entries.oldest().frame;
+    }
+
+//---------------------------------------------------------------------------------------------------------------------
+
+    bool FrameQueue::is_full() const
+    {
+        return m_Entries.is_full();
+    }
+
+//---------------------------------------------------------------------------------------------------------------------
+
+    bool FrameQueue::is_empty() const
+    {
+        return m_Entries.is_empty();
+    }
+
+//---------------------------------------------------------------------------------------------------------------------
+
+    size_t FrameQueue::size() const
+    {
+        return m_Entries.size();
+    }
+
+//---------------------------------------------------------------------------------------------------------------------
+
+    size_t FrameQueue::capacity() const
+    {
+        return m_Entries.capacity();
+    }
+
+//---------------------------------------------------------------------------------------------------------------------
+
+    size_t FrameQueue::device_memory_usage() const
+    {
+        size_t bytes = 0;
+        for(const auto& entry : m_Entries)
+            if(!entry.spilled) bytes += device_bytes(entry.frame);
+
+        return bytes;
+    }
+
+//---------------------------------------------------------------------------------------------------------------------
+
+    size_t FrameQueue::host_memory_usage() const
+    {
+        size_t bytes = 0;
+        for(const auto& entry : m_Entries)
+            for(const auto& plane : entry.host_planes)
+                bytes += plane.total() * plane.elemSize();
+
+        return bytes;
+    }
+
+//---------------------------------------------------------------------------------------------------------------------
+
+    void FrameQueue::spill(Entry& entry)
+    {
+        LVK_ASSERT(!entry.spilled);
+
+        // NOTE: the download is made on the current queue, after the frame is produced.
+        static_cast<const cv::UMat&>(entry.frame).copyTo(entry.host_planes[0]);
+        entry.frame.release();
+
+        for(size_t i = 0; i < entry.frame.chroma.size(); i++)
+        {
+            if(!entry.frame.chroma[i].empty())
+                entry.frame.chroma[i].copyTo(entry.host_planes[i + 1]);
+            entry.frame.chroma[i].release();
+        }
+
+        entry.spilled = true;
+        entry.ready = ocl::Event();
+    }
+
+//---------------------------------------------------------------------------------------------------------------------
+
+    void FrameQueue::restore(Entry& entry)
+    {
+        LVK_ASSERT(entry.spilled);
+
+        // Upload on the transfer queue, so that prefetches overlap with the filtering.
+        auto& context = ocl::ExecutionContext::Default();
+        {
+            ocl::ExecutionContext::Scope transfer_scope(context, ocl::ExecutionContext::TRANSFER);
+
+            entry.host_planes[0].copyTo(static_cast<cv::UMat&>(entry.frame));
+            for(size_t i = 0; i < entry.frame.chroma.size(); i++)
+                if(!entry.host_planes[i + 1].empty())
+                    entry.host_planes[i + 1].copyTo(entry.frame.chroma[i]);
+        }
+        entry.ready = context.record(ocl::ExecutionContext::TRANSFER);
+
+        for(auto& plane : entry.host_planes)
+            plane.release();
+
+        entry.spilled = false;
+    }
+
+//---------------------------------------------------------------------------------------------------------------------
+
+    void FrameQueue::enforce_memory_limit()
+    {
+        if(m_Settings.frame_memory_limit_mb == 0 || m_Entries.size() <= PREFETCH_FRAMES)
+            return;
+
+        const size_t memory_limit = m_Settings.frame_memory_limit_mb * BYTES_PER_MB;
+        size_t memory_usage = device_memory_usage();
+
+        // Spill the newest frames first, as they are needed last.
+        for(size_t i = m_Entries.size() - 1; i >= PREFETCH_FRAMES && memory_usage > memory_limit; i--)
+        {
+            if(auto& entry = m_Entries[i]; !entry.spilled)
+            {
+                memory_usage -= device_bytes(entry.frame);
+                spill(entry);
+            }
+        }
+    }
+
+//---------------------------------------------------------------------------------------------------------------------
+
+    void FrameQueue::prefetch()
+    {
+        for(size_t i = 0; i < std::min(PREFETCH_FRAMES, m_Entries.size()); i++)
+            if(m_Entries[i].spilled) restore(m_Entries[i]);
+    }
+
+//---------------------------------------------------------------------------------------------------------------------
+
+}
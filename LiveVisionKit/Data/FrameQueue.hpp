@@ -0,0 +1,102 @@
+//     *************************** LiveVisionKit ****************************
+//     Copyright (C) 2022  Sebastian Di Marco (crowsinc.dev@gmail.com)
+//
+//     This program is free software: you can redistribute it and/or modify
+//     it under the terms of the GNU General Public License as published by
+//     the Free Software Foundation, either version 3 of the License, or
+//     (at your option) any later version.
+//
+//     This program is distributed in the hope that it will be useful,
+//     but WITHOUT ANY WARRANTY; without even the implied warranty of
+//     MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//     GNU General Public License for more details.
+//
+//     You should have received a copy of the GNU General Public License
+//     along with this program.  If not, see <https://www.gnu.org/licenses/>.
+//     **********************************************************************
+
+#pragma once
+
+#include <array>
+#include <opencv2/opencv.hpp>
+
+#include "VideoFrame.hpp"
+#include "StreamBuffer.hpp"
+#include "Utility/Configurable.hpp"
+#include "Functions/OpenCL/Execution.hpp"
+
+namespace lvk
+{
+
+    struct FrameQueueSettings
+    {
+        // NOTE: packed frames are stored as NV12 while they're queued and are
+        // restored to their original format when popped. The alpha channel
+        // of BGRA and RGBA frames is not preserved.
+        bool compact_frame_storage = false;
+
+        // NOTE: queued frames beyond the device memory limit are spilled to host
+        // memory, then prefetched before they are needed. Zero is unlimited.
+        size_t frame_memory_limit_mb = 0;
+    };
+
+    // NOTE: A queue for delaying frames, which bounds the device memory it uses.
+    // The oldest frames are always kept resident, so they are ready to be popped.
+    class FrameQueue final : public Configurable<FrameQueueSettings>
+    {
+    public:
+
+        explicit FrameQueue(const size_t capacity, const FrameQueueSettings& settings = {});
+
+        void configure(const FrameQueueSettings& settings) override;
+
+        void push(VideoFrame&& frame);
+
+        void pop(VideoFrame& dst);
+
+        void resize(const size_t capacity);
+
+        void clear();
+
+        // NOTE: the frame is in its stored format, which may be compacted.
+        VideoFrame& newest();
+
+        const VideoFrame& oldest() const;
+
+        bool is_full() const;
+
+        bool is_empty() const;
+
+        size_t size() const;
+
+        size_t capacity() const;
+
+        size_t device_memory_usage() const;
+
+        size_t host_memory_usage() const;
+
+    private:
+
+        struct Entry
+        {
+            VideoFrame frame;
+            VideoFrame::Format format = VideoFrame::UNKNOWN;
+
+            bool spilled = false;
+            ocl::Event ready;
+            std::array<cv::Mat, 3> host_planes;
+        };
+
+        void spill(Entry& entry);
+
+        void restore(Entry& entry);
+
+        void enforce_memory_limit();
+
+        void prefetch();
+
+    private:
+        StreamBuffer<Entry> m_Entries;
+    };
+
+}
@@ -0,0 +1,53 @@
+//     *************************** LiveVisionKit ****************************
+//     Copyright (C) 2022  Sebastian Di Marco (crowsinc.dev@gmail.com)
+//
+//     This program is free software: you can redistribute it and/or modify
+//     it under the terms of the GNU General Public License as published by
+//     the Free Software Foundation, either version 3 of the License, or
+//     (at your option) any later version.
+//
+//     This program is distributed in the hope that it will be useful,
+//     but WITHOUT ANY WARRANTY; without even the implied warranty of
+//     MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//     GNU General Public License for more details.
+//
+//     You should have received a copy of the GNU General Public License
+//     along with this program.  If not, see <https://www.gnu.org/licenses/>.
+//     **********************************************************************
+
+#include "FrameSource.hpp"
+
+#include "Timing/Time.hpp"
+#include "Directives.hpp"
+
+namespace lvk
+{
+
+//---------------------------------------------------------------------------------------------------------------------
+
+    CaptureSource::CaptureSource(cv::VideoCapture& capture)
+        : m_Capture(capture)
+    {
+        LVK_ASSERT(capture.isOpened());
+    }
+
+//---------------------------------------------------------------------------------------------------------------------
+
+    bool CaptureSource::read(VideoFrame& frame)
+    {
+        if(!m_Capture.read(frame))
+            return false;
+
+        // Assume the input frame is BGR
+        frame.format = VideoFrame::BGR;
+
+        // Set frame timestamp if supported, otherwise set it to zero.
+        const auto stream_position = std::max(0.0, m_Capture.get(cv::CAP_PROP_POS_MSEC));
+        frame.timestamp = static_cast<uint64_t>(Time::Milliseconds(stream_position).nanoseconds());
+
+        return true;
+    }
+
+//---------------------------------------------------------------------------------------------------------------------
+
+}
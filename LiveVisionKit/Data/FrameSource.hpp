@@ -0,0 +1,51 @@
+//     *************************** LiveVisionKit ****************************
+//     Copyright (C) 2022  Sebastian Di Marco (crowsinc.dev@gmail.com)
+//
+//     This program is free software: you can redistribute it and/or modify
+//     it under the terms of the GNU General Public License as published by
+//     the Free Software Foundation, either version 3 of the License, or
+//     (at your option) any later version.
+//
+//     This program is distributed in the hope that it will be useful,
+//     but WITHOUT ANY WARRANTY; without even the implied warranty of
+//     MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//     GNU General Public License for more details.
+//
+//     You should have received a copy of the GNU General Public License
+//     along with this program.  If not, see <https://www.gnu.org/licenses/>.
+//     **********************************************************************
+
+#pragma once
+
+#include <opencv2/videoio.hpp>
+
+#include "VideoFrame.hpp"
+
+namespace lvk
+{
+
+    // NOTE: A frame source must set the format and timestamp of every frame it reads.
+    class FrameSource
+    {
+    public:
+
+        virtual ~FrameSource() = default;
+
+        // Returns false once the source has no more frames.
+        virtual bool read(VideoFrame& frame) = 0;
+    };
+
+
+    class CaptureSource final : public FrameSource
+    {
+    public:
+
+        explicit CaptureSource(cv::VideoCapture& capture);
+
+        bool read(VideoFrame& frame) override;
+
+    private:
+        cv::VideoCapture& m_Capture;
+    };
+
+}
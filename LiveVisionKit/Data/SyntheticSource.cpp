@@ -0,0 +1,342 @@
+//     *************************** LiveVisionKit ****************************
+//     Copyright (C) 2022  Sebastian Di Marco (crowsinc.dev@gmail.com)
+//
+//     This program is free software: you can redistribute it and/or modify
+//     it under the terms of the GNU General Public License as published by
+//     the Free Software Foundation, either version 3 of the License, or
+//     (at your option) any later version.
+//
+//     This program is distributed in the hope that it will be useful,
+//     but WITHOUT ANY WARRANTY; without even the implied warranty of
+//     MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//     GNU General Public License for more details.
+//
+//     You should have received a copy of the GNU General Public License
+//     along with this program.  If not, see <https://www.gnu.org/licenses/>.
+//     **********************************************************************
+
+#include "SyntheticSource.hpp"
+
+#include "Functions/Extensions.hpp"
+#include "Directives.hpp"
+
+namespace lvk
+{
+
+    constexpr auto NOISE_FIELD_MARGIN = 64;
+    constexpr auto SHAKE_WAVE_COUNT = 3;
+    constexpr auto SCENE_SHAPE_AREA = 96 * 96;
+
+//---------------------------------------------------------------------------------------------------------------------
+
+    SyntheticSource::SyntheticSource(const SyntheticSourceSettings& settings)
+    {
+        configure(settings);
+    }
+
+//---------------------------------------------------------------------------------------------------------------------
+
+    void SyntheticSource::configure(const SyntheticSourceSettings& settings)
+    {
+        LVK_ASSERT(settings.resolution.width >= 16 && settings.resolution.height >= 16);
+        LVK_ASSERT(settings.motion_resolution.height >= WarpMesh::MinimumSize.height);
+        LVK_ASSERT(settings.motion_resolution.width >= WarpMesh::MinimumSize.width);
+        LVK_ASSERT(settings.format != VideoFrame::UNKNOWN);
+        LVK_ASSERT(settings.frame_rate > 0.0f);
+        LVK_ASSERT_RANGE(settings.shake_translation, 0.0f, 0.25f);
+        LVK_ASSERT_RANGE(settings.shake_rotation, 0.0f, 10.0f);
+        LVK_ASSERT(settings.shake_frequency > 0.0f);
+        LVK_ASSERT_RANGE(settings.local_motion, 0.0f, 0.25f);
+        LVK_ASSERT(settings.block_size > 0);
+        LVK_ASSERT_01(settings.blocking_strength);
+        LVK_ASSERT(settings.noise_strength >= 0.0f);
+
+        m_Settings = settings;
+
+        // NOTE: All randomness is drawn from the seed, so that the same settings
+        // always produce exactly the same stream of frames and motions.
+        cv::RNG rng(settings.seed);
+
+        // The camera shake is a sum of sine waves in x, y and rotation.
+        m_ShakeWaves.create(3, SHAKE_WAVE_COUNT, CV_64FC3);
+        for(int r = 0; r < m_ShakeWaves.rows; r++)
+        {
+            double total_weight = 0.0;
+            for(int w = 0; w < SHAKE_WAVE_COUNT; w++)
+            {
+                auto& wave = m_ShakeWaves.at<cv::Vec3d>(r, w);
+                wave[0] = settings.shake_frequency * rng.uniform(0.05, 1.0);
+                wave[1] = rng.uniform(0.0, 2.0 * CV_PI);
+                wave[2] = rng.uniform(0.2, 1.0);
+                total_weight += wave[2];
+            }
+
+            for(int w = 0; w < SHAKE_WAVE_COUNT; w++)
+                m_ShakeWaves.at<cv::Vec3d>(r, w)[2] /= total_weight;
+        }
+
+        // Local motions are individually phased sine waves on each mesh vertex.
+        m_LocalPhases.create(settings.motion_resolution, CV_32FC2);
+        rng.fill(m_LocalPhases, cv::RNG::UNIFORM, cv::Scalar::all(0.0), cv::Scalar::all(2.0 * CV_PI));
+
+        // Zoom in on the scene enough to always keep it covering the frame.
+        const double rotation = settings.shake_rotation * CV_PI / 180.0;
+        const double aspect_ratio = std::max(
+            static_cast<double>(settings.resolution.width) / settings.resolution.height,
+            static_cast<double>(settings.resolution.height) / settings.resolution.width
+        );
+        m_PoseZoom = (1.0 + 2.0 * (settings.shake_translation + settings.local_motion))
+                   * (std::cos(rotation) + std::sin(rotation) * aspect_ratio);
+
+        m_MeshPose = WarpMesh(settings.motion_resolution);
+        m_LocalOffsets = WarpMesh(settings.motion_resolution);
+        m_PrevLocalOffsets = WarpMesh(settings.motion_resolution);
+
+        generate_scene();
+        generate_noise();
+        restart();
+    }
+
+//---------------------------------------------------------------------------------------------------------------------
+
+    bool SyntheticSource::read(VideoFrame& frame)
+    {
+        if(m_Settings.frame_count > 0 && m_FrameIndex >= m_Settings.frame_count)
+            return false;
+
+        render_frame(frame);
+        m_FrameIndex++;
+
+        return true;
+    }
+
+//---------------------------------------------------------------------------------------------------------------------
+
+    void SyntheticSource::restart()
+    {
+        m_FrameIndex = 0;
+        m_NoiseRNG = cv::RNG(m_Settings.seed + 1);
+        m_Motion = WarpMesh(m_Settings.motion_resolution);
+    }
+
+//---------------------------------------------------------------------------------------------------------------------
+
+    size_t SyntheticSource::frames_read() const
+    {
+        return m_FrameIndex;
+    }
+
+//---------------------------------------------------------------------------------------------------------------------
+
+    const WarpMesh& SyntheticSource::motion() const
+    {
+        return m_Motion;
+    }
+
+//---------------------------------------------------------------------------------------------------------------------
+
+    void SyntheticSource::generate_scene()
+    {
+        // NOTE: The scene is layered value noise, for texture at all scales,
+        // covered with solid shapes to give feature detectors strong corners.
+        const auto& resolution = m_Settings.resolution;
+        cv::RNG rng(m_Settings.seed);
+
+        cv::Mat scene(resolution, CV_32FC3, cv::Scalar::all(0.0)), noise_layer, noise_field;
+        float amplitude = 0.5f;
+        for(int scale = 64; scale >= 2; scale /= 2)
+        {
+            noise_layer.create(
+                std::max(resolution.height / scale, 2),
+                std::max(resolution.width / scale, 2),
+                CV_32FC3
+            );
+            rng.fill(noise_layer, cv::RNG::UNIFORM, cv::Scalar::all(-amplitude), cv::Scalar::all(amplitude));
+
+            cv::resize(noise_layer, noise_field, resolution, 0, 0, cv::INTER_CUBIC);
+            scene += noise_field;
+            amplitude *= 0.6f;
+        }
+
+        cv::Mat scene_bgr;
+        scene.convertTo(scene_bgr, CV_8UC3, 100.0, 128.0);
+
+        const int shape_count = resolution.area() / SCENE_SHAPE_AREA;
+        const double shape_scale = std::min(resolution.width, resolution.height) / 1080.0;
+        for(int i = 0; i < shape_count; i++)
+        {
+            const cv::Point centre(rng.uniform(0, resolution.width), rng.uniform(0, resolution.height));
+            const int size = std::max(static_cast<int>(rng.uniform(8.0, 64.0) * shape_scale), 2);
+            const cv::Scalar colour(rng.uniform(0, 256), rng.uniform(0, 256), rng.uniform(0, 256));
+            const int thickness = rng.uniform(0, 3) == 0 ? 2 : cv::FILLED;
+
+            if(rng.uniform(0, 2) == 0)
+                cv::rectangle(scene_bgr, cv::Rect(centre, cv::Size(size, rng.uniform(size / 2, size * 2 + 1))), colour, thickness);
+            else
+                cv::circle(scene_bgr, centre, size / 2, colour, thickness);
+        }
+
+        // Store the scene in the output format if it can be warped directly, otherwise use YUV.
+        const auto format = m_Settings.format;
+        const bool direct_format = format == VideoFrame::BGR || format == VideoFrame::RGB || format == VideoFrame::YUV;
+
+        m_Scene.format = direct_format ? format : VideoFrame::YUV;
+        if(m_Scene.format == VideoFrame::RGB)
+            cv::cvtColor(scene_bgr, scene_bgr, cv::COLOR_BGR2RGB);
+        else if(m_Scene.format == VideoFrame::YUV)
+            cv::cvtColor(scene_bgr, scene_bgr, cv::COLOR_BGR2YUV);
+
+        scene_bgr.copyTo(m_Scene);
+    }
+
+//---------------------------------------------------------------------------------------------------------------------
+
+    void SyntheticSource::generate_noise()
+    {
+        // NOTE: A single noise field is generated up front, then sampled at a random
+        // offset each frame. This keeps noise generation off of the hot path.
+        if(m_Settings.noise_strength <= 0.0f)
+        {
+            m_NoiseField.release();
+            return;
+        }
+
+        cv::RNG rng(m_Settings.seed + 2);
+
+        cv::Mat noise_field(m_Settings.resolution + NOISE_FIELD_MARGIN, CV_16SC3);
+        rng.fill(noise_field, cv::RNG::NORMAL, cv::Scalar::all(0.0), cv::Scalar::all(m_Settings.noise_strength));
+        noise_field.copyTo(m_NoiseField);
+    }
+
+//---------------------------------------------------------------------------------------------------------------------
+
+    Homography SyntheticSource::camera_pose(const double time) const
+    {
+        // Sample the shake waves for the x, y and rotation components.
+        cv::Vec3d shake(0.0, 0.0, 0.0);
+        for(int r = 0; r < m_ShakeWaves.rows; r++)
+        {
+            for(int w = 0; w < SHAKE_WAVE_COUNT; w++)
+            {
+                const auto& wave = m_ShakeWaves.at<cv::Vec3d>(r, w);
+                shake[r] += wave[2] * std::sin(2.0 * CV_PI * wave[0] * time + wave[1]);
+            }
+        }
+
+        const cv::Point2d centre(m_Settings.resolution.width / 2.0, m_Settings.resolution.height / 2.0);
+
+        // The pose maps points in the scene to points in the frame.
+        cv::Mat pose = cv::getRotationMatrix2D(centre, shake[2] * m_Settings.shake_rotation, m_PoseZoom);
+        pose.at<double>(0, 2) += shake[0] * m_Settings.shake_translation * m_Settings.resolution.width;
+        pose.at<double>(1, 2) += shake[1] * m_Settings.shake_translation * m_Settings.resolution.height;
+
+        return Homography::FromAffineMatrix(pose);
+    }
+
+//---------------------------------------------------------------------------------------------------------------------
+
+    void SyntheticSource::local_motion(const double time, WarpMesh& offsets) const
+    {
+        const double phase_shift = 2.0 * CV_PI * 0.5 * m_Settings.shake_frequency * time;
+        const float amplitude = m_Settings.local_motion;
+
+        offsets.write([&](cv::Point2f& offset, const cv::Point& coord){
+            const auto& phase = m_LocalPhases.at<cv::Point2f>(coord);
+            offset.x = amplitude * static_cast<float>(std::sin(phase_shift + phase.x));
+            offset.y = amplitude * static_cast<float>(std::sin(phase_shift + phase.y));
+        }, false);
+    }
+
+//---------------------------------------------------------------------------------------------------------------------
+
+    void SyntheticSource::render_frame(VideoFrame& frame)
+    {
+        const double time = static_cast<double>(m_FrameIndex) / m_Settings.frame_rate;
+        const cv::Size2f frame_size(m_Settings.resolution);
+        const bool local = m_Settings.local_motion > 0.0f;
+
+        // Advance the camera, the first frame has no motion.
+        m_CameraPose = camera_pose(time);
+        if(m_FrameIndex == 0)
+            m_PrevCameraPose = m_CameraPose;
+
+        if(local)
+        {
+            std::swap(m_LocalOffsets, m_PrevLocalOffsets);
+            local_motion(time, m_LocalOffsets);
+            if(m_FrameIndex == 0)
+                m_PrevLocalOffsets = m_LocalOffsets;
+        }
+
+        // The ground truth motion uses the same convention as the FrameTracker.
+        m_Motion.set_to(m_CameraPose * m_PrevCameraPose.invert(), frame_size);
+        if(local)
+        {
+            m_Motion += m_LocalOffsets;
+            m_Motion -= m_PrevLocalOffsets;
+        }
+
+        // Build the warp which samples the scene through the camera pose.
+        const Homography inverse_pose = m_CameraPose.invert();
+        const auto coord_scaling = frame_size / cv::Size2f(m_MeshPose.size() - 1);
+        const auto norm_factor = 1.0f / frame_size;
+
+        m_MeshPose.write([&](cv::Point2f& offset, const cv::Point& coord){
+            const auto sample_point = cv::Point2f(coord) * coord_scaling;
+            offset = (inverse_pose * sample_point - sample_point) * norm_factor;
+        });
+        if(local) m_MeshPose += m_LocalOffsets;
+
+        // Render the frame, converting to the output format if necessary.
+        if(m_Settings.format == m_Scene.format)
+        {
+            m_MeshPose.apply(m_Scene, frame);
+            degrade_frame(frame);
+        }
+        else
+        {
+            m_MeshPose.apply(m_Scene, m_RenderFrame);
+            degrade_frame(m_RenderFrame);
+            m_RenderFrame.reformatTo(frame, m_Settings.format);
+        }
+
+        frame.timestamp = static_cast<uint64_t>(static_cast<double>(m_FrameIndex) * 1.0e9 / m_Settings.frame_rate);
+    }
+
+//---------------------------------------------------------------------------------------------------------------------
+
+    void SyntheticSource::degrade_frame(VideoFrame& frame)
+    {
+        // Sensor noise
+        if(!m_NoiseField.empty())
+        {
+            const cv::Rect noise_region(
+                m_NoiseRNG.uniform(0, NOISE_FIELD_MARGIN + 1),
+                m_NoiseRNG.uniform(0, NOISE_FIELD_MARGIN + 1),
+                frame.cols, frame.rows
+            );
+            cv::add(frame, m_NoiseField(noise_region), frame, cv::noArray(), CV_8U);
+        }
+
+        // Blocking artifacts, modelled in the same way as the DeblockingFilter's
+        // reference frame, by simplifying each macroblock towards its average.
+        if(m_Settings.blocking_strength > 0.0f)
+        {
+            const int block_size = static_cast<int>(m_Settings.block_size);
+            const cv::Size block_extent = frame.size() / block_size;
+            const cv::Rect block_region({0,0}, block_extent * block_size);
+
+            cv::UMat frame_region = frame(block_region);
+            cv::resize(frame_region, m_BlockGrid, block_extent, 0, 0, cv::INTER_AREA);
+            cv::resize(m_BlockGrid, m_BlockFrame, block_region.size(), 0, 0, cv::INTER_NEAREST);
+            cv::addWeighted(
+                frame_region, 1.0 - m_Settings.blocking_strength,
+                m_BlockFrame, m_Settings.blocking_strength,
+                0.0, frame_region
+            );
+        }
+    }
+
+//---------------------------------------------------------------------------------------------------------------------
+
+}
@@ -0,0 +1,100 @@
+//     *************************** LiveVisionKit ****************************
+//     Copyright (C) 2022  Sebastian Di Marco (crowsinc.dev@gmail.com)
+//
+//     This program is free software: you can redistribute it and/or modify
+//     it under the terms of the GNU General Public License as published by
+//     the Free Software Foundation, either version 3 of the License, or
+//     (at your option) any later version.
+//
+//     This program is distributed in the hope that it will be useful,
+//     but WITHOUT ANY WARRANTY; without even the implied warranty of
+//     MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//     GNU General Public License for more details.
+//
+//     You should have received a copy of the GNU General Public License
+//     along with this program.  If not, see <https://www.gnu.org/licenses/>.
+//     **********************************************************************
+
+#pragma once
+
+#include <opencv2/opencv.hpp>
+
+#include "FrameSource.hpp"
+#include "Math/WarpMesh.hpp"
+#include "Math/Homography.hpp"
+#include "Utility/Configurable.hpp"
+
+namespace lvk
+{
+
+    struct SyntheticSourceSettings
+    {
+        cv::Size resolution = {1920, 1080};
+        VideoFrame::Format format = VideoFrame::YUV;
+        float frame_rate = 60.0f;
+        size_t frame_count = 0; // Zero for an endless stream
+        uint64_t seed = 0;
+
+        // Camera Motion
+        cv::Size motion_resolution = {2, 2};
+        float shake_translation = 0.02f; // Fraction of the frame size
+        float shake_rotation = 0.5f; // Degrees
+        float shake_frequency = 2.0f; // Hz
+        float local_motion = 0.0f; // Fraction of the frame size
+
+        // Degradation
+        uint32_t block_size = 16; // Must be greater than 0
+        float blocking_strength = 0.0f;
+        float noise_strength = 0.0f; // Std. dev. in 8-bit levels
+    };
+
+    // NOTE: Generates a deterministic stream of textured frames with known camera
+    // motion, for benchmarking and validating the pipeline without any file I/O.
+    class SyntheticSource final : public FrameSource, public Configurable<SyntheticSourceSettings>
+    {
+    public:
+
+        explicit SyntheticSource(const SyntheticSourceSettings& settings = {});
+
+        void configure(const SyntheticSourceSettings& settings) override;
+
+        bool read(VideoFrame& frame) override;
+
+        void restart();
+
+        size_t frames_read() const;
+
+        // The ground truth motion from the previous frame to the last read frame.
+        const WarpMesh& motion() const;
+
+    private:
+
+        void generate_scene();
+
+        void generate_noise();
+
+        Homography camera_pose(const double time) const;
+
+        void local_motion(const double time, WarpMesh& offsets) const;
+
+        void render_frame(VideoFrame& frame);
+
+        void degrade_frame(VideoFrame& frame);
+
+    private:
+        size_t m_FrameIndex = 0;
+        cv::RNG m_NoiseRNG;
+        double m_PoseZoom = 1.0;
+        cv::Mat m_ShakeWaves, m_LocalPhases;
+
+        Homography m_CameraPose, m_PrevCameraPose;
+        WarpMesh m_LocalOffsets{WarpMesh::MinimumSize}, m_PrevLocalOffsets{WarpMesh::MinimumSize};
+        WarpMesh m_MeshPose{WarpMesh::MinimumSize}, m_Motion{WarpMesh::MinimumSize};
+
+        VideoFrame m_Scene, m_RenderFrame;
+        cv::UMat m_NoiseField{cv::UMatUsageFlags::USAGE_ALLOCATE_DEVICE_MEMORY};
+        cv::UMat m_BlockGrid{cv::UMatUsageFlags::USAGE_ALLOCATE_DEVICE_MEMORY};
+        cv::UMat m_BlockFrame{cv::UMatUsageFlags::USAGE_ALLOCATE_DEVICE_MEMORY};
+    };
+
+}
@@ -17,6 +17,7 @@
 
 #include "VideoFrame.hpp"
 
+#include "Functions/Conversion.hpp"
 #include "Directives.hpp"
 
 namespace lvk
@@ -40,7 +41,9 @@ namespace lvk
     VideoFrame::VideoFrame(const VideoFrame& frame)
         : cv::UMat(frame),
           timestamp(frame.timestamp),
-          format(frame.format)
+          format(frame.format),
+          chroma(frame.chroma),
+          renditions(frame.renditions)
     {}
 
 //---------------------------------------------------------------------------------------------------------------------
@@ -48,7 +51,9 @@ namespace lvk
     VideoFrame::VideoFrame(VideoFrame&& frame) noexcept
         : cv::UMat(std::move(frame)),
           timestamp(frame.timestamp),
-          format(frame.format)
+          format(frame.format),
+          chroma(std::move(frame.chroma)),
+          renditions(std::move(frame.renditions))
     {}
 
 //---------------------------------------------------------------------------------------------------------------------
@@ -73,6 +78,8 @@ namespace lvk
     {
         format = frame.format;
         timestamp = frame.timestamp;
+        chroma = std::move(frame.chroma);
+        renditions = std::move(frame.renditions);
         cv::UMat::operator=(std::move(frame));
 
         return *this;
@@ -84,6 +91,8 @@ namespace lvk
     {
         format = frame.format;
         timestamp = frame.timestamp;
+        chroma = frame.chroma;
+        renditions = frame.renditions;
         cv::UMat::operator=(frame);
 
         return *this;
@@ -93,11 +102,23 @@ namespace lvk
 
     VideoFrame VideoFrame::clone() const /* override */
     {
-        return VideoFrame(
+        VideoFrame frame(
             std::move(cv::UMat::clone()),
             timestamp,
             format
         );
+
+        if(is_planar())
+        {
+            frame.chroma[0] = chroma[0].clone();
+            frame.chroma[1] = chroma[1].clone();
+        }
+
+        frame.renditions.reserve(renditions.size());
+        for(const auto& rendition : renditions)
+            frame.renditions.push_back(rendition.clone());
+
+        return frame;
     }
 
 //---------------------------------------------------------------------------------------------------------------------
@@ -107,12 +128,24 @@ namespace lvk
         cv::UMat::copyTo(dst);
         dst.timestamp = timestamp;
         dst.format = format;
+
+        if(is_planar())
+        {
+            chroma[0].copyTo(dst.chroma[0]);
+            chroma[1].copyTo(dst.chroma[1]);
+        }
+
+        dst.renditions.resize(renditions.size());
+        for(size_t i = 0; i < renditions.size(); i++)
+            renditions[i].copyTo(dst.renditions[i]);
     }
 
 //---------------------------------------------------------------------------------------------------------------------
 
     void VideoFrame::copyTo(VideoFrame& dst, cv::InputArray mask) const /* override */
     {
+        LVK_ASSERT(!is_planar());
+
         cv::UMat::copyTo(dst, mask);
         dst.timestamp = timestamp;
         dst.format = format;
@@ -136,11 +169,28 @@ namespace lvk
 
     VideoFrame VideoFrame::operator()(const cv::Rect& roi) const /* override */
     {
-        return VideoFrame(
+        VideoFrame view(
             std::move(cv::UMat::operator()(roi)),
             timestamp,
             format
         );
+
+        if(is_planar())
+        {
+            // NOTE: Odd ROI coordinates are rounded to the closest chroma samples.
+            const cv::Rect chroma_roi = cv::Rect(
+                roi.x / 2,
+                roi.y / 2,
+                (roi.width + 1) / 2,
+                (roi.height + 1) / 2
+            ) & cv::Rect({0,0}, chroma[0].size());
+
+            view.chroma[0] = chroma[0](chroma_roi);
+            if(format == YUV420P)
+                view.chroma[1] = chroma[1](chroma_roi);
+        }
+
+        return view;
     }
 
 //---------------------------------------------------------------------------------------------------------------------
@@ -150,6 +200,34 @@ namespace lvk
         return format != UNKNOWN;
     }
 
+//---------------------------------------------------------------------------------------------------------------------
+
+    bool VideoFrame::is_planar() const
+    {
+        return is_planar_format(format);
+    }
+
+//---------------------------------------------------------------------------------------------------------------------
+
+    int VideoFrame::planes() const
+    {
+        switch(format)
+        {
+            case YUV420P: return 3;
+            case NV12: return 2;
+            default: return 1;
+        }
+    }
+
+//---------------------------------------------------------------------------------------------------------------------
+
+    cv::UMat VideoFrame::plane(const int index) const
+    {
+        LVK_ASSERT_RANGE(index, 0, planes() - 1);
+
+        return index == 0 ? static_cast<const cv::UMat&>(*this) : chroma[index - 1];
+    }
+
 //---------------------------------------------------------------------------------------------------------------------
 
     void VideoFrame::reformat(const VideoFrame::Format new_format)
@@ -180,125 +258,8 @@ namespace lvk
             return;
         }
 
-        // Helper Buffers.
-        thread_local cv::UMat step_buffer(cv::UMatUsageFlags::USAGE_ALLOCATE_DEVICE_MEMORY);
-
         // Convert the old format into the new format.
-        switch(format)
-        {
-            case Format::BGR:
-            {
-                // BGR to ...
-                switch(new_format)
-                {
-                    case Format::GRAY: cv::cvtColor(*this, dst, cv::COLOR_BGR2GRAY); break;
-                    case Format::RGB: cv::cvtColor(*this, dst, cv::COLOR_BGR2RGB); break;
-                    case Format::YUV: cv::cvtColor(*this, dst, cv::COLOR_BGR2YUV); break;
-                    case Format::RGBA: cv::cvtColor(*this, dst, cv::COLOR_BGR2RGBA); break;
-                    case Format::BGRA: cv::cvtColor(*this, dst, cv::COLOR_BGR2BGRA); break;
-                    default: LVK_ASSERT("Unsupported BGR conversion" && false);
-                }
-                break;
-            }
-            case Format::BGRA:
-            {
-                // BGRA to ...
-                switch(new_format)
-                {
-                    case Format::GRAY: cv::cvtColor(*this, dst, cv::COLOR_BGRA2GRAY); break;
-                    case Format::RGB: cv::cvtColor(*this, dst, cv::COLOR_BGRA2RGB); break;
-                    case Format::BGR: cv::cvtColor(*this, dst, cv::COLOR_BGRA2BGR); break;
-                    case Format::RGBA: cv::cvtColor(*this, dst, cv::COLOR_BGRA2RGBA); break;
-                    case Format::YUV:
-                    {
-                        cv::cvtColor(*this, step_buffer, cv::COLOR_BGRA2BGR);
-                        cv::cvtColor(step_buffer, dst, cv::COLOR_BGR2YUV);
-                        break;
-                    }
-                    default: LVK_ASSERT("Unsupported BGRA conversion" && false);
-                }
-                break;
-            }
-            case Format::RGB:
-            {
-                // RGB to ...
-                switch(new_format)
-                {
-                    case Format::GRAY: cv::cvtColor(*this, dst, cv::COLOR_RGB2GRAY); break;
-                    case Format::BGR: cv::cvtColor(*this, dst, cv::COLOR_RGB2BGR); break;
-                    case Format::YUV: cv::cvtColor(*this, dst, cv::COLOR_RGB2YUV); break;
-                    case Format::RGBA: cv::cvtColor(*this, dst, cv::COLOR_RGB2RGBA); break;
-                    case Format::BGRA: cv::cvtColor(*this, dst, cv::COLOR_RGB2BGRA); break;
-                    default: LVK_ASSERT("Unsupported RGB conversion" && false);
-                }
-                break;
-            }
-            case Format::RGBA:
-            {
-                // RGBA to ...
-                switch(new_format)
-                {
-                    case Format::GRAY: cv::cvtColor(*this, dst, cv::COLOR_RGBA2GRAY); break;
-                    case Format::BGR: cv::cvtColor(*this, dst, cv::COLOR_RGBA2BGR); break;
-                    case Format::RGB: cv::cvtColor(*this, dst, cv::COLOR_RGBA2RGB); break;
-                    case Format::BGRA: cv::cvtColor(*this, dst, cv::COLOR_RGBA2BGRA); break;
-                    case Format::YUV:
-                    {
-                        cv::cvtColor(*this, step_buffer, cv::COLOR_RGBA2RGB);
-                        cv::cvtColor(step_buffer, dst, cv::COLOR_RGB2YUV);
-                        break;
-                    }
-                    default: LVK_ASSERT("Unsupported RGBA conversion" && false);
-                }
-                break;
-            }
-            case Format::YUV:
-            {
-                // YUV to ...
-                switch(new_format)
-                {
-                    case Format::GRAY: cv::extractChannel(*this, dst, 0); break;
-                    case Format::BGR: cv::cvtColor(*this, dst, cv::COLOR_YUV2BGR); break;
-                    case Format::BGRA: cv::cvtColor(*this, step_buffer, cv::COLOR_YUV2BGR, 4); break;
-                    case Format::RGB: cv::cvtColor(*this, dst, cv::COLOR_YUV2RGB); break;
-                    case Format::RGBA: cv::cvtColor(*this, step_buffer, cv::COLOR_YUV2RGB, 4); break;
-                    default: LVK_ASSERT("Unsupported YUV conversion" && false);
-                }
-                break;
-            }
-            case Format::GRAY:
-            {
-                // Gray to ...
-                switch(new_format)
-                {
-                    case Format::RGB: cv::cvtColor(*this, dst, cv::COLOR_GRAY2RGB); break;
-                    case Format::BGR: cv::cvtColor(*this, dst, cv::COLOR_GRAY2BGR); break;
-                    case Format::RGBA: cv::cvtColor(*this, dst, cv::COLOR_GRAY2RGBA); break;
-                    case Format::BGRA: cv::cvtColor(*this, dst, cv::COLOR_GRAY2BGRA); break;
-                    case Format::YUV:
-                    {
-                        // Y = gray plane, U = 128 plane, V = 128 plane
-                        thread_local cv::UMat const_plane;
-                        if(const_plane.cols < cols || const_plane.rows < rows || const_plane.empty())
-                        {
-                            // TODO: replace with a sized cache buffer construct
-                            // Cache the const buffer in case the operation happens a lot.
-                            const_plane = zeros(
-                                std::max(rows, const_plane.rows),
-                                std::max(cols, const_plane.cols),
-                                type(), cv::UMatUsageFlags::USAGE_ALLOCATE_DEVICE_MEMORY
-                            );
-                            const_plane.setTo(cv::Scalar::all(128));
-                        }
-                        cv::merge(std::vector<cv::UMat>{*this, const_plane, const_plane}, dst);
-                        break;
-                    }
-                    default: LVK_ASSERT("Unsupported GRAY conversion" && false);
-                }
-                break;
-            }
-            default: LVK_ASSERT("Unsupported conversion" && false);
-        }
+        convert(*this, dst, new_format);
 
         // Update metadata.
         dst.timestamp = timestamp;
@@ -309,11 +270,16 @@ namespace lvk
 
     void VideoFrame::viewAsFormat(VideoFrame& view, const Format new_format) const
     {
-        if(new_format != format)
+        if(new_format == format)
+        {
+            view = *this;
+        }
+        else if(is_planar() && new_format == GRAY)
         {
-            reformatTo(view, new_format);
+            // The luma plane of planar formats can be viewed directly.
+            view = VideoFrame(static_cast<const cv::UMat&>(*this), timestamp, GRAY);
         }
-        else view = *this;
+        else reformatTo(view, new_format);
     }
 
 //---------------------------------------------------------------------------------------------------------------------
@@ -17,6 +17,8 @@
 
 #pragma once
 
+#include <array>
+#include <vector>
 #include <opencv2/opencv.hpp>
 
 namespace lvk
@@ -24,12 +26,25 @@ namespace lvk
     // NOTE: use camelCase to match the cv::UMat API.
     struct VideoFrame : public cv::UMat
     {
-        enum Format {BGR, BGRA, RGB, RGBA, YUV, GRAY, UNKNOWN};
+        enum Format {BGR, BGRA, RGB, RGBA, YUV, GRAY, YUV420P, NV12, UNKNOWN};
 
         uint64_t timestamp = 0;
         Format format = UNKNOWN;
         int& width = cols; int& height = rows;
 
+        // NOTE: Planar formats store their luma plane as the frame itself, so that
+        // luma-only operations need no conversion. The sub-sampled chroma is held
+        // separately as one interleaved UV plane (NV12) or as U and V planes (YUV420P).
+        std::array<cv::UMat, 2> chroma = {
+            cv::UMat(cv::UMatUsageFlags::USAGE_ALLOCATE_DEVICE_MEMORY),
+            cv::UMat(cv::UMatUsageFlags::USAGE_ALLOCATE_DEVICE_MEMORY)
+        };
+
+        // NOTE: Other renditions of the frame which were produced alongside it, such as
+        // the rungs of a scaling ladder. These travel with the frame, so a stream callback
+        // receives the renditions of the same frame, rather than those of a later one.
+        std::vector<VideoFrame> renditions;
+
     public:
 
         VideoFrame();
@@ -69,6 +84,13 @@ namespace lvk
 
         bool has_known_format() const;
 
+        bool is_planar() const;
+
+        int planes() const;
+
+        // NOTE: Returns a view of the plane with its own stride.
+        cv::UMat plane(const int index) const;
+
         void reformat(const Format new_format);
 
         void reformatTo(VideoFrame& dst, const Format new_format) const;
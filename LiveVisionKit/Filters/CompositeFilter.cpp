@@ -17,6 +17,8 @@
 
 #include "CompositeFilter.hpp"
 
+#include <algorithm>
+
 namespace lvk
 {
 
@@ -36,7 +38,9 @@ namespace lvk
     )
         : CompositeFilter({
                 .filter_chain = filter_chain,
-                .save_outputs = settings.save_outputs
+                .save_outputs = settings.save_outputs,
+                .optimize_chain = settings.optimize_chain,
+                .frame_analysis = settings.frame_analysis
           })
     {}
 
@@ -44,6 +48,10 @@ namespace lvk
 
     void CompositeFilter::configure(const CompositeFilterSettings& settings)
     {
+        // Undo any fusions of the old chain, as its filters may be used elsewhere.
+        for(auto& filter : m_Settings.filter_chain)
+            filter->fuse_scaling({});
+
         m_Settings = settings;
 
         m_FilterOutputs.resize(settings.filter_chain.size());
@@ -59,6 +67,19 @@ namespace lvk
     {
         LVK_ASSERT(!input.empty());
 
+        if(m_Settings.frame_analysis != nullptr && !m_AnalysisStage.has_value())
+            m_Settings.frame_analysis->advance(input);
+
+        // Re-plan the chain if a fused scaling stage has since been configured directly.
+        for(size_t i = 0; i < m_FusedSizes.size(); i++)
+        {
+            if(m_FusedSizes[i].has_value() && m_Settings.filter_chain[i]->scaling_size() != m_FusedSizes[i])
+            {
+                plan_chain();
+                break;
+            }
+        }
+
         VideoFrame& prev_filter_output = input;
         for(size_t i = 0; i < m_Settings.filter_chain.size(); i++)
         {
@@ -71,8 +92,19 @@ namespace lvk
                 if(filter_input.empty())
                     break;
 
+                // Convert the input only if the filter cannot process its format.
+                const auto& formats = m_FilterFormats[i];
+                if(!formats.empty() && filter_input.has_known_format()
+                   && std::find(formats.begin(), formats.end(), filter_input.format) == formats.end())
+                {
+                    filter_input.reformat(formats.front());
+                }
+
+                if(m_AnalysisStage == i)
+                    m_Settings.frame_analysis->advance(filter_input);
+
                 m_Settings.filter_chain[i]->apply(
-                    std::move(filter_input), filter_output
+                    std::move(filter_input), filter_output, is_profiling()
                 );
 
                 // If we are saving all outputs, then we cannot move the output
@@ -87,6 +119,73 @@ namespace lvk
         output = std::move(prev_filter_output);
     }
 
+//---------------------------------------------------------------------------------------------------------------------
+
+    void CompositeFilter::plan_chain()
+    {
+        const auto& filter_chain = m_Settings.filter_chain;
+
+        m_FilterFormats.resize(filter_chain.size());
+        m_FusedSizes.assign(filter_chain.size(), std::nullopt);
+        for(size_t i = 0; i < filter_chain.size(); i++)
+        {
+            if(m_Settings.optimize_chain)
+                m_FilterFormats[i] = filter_chain[i]->supported_formats();
+            else
+                m_FilterFormats[i].clear();
+
+            filter_chain[i]->fuse_scaling({});
+        }
+
+        // Analyse the frames given to the readers of the shared analysis, which may follow
+        // filters that change the geometry. As all readers share the same analysis, none
+        // may follow a filter which changes the geometry of the first reader's frames.
+        m_AnalysisStage.reset();
+        if(m_Settings.frame_analysis != nullptr)
+        {
+            bool geometry_changed = false;
+            for(size_t i = 0; i < filter_chain.size(); i++)
+            {
+                if(!is_filter_enabled(i))
+                    continue;
+
+                if(filter_chain[i]->shared_analysis() == m_Settings.frame_analysis.get())
+                {
+                    LVK_ASSERT(!geometry_changed && "Shared analysis readers are separated by a geometry change");
+
+                    if(!m_AnalysisStage.has_value())
+                        m_AnalysisStage = i;
+                }
+
+                if(m_AnalysisStage.has_value() && filter_chain[i]->changes_geometry())
+                    geometry_changed = true;
+            }
+        }
+
+        // Fuse each warp with the scaling stage that follows it, so that the frame
+        // is only resampled once and the scaling stage is left to sharpen it. Saved
+        // outputs must hold the result of each filter, so they are never fused. The
+        // fused filter still falls back to its input size if the frame cannot be
+        // rendered at the fused size, so the scaling stage then scales it itself.
+        if(!m_Settings.optimize_chain || m_Settings.save_outputs)
+            return;
+
+        std::shared_ptr<VideoFilter> prev_filter = nullptr;
+        for(size_t i = 0; i < filter_chain.size(); i++)
+        {
+            if(!is_filter_enabled(i))
+                continue;
+
+            if(const auto scaling_size = filter_chain[i]->scaling_size(); prev_filter != nullptr && scaling_size)
+            {
+                if(prev_filter->fuse_scaling(*scaling_size))
+                    m_FusedSizes[i] = scaling_size;
+            }
+
+            prev_filter = filter_chain[i];
+        }
+    }
+
 //---------------------------------------------------------------------------------------------------------------------
 
     const std::vector<std::shared_ptr<lvk::VideoFilter>>& CompositeFilter::filters() const
@@ -135,6 +234,7 @@ namespace lvk
         LVK_ASSERT(index < m_FilterRunState.size());
 
         m_FilterRunState[index] = false;
+        plan_chain();
     }
 
 //---------------------------------------------------------------------------------------------------------------------
@@ -144,6 +244,7 @@ namespace lvk
         LVK_ASSERT(index < m_FilterRunState.size());
 
         m_FilterRunState[index] = true;
+        plan_chain();
     }
 
 //---------------------------------------------------------------------------------------------------------------------
@@ -152,6 +253,8 @@ namespace lvk
     {
         for(auto&& run_state : m_FilterRunState)
             run_state = true;
+
+        plan_chain();
     }
 
 //---------------------------------------------------------------------------------------------------------------------
@@ -161,6 +264,17 @@ namespace lvk
         return m_Settings.filter_chain.size();
     }
 
+//---------------------------------------------------------------------------------------------------------------------
+
+    bool CompositeFilter::changes_geometry() const
+    {
+        for(size_t i = 0; i < m_Settings.filter_chain.size(); i++)
+            if(m_FilterRunState[i] && m_Settings.filter_chain[i]->changes_geometry())
+                return true;
+
+        return false;
+    }
+
 //---------------------------------------------------------------------------------------------------------------------
 
 }
\ No newline at end of file
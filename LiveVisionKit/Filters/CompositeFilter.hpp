@@ -20,6 +20,7 @@
 #include <memory>
 
 #include "VideoFilter.hpp"
+#include "Vision/FrameAnalysis.hpp"
 #include "Utility/Configurable.hpp"
 
 namespace lvk
@@ -30,6 +31,18 @@ namespace lvk
         std::vector<std::shared_ptr<lvk::VideoFilter>> filter_chain;
         bool save_outputs = false;
 
+        // NOTE: plans the chain from the formats each filter supports, so that frames
+        // are only converted when their format changes, and fuses warps with a
+        // following scaling stage. The plan is redone when the composite is configured
+        // or its filters are toggled, and when a fused scaling stage changes its size.
+        bool optimize_chain = true;
+
+        // NOTE: if given, each input frame is analysed once for all the filters of the
+        // chain that are configured to share the analysis. The analysis is advanced on
+        // the input of the first filter which reads it, or on the chain input if none
+        // do. Filters which change the geometry may not sit between its readers.
+        std::shared_ptr<FrameAnalysis> frame_analysis = nullptr;
+
         // TODO: add pipelineing option
     };
 
@@ -64,12 +77,19 @@ namespace lvk
 
         size_t filter_count() const;
 
+        bool changes_geometry() const override;
+
     private:
 
         void filter(VideoFrame&& input, VideoFrame& output) override;
 
+        void plan_chain();
+
         std::vector<bool> m_FilterRunState;
         std::vector<Frame> m_FilterOutputs;
+        std::vector<std::vector<VideoFrame::Format>> m_FilterFormats;
+        std::vector<std::optional<cv::Size>> m_FusedSizes;
+        std::optional<size_t> m_AnalysisStage;
     };
 
 }
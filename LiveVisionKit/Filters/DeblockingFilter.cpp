@@ -41,6 +41,20 @@ namespace lvk
         LVK_ASSERT(settings.filter_scaling > 1.0f);
 
         m_Settings = settings;
+
+        // The tile halo must cover the footprint of the smoothing filter, plus
+        // one macroblock for the interpolation of the blend maps. Tiles are
+        // aligned to the macroblocks so that each tile sees the same block grid.
+        const int block_size = static_cast<int>(settings.block_size);
+        const auto smoothing_radius = static_cast<int>(
+            std::ceil(static_cast<float>(settings.filter_size / 2 + 1) * settings.filter_scaling)
+        );
+
+        m_TileProcessor.configure({
+            settings.tile_size,
+            smoothing_radius + block_size,
+            block_size
+        });
     }
 
 //---------------------------------------------------------------------------------------------------------------------
@@ -59,12 +73,19 @@ namespace lvk
 		// is preferred for performance. Blocks are assumed to be safe to smooth if
 		// they are similar, by threshold,to the reference blocks. To make the choice
 		// of threshold less strict for the user; multiple thresholds are used, each
-		// with their own weighting that increases as details become stronger.
+		// with their own weighting that increases as details become stronger. Planar
+		// formats are only deblocked on their luma plane, leaving the chroma untouched.
 
 		const int macroblock_size = static_cast<int>(m_Settings.block_size);
 		const cv::Size macroblock_extent = input.size() / macroblock_size;
         m_FilterRegion = cv::Rect({0,0}, macroblock_extent * macroblock_size);
 
+		if(m_Settings.tiled_processing)
+		{
+			filter_tiles(input, output);
+			return;
+		}
+
 		// Resolutions such as 1920x1080 may not be evenly divisible by macroblocks.
 		// We ignore areas containing partial blocks by applying the filter on only
 		// the region of the frame which consists of only full macroblocks.
@@ -77,11 +98,12 @@ namespace lvk
 		cv::resize(m_DeblockBuffer, m_SmoothFrame, m_FilterRegion.size(), 0, 0, cv::INTER_LINEAR);
 
 		// Generate reference frame
-        filter_input.reformatTo(m_DetectionFrame, VideoFrame::GRAY);
+        // NOTE: the detection frame may be a view of the input's luma plane.
+        filter_input.viewAsFormat(m_DetectionFrame, VideoFrame::GRAY);
 		cv::resize(m_DetectionFrame, m_BlockGrid, macroblock_extent, 0, 0, cv::INTER_AREA);
 		cv::resize(m_BlockGrid, m_ReferenceFrame, m_DetectionFrame.size(), 0, 0, cv::INTER_NEAREST);
-		cv::absdiff(m_DetectionFrame, m_ReferenceFrame, m_DetectionFrame);
-		cv::resize(m_DetectionFrame, m_BlockGrid, macroblock_extent, 0, 0, cv::INTER_AREA);
+		cv::absdiff(m_DetectionFrame, m_ReferenceFrame, m_ReferenceFrame);
+		cv::resize(m_ReferenceFrame, m_BlockGrid, macroblock_extent, 0, 0, cv::INTER_AREA);
 
 		// Produce blend maps
 		m_FloatBuffer.create(macroblock_extent, CV_32FC1);
@@ -109,15 +131,96 @@ namespace lvk
         output = std::move(input);
 	}
 
+//---------------------------------------------------------------------------------------------------------------------
+
+    void DeblockingFilter::filter_tiles(const VideoFrame& input, VideoFrame& output)
+    {
+        // NOTE: This runs the same pass chain as the regular filter, but on each tile
+        // separately so that all the intermediate buffers stay resident in the cache.
+        // Tiles read from the input and write to a separate output, so that the halo
+        // of a tile is never modified by the filtering of its neighbours.
+
+        const int macroblock_size = static_cast<int>(m_Settings.block_size);
+        const cv::Size macroblock_extent = m_FilterRegion.size() / macroblock_size;
+        const float area_scaling = 1.0f / m_Settings.filter_scaling;
+        const double level_step = 1.0 / m_Settings.detection_levels;
+
+        input.copyTo(m_TileOutput);
+        input.viewAsFormat(m_DetectionFrame, VideoFrame::GRAY);
+        m_FloatBuffer.create(macroblock_extent, CV_32FC1);
+        {
+            const cv::Mat src = input.getMat(cv::ACCESS_READ);
+            const cv::Mat detection = m_DetectionFrame.getMat(cv::ACCESS_READ);
+            cv::Mat dst = m_TileOutput.getMat(cv::ACCESS_WRITE);
+            cv::Mat keep_blocks = m_FloatBuffer.getMat(cv::ACCESS_WRITE);
+
+            m_TileProcessor.process(m_FilterRegion.size(), [&](const Tile& tile){
+                thread_local cv::Mat deblock_buffer, smooth_tile, reference_tile, block_grid, block_mask;
+                thread_local cv::Mat float_blocks, keep_blend_map, deblock_blend_map;
+
+                const cv::Mat tile_input = src(tile.padded_region);
+                const cv::Mat tile_detection = detection(tile.padded_region);
+                const cv::Size tile_blocks = tile.padded_region.size() / macroblock_size;
+
+                // Generate smooth tile
+                cv::resize(tile_input, deblock_buffer, cv::Size(), area_scaling, area_scaling, cv::INTER_AREA);
+                cv::medianBlur(deblock_buffer, deblock_buffer, static_cast<int>(m_Settings.filter_size));
+                cv::resize(deblock_buffer, smooth_tile, tile_input.size(), 0, 0, cv::INTER_LINEAR);
+
+                // Generate reference tile
+                cv::resize(tile_detection, block_grid, tile_blocks, 0, 0, cv::INTER_AREA);
+                cv::resize(block_grid, reference_tile, tile_detection.size(), 0, 0, cv::INTER_NEAREST);
+                cv::absdiff(tile_detection, reference_tile, reference_tile);
+                cv::resize(reference_tile, block_grid, tile_blocks, 0, 0, cv::INTER_AREA);
+
+                // Produce blend maps
+                float_blocks.create(tile_blocks, CV_32FC1);
+                float_blocks.setTo(cv::Scalar(0.0));
+
+                for(int l = 0; l < m_Settings.detection_levels; l++)
+                {
+                    cv::threshold(block_grid, block_mask, l, 255, cv::THRESH_BINARY);
+                    float_blocks.setTo(cv::Scalar((l + 1.0) * level_step), block_mask);
+                }
+
+                // Keep the owned blocks so that the filter influence can be drawn.
+                float_blocks(cv::Rect(tile.inner_region.tl() / macroblock_size, tile.region.size() / macroblock_size))
+                    .copyTo(keep_blocks(cv::Rect(tile.region.tl() / macroblock_size, tile.region.size() / macroblock_size)));
+
+                cv::resize(float_blocks, keep_blend_map, tile_input.size(), 0, 0, cv::INTER_LINEAR);
+                cv::absdiff(keep_blend_map, cv::Scalar(1.0), deblock_blend_map);
+
+                // Adaptively blend the owned regions of the original and smooth tiles
+                cv::Mat tile_output = dst(tile.region);
+                cv::blendLinear(
+                    tile_input(tile.inner_region),
+                    smooth_tile(tile.inner_region),
+                    keep_blend_map(tile.inner_region),
+                    deblock_blend_map(tile.inner_region),
+                    tile_output
+                );
+            });
+        }
+
+        std::swap(output, m_TileOutput);
+    }
+
 //---------------------------------------------------------------------------------------------------------------------
 
     void DeblockingFilter::draw_influence(VideoFrame& frame) const
     {
+        // Tiled processing only keeps the block level blend map, so it must be expanded.
+        if(m_Settings.tiled_processing)
+        {
+            cv::resize(m_FloatBuffer, m_KeepBlendMap, m_FilterRegion.size(), 0, 0, cv::INTER_LINEAR);
+            cv::absdiff(m_KeepBlendMap, cv::Scalar(1.0), m_DeblockBlendMap);
+        }
+
         LVK_ASSERT(!m_KeepBlendMap.empty() && !m_DeblockBlendMap.empty());
         LVK_ASSERT(m_FilterRegion.br().x <= frame.cols);
         LVK_ASSERT(m_FilterRegion.br().y <= frame.rows);
 
-        m_InfluenceBuffer.create(m_FilterRegion.size(), CV_8UC3);
+        m_InfluenceBuffer.create(m_FilterRegion.size(), frame.type());
         m_InfluenceBuffer.setTo(col::MAGENTA[frame.format]);
 
         // Re-use the blend maps to blend the influence buffer.
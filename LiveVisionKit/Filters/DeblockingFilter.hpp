@@ -18,6 +18,7 @@
 #pragma once
 
 #include "VideoFilter.hpp"
+#include "TileProcessor.hpp"
 #include "Utility/Configurable.hpp"
 
 namespace lvk
@@ -29,6 +30,10 @@ namespace lvk
 		uint32_t block_size = 16; // Must be greater than 0
 		uint32_t filter_size = 5; // Must be odd
 		float filter_scaling = 4; // Smaller is stronger (1/x)
+
+		// Cache-blocked processing mode for CPU-only systems.
+		bool tiled_processing = false;
+		cv::Size tile_size = {256, 256};
 	};
 
 	class DeblockingFilter final : public VideoFilter, public Configurable<DeblockingFilterSettings>
@@ -47,11 +52,16 @@ namespace lvk
 
         void filter(VideoFrame&& input, VideoFrame& output) override;
 
+        void filter_tiles(const VideoFrame& input, VideoFrame& output);
+
+        TileProcessor m_TileProcessor;
+        VideoFrame m_TileOutput;
+
         cv::Rect m_FilterRegion{0,0,0,0};
 		VideoFrame m_SmoothFrame, m_DetectionFrame, m_ReferenceFrame;
 		cv::UMat m_BlockMask{cv::UMatUsageFlags::USAGE_ALLOCATE_DEVICE_MEMORY};
-		cv::UMat m_KeepBlendMap{cv::UMatUsageFlags::USAGE_ALLOCATE_DEVICE_MEMORY};
-		cv::UMat m_DeblockBlendMap{cv::UMatUsageFlags::USAGE_ALLOCATE_DEVICE_MEMORY};
+		mutable cv::UMat m_KeepBlendMap{cv::UMatUsageFlags::USAGE_ALLOCATE_DEVICE_MEMORY};
+		mutable cv::UMat m_DeblockBlendMap{cv::UMatUsageFlags::USAGE_ALLOCATE_DEVICE_MEMORY};
 		cv::UMat m_BlockGrid{cv::UMatUsageFlags::USAGE_ALLOCATE_DEVICE_MEMORY};
 		cv::UMat m_DeblockBuffer{cv::UMatUsageFlags::USAGE_ALLOCATE_DEVICE_MEMORY};
         cv::UMat m_FloatBuffer{cv::UMatUsageFlags::USAGE_ALLOCATE_DEVICE_MEMORY};
@@ -47,15 +47,46 @@ namespace lvk
         m_Settings = settings;
     }
 
+//---------------------------------------------------------------------------------------------------------------------
+
+    std::vector<VideoFrame::Format> ScalingFilter::supported_formats() const
+    {
+        if(m_Settings.yuv_input)
+            return {VideoFrame::YUV, VideoFrame::BGR, VideoFrame::RGB};
+        else
+            return {VideoFrame::BGR, VideoFrame::RGB, VideoFrame::YUV};
+    }
+
+//---------------------------------------------------------------------------------------------------------------------
+
+    std::optional<cv::Size> ScalingFilter::scaling_size() const
+    {
+        return m_Settings.output_size;
+    }
+
 //---------------------------------------------------------------------------------------------------------------------
 
     void ScalingFilter::filter(VideoFrame&& input, VideoFrame& output)
     {
         LVK_ASSERT(!input.empty());
 
-        lvk::upscale(input, output, m_Settings.output_size, m_Settings.yuv_input);
-        lvk::sharpen(output, output, m_Settings.sharpness);
+        // NOTE: the frame is upscaled and sharpened in one pass. A fused warp may have
+        // already scaled the frame, in which case only the sharpening is performed.
+        // Without OpenCL, the pass runs in cache-sized tiles on the CPU.
+        if(cv::ocl::useOpenCL())
+        {
+            lvk::upscale_sharpen(
+                input, output, m_Settings.output_size, m_Settings.sharpness, m_Settings.yuv_input
+            );
+        }
+        else
+        {
+            lvk::upscale_sharpen(
+                input, output, m_Settings.output_size, m_Settings.sharpness, m_Settings.yuv_input, m_TileProcessor
+            );
+        }
         output.timestamp = input.timestamp;
+        output.format = input.format;
     }
 
 //---------------------------------------------------------------------------------------------------------------------
@@ -18,6 +18,7 @@
 #pragma once
 
 #include "VideoFilter.hpp"
+#include "TileProcessor.hpp"
 #include "Utility/Configurable.hpp"
 
 namespace lvk
@@ -40,10 +41,16 @@ namespace lvk
 
         void configure(const ScalingFilterSettings& settings) override;
 
+        std::vector<VideoFrame::Format> supported_formats() const override;
+
+        std::optional<cv::Size> scaling_size() const override;
+
     private:
 
         void filter(VideoFrame&& input, VideoFrame& output) override;
 
+    private:
+        TileProcessor m_TileProcessor;
     };
 
 }
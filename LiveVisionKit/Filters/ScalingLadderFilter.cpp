@@ -0,0 +1,175 @@
+//     *************************** LiveVisionKit ****************************
+//     Copyright (C) 2022  Sebastian Di Marco (crowsinc.dev@gmail.com)
+//
+//     This program is free software: you can redistribute it and/or modify
+//     it under the terms of the GNU General Public License as published by
+//     the Free Software Foundation, either version 3 of the License, or
+//     (at your option) any later version.
+//
+//     This program is distributed in the hope that it will be useful,
+//     but WITHOUT ANY WARRANTY; without even the implied warranty of
+//     MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//     GNU General Public License for more details.
+//
+//     You should have received a copy of the GNU General Public License
+//     along with this program.  If not, see <https://www.gnu.org/licenses/>.
+//     **********************************************************************
+
+#include "ScalingLadderFilter.hpp"
+
+#include <numeric>
+#include <algorithm>
+
+#include "Functions/Image.hpp"
+
+namespace lvk
+{
+
+//---------------------------------------------------------------------------------------------------------------------
+
+    ScalingLadderFilter::ScalingLadderFilter(const ScalingLadderFilterSettings& settings)
+        : VideoFilter("Scaling Ladder Filter")
+    {
+        configure(settings);
+    }
+
+//---------------------------------------------------------------------------------------------------------------------
+
+    void ScalingLadderFilter::configure(const ScalingLadderFilterSettings& settings)
+    {
+        LVK_ASSERT_01(settings.sharpness);
+        LVK_ASSERT(!settings.rungs.empty());
+        for(size_t i = 0; i < settings.rungs.size(); i++)
+        {
+            const cv::Size& rung = settings.rungs[i];
+            LVK_ASSERT(rung.width > 0 && rung.height > 0);
+
+            // NOTE: each rung is identified by its size, e.g. in the output file names.
+            LVK_ASSERT(
+                std::find(settings.rungs.begin(), settings.rungs.begin() + i, rung) == settings.rungs.begin() + i
+                && "Scaling ladder rungs must have unique sizes"
+            );
+        }
+
+        m_Settings = settings;
+
+        // Force the rungs to be re-planned for the next frame.
+        m_PlannedSize = {0,0};
+    }
+
+//---------------------------------------------------------------------------------------------------------------------
+
+    std::vector<VideoFrame::Format> ScalingLadderFilter::supported_formats() const
+    {
+        if(m_Settings.yuv_input)
+            return {VideoFrame::YUV, VideoFrame::BGR, VideoFrame::RGB};
+        else
+            return {VideoFrame::BGR, VideoFrame::RGB, VideoFrame::YUV};
+    }
+
+//---------------------------------------------------------------------------------------------------------------------
+
+    bool ScalingLadderFilter::changes_geometry() const
+    {
+        return true;
+    }
+
+//---------------------------------------------------------------------------------------------------------------------
+
+    void ScalingLadderFilter::plan_rungs(const cv::Size& input_size)
+    {
+        const auto& rungs = m_Settings.rungs;
+
+        // Plan the rungs from largest to smallest, so that each downscale
+        // can be sourced from the smallest larger rung instead of the input.
+        std::vector<size_t> rung_order(rungs.size());
+        std::iota(rung_order.begin(), rung_order.end(), 0);
+        std::stable_sort(rung_order.begin(), rung_order.end(), [&](const size_t a, const size_t b){
+            return rungs[a].area() > rungs[b].area();
+        });
+
+        m_Stages.clear();
+        for(const size_t rung : rung_order)
+        {
+            const cv::Size& size = rungs[rung];
+            if(size.width >= input_size.width && size.height >= input_size.height)
+            {
+                m_Stages.push_back({rung, std::nullopt, true});
+                continue;
+            }
+
+            // NOTE: upscaled rungs are sharpened, so only downscaled rungs are reused.
+            RungStage stage{rung, std::nullopt, false};
+            for(const auto& prev_stage : m_Stages)
+            {
+                const cv::Size& prev_size = rungs[prev_stage.rung];
+                if(!prev_stage.upscale && prev_size.width >= size.width && prev_size.height >= size.height)
+                    stage.source = prev_stage.rung;
+            }
+            m_Stages.push_back(stage);
+        }
+
+        m_PlannedSize = input_size;
+    }
+
+//---------------------------------------------------------------------------------------------------------------------
+
+    VideoFrame& ScalingLadderFilter::rung_frame(const size_t index, VideoFrame& output)
+    {
+        return index == 0 ? output : output.renditions[index - 1];
+    }
+
+//---------------------------------------------------------------------------------------------------------------------
+
+    void ScalingLadderFilter::filter(VideoFrame&& input, VideoFrame& output)
+    {
+        LVK_ASSERT(!input.empty());
+
+        // Scaling requires packed frames, so planar formats are packed as YUV first.
+        if(input.is_planar())
+            input.reformat(VideoFrame::YUV);
+
+        if(input.size() != m_PlannedSize)
+            plan_rungs(input.size());
+
+        // NOTE: the other rungs are written into the output, rather than held by the
+        // filter, so that they are never overwritten while they are still being used.
+        output.renditions.resize(m_Settings.rungs.size() - 1);
+
+        // NOTE: downscales read the smallest rung above them rather than the
+        // input, so the full resolution input is only read by the first ones.
+        for(const auto& stage : m_Stages)
+        {
+            const cv::Size& size = m_Settings.rungs[stage.rung];
+            const VideoFrame& source = stage.source.has_value() ? rung_frame(*stage.source, output) : input;
+            VideoFrame& rung = rung_frame(stage.rung, output);
+
+            if(stage.upscale)
+            {
+                // NOTE: upscales are sharpened in the same pass, as in the ScalingFilter.
+                if(cv::ocl::useOpenCL())
+                    lvk::upscale_sharpen(source, rung, size, m_Settings.sharpness, m_Settings.yuv_input);
+                else
+                {
+                    lvk::upscale_sharpen(
+                        source, rung, size, m_Settings.sharpness, m_Settings.yuv_input, m_TileProcessor
+                    );
+                }
+            }
+            else cv::resize(source, rung, size, 0, 0, cv::INTER_AREA);
+
+            rung.timestamp = input.timestamp;
+            rung.format = input.format;
+        }
+    }
+
+//---------------------------------------------------------------------------------------------------------------------
+
+    size_t ScalingLadderFilter::rung_count() const
+    {
+        return m_Settings.rungs.size();
+    }
+
+//---------------------------------------------------------------------------------------------------------------------
+
+}
@@ -0,0 +1,78 @@
+//     *************************** LiveVisionKit ****************************
+//     Copyright (C) 2022  Sebastian Di Marco (crowsinc.dev@gmail.com)
+//
+//     This program is free software: you can redistribute it and/or modify
+//     it under the terms of the GNU General Public License as published by
+//     the Free Software Foundation, either version 3 of the License, or
+//     (at your option) any later version.
+//
+//     This program is distributed in the hope that it will be useful,
+//     but WITHOUT ANY WARRANTY; without even the implied warranty of
+//     MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//     GNU General Public License for more details.
+//
+//     You should have received a copy of the GNU General Public License
+//     along with this program.  If not, see <https://www.gnu.org/licenses/>.
+//     **********************************************************************
+
+#pragma once
+
+#include <vector>
+#include <optional>
+
+#include "VideoFilter.hpp"
+#include "TileProcessor.hpp"
+#include "Utility/Configurable.hpp"
+
+namespace lvk
+{
+
+    struct ScalingLadderFilterSettings
+    {
+        // NOTE: the first rung is the filter output, the others are carried by the output
+        // as its renditions, in order, so they stay with their frame when it is streamed.
+        std::vector<cv::Size> rungs = {{1920, 1080}, {1280, 720}, {854, 480}};
+        float sharpness = 0.8f;
+        bool yuv_input = true;
+    };
+
+    class ScalingLadderFilter final : public VideoFilter, public Configurable<ScalingLadderFilterSettings>
+    {
+    public:
+
+        explicit ScalingLadderFilter(const ScalingLadderFilterSettings& settings = {});
+
+        void configure(const ScalingLadderFilterSettings& settings) override;
+
+        std::vector<VideoFrame::Format> supported_formats() const override;
+
+        bool changes_geometry() const override;
+
+        size_t rung_count() const;
+
+    private:
+
+        void filter(VideoFrame&& input, VideoFrame& output) override;
+
+        void plan_rungs(const cv::Size& input_size);
+
+        VideoFrame& rung_frame(const size_t index, VideoFrame& output);
+
+    private:
+
+        // NOTE: each rung is either upscaled from the input, or downscaled from the
+        // smallest rung or input which covers it, so that downscales are cascaded.
+        struct RungStage
+        {
+            size_t rung;
+            std::optional<size_t> source;
+            bool upscale;
+        };
+
+        cv::Size m_PlannedSize = {0,0};
+        std::vector<RungStage> m_Stages;
+
+        TileProcessor m_TileProcessor;
+    };
+
+}
@@ -28,6 +28,7 @@ namespace lvk
 
     constexpr float QA_UPDATE_RATE = 0.1f;
     constexpr float QA_BLEND_STEP = 0.05f;
+    constexpr float LENS_CORRECTION_TOLERANCE = 0.25f;
 
 //---------------------------------------------------------------------------------------------------------------------
 
@@ -44,7 +45,9 @@ namespace lvk
         LVK_ASSERT_01(settings.min_tracking_quality);
         LVK_ASSERT_01(settings.min_scene_quality);
 
-        m_NullMotion.resize(settings.motion_resolution);
+        m_Motion.resize(settings.motion_resolution);
+
+        const bool gyro_log_changed = settings.gyro_log != m_Settings.gyro_log;
 
         // We need to reset the context when disabling the stabilization
         // otherwise we'll have a discontinuity when start tracking again.
@@ -53,15 +56,28 @@ namespace lvk
 
         m_Settings = settings;
 
+        // Force the lens correction to be rebuilt with the new parameters.
+        m_LensFrameSize = {0,0};
+
         // Link up the motion resolutions.
         static_cast<PathSmootherSettings&>(m_Settings).motion_resolution = settings.motion_resolution;
         static_cast<FrameTrackerSettings&>(m_Settings).motion_resolution = settings.motion_resolution;
 
         // Configure the path smoother and our auxiliary frame queue.
         m_PathSmoother.configure(m_Settings);
+        m_FrameQueue.configure(m_Settings);
         m_FrameQueue.resize(m_PathSmoother.time_delay() + 1);
 
-        m_FrameTracker.configure(m_Settings);
+        m_FrameAnalysis.configure(m_Settings);
+
+        // Load the new gyro log, falling back to frame tracking if it is invalid.
+        m_GyroSource.configure(m_Settings);
+        if(gyro_log_changed)
+        {
+            m_GyroSource.clear();
+            if(!m_Settings.gyro_log.empty())
+                m_GyroSource.load(m_Settings.gyro_log);
+        }
     }
 
 //---------------------------------------------------------------------------------------------------------------------
@@ -79,27 +95,62 @@ namespace lvk
             m_FrameQueue.push(std::move(input));
             if(ready())
             {
-                // Swap out the frames to avoid unnecessary allocations.
-                std::swap(output, m_FrameQueue.oldest());
-                m_FrameQueue.skip(1);
-
-                // Apply crop to the output
-                if(m_Settings.crop_to_stable_region)
+                // Apply crop, lens correction and fused scaling to the output
+                // NOTE: warp_frame falls back to the frame size if the fusion is invalid.
+                if(m_Settings.crop_to_stable_region || m_Settings.correct_lens || !m_OutputSize.empty())
                 {
-                    m_PathSmoother.scene_crop().apply(output, m_WarpFrame);
-                    std::swap(output, m_WarpFrame);
+                    m_FrameQueue.pop(m_WarpFrame);
+                    warp_frame(
+                        m_Settings.crop_to_stable_region ? m_PathSmoother.scene_crop() : m_NullCorrection,
+                        output
+                    );
                 }
+                else m_FrameQueue.pop(output);
             }
             else output.release();
             return;
         }
 
-        // Track the motion of the incoming frame.
-        input.viewAsFormat(m_TrackingFrame, VideoFrame::GRAY);
-        auto motion = m_FrameTracker.track(m_TrackingFrame).value_or(m_NullMotion);
+        // NOTE: the motion is written into pre-allocated meshes, so that the
+        // steady state of the stabilization does not allocate any new meshes.
+        bool has_motion = false;
+        float tracking_quality = 0.0f;
+        FrameAnalysis* analysis = nullptr;
+        if(!m_GyroSource.empty())
+        {
+            // The gyro log is trusted whenever it covers the frame, otherwise we
+            // treat the gap as a discontinuity and hold the camera path still.
+            has_motion = m_GyroSource.next(input.timestamp, input.size(), m_Motion);
+            tracking_quality = has_motion ? 1.0f : 0.0f;
+        }
+        else
+        {
+            if(m_Settings.frame_analysis == nullptr)
+                m_FrameAnalysis.advance(input);
+
+            analysis = &frame_analysis();
+            LVK_ASSERT(
+                analysis->timestamp() == input.timestamp && analysis->frame_size() == input.size()
+                && "The shared frame analysis was not advanced with the stabilized frame"
+            );
+            has_motion = analysis->has_motion();
+            tracking_quality = analysis->tracking_stability();
+        }
+
+        // NOTE: the motion and path stages which follow the tracking are counted
+        // separately, as they must not allocate once the frame delay is built up.
+        auto& stage_counter = stage_allocations();
+        stage_counter.start();
+
+        if(analysis != nullptr && has_motion)
+        {
+            // A shared analysis may track at a different motion resolution.
+            m_Motion = analysis->motion();
+            m_Motion.resize(m_Settings.motion_resolution);
+        }
+        if(!has_motion) m_Motion.set_identity();
 
         // Apply quality assurance policies
-        const auto tracking_quality = m_FrameTracker.tracking_stability();
         m_SceneQuality = exp_moving_average(m_SceneQuality, tracking_quality, QA_UPDATE_RATE);
         if(tracking_quality < m_Settings.min_tracking_quality)
         {
@@ -112,24 +163,25 @@ namespace lvk
             m_TrustFactor = step(m_TrustFactor, 1.0f, QA_BLEND_STEP);
 
         // Suppress the motion based on the trust factor
-        motion *= m_TrustFactor;
+        m_Motion *= m_TrustFactor;
+
+        const auto& path_correction = m_PathSmoother.next(m_Motion);
+        if(m_Settings.crop_to_stable_region)
+            m_Correction.evaluate(lazy(path_correction) + lazy(m_PathSmoother.scene_crop()));
+        else
+            m_Correction = path_correction;
+
+        stage_counter.stop();
 
         // Push the tracked frame onto the queue to be stabilized later.
         m_FrameQueue.push(std::move(input));
 
         // If the time delay is built up, start stabilizing frames
-        if(auto correction = m_PathSmoother.next(motion); ready())
+        if(ready())
         {
-            // Reference the next frame then skip the buffer by one.
-            // This will shorten the queue without de-allocating.
-            auto& next_frame = m_FrameQueue.oldest();
-            m_FrameQueue.skip();
-
-            if(m_Settings.crop_to_stable_region)
-            {
-                correction += m_PathSmoother.scene_crop();
-            }
-            correction.apply(next_frame, output, m_Settings.background_colour);
+            // Pop the next frame, restoring it from the queue's compact storage.
+            m_FrameQueue.pop(m_WarpFrame);
+            warp_frame(m_Correction, output);
         }
         else output.release();
 	}
@@ -154,16 +206,24 @@ namespace lvk
 
 	void StabilizationFilter::reset_context()
 	{
-		m_FrameTracker.restart();
+        // NOTE: a shared analysis is also restarted, as its tracking is continued for us.
+		m_FrameAnalysis.restart();
+        if(m_Settings.frame_analysis != nullptr)
+            m_Settings.frame_analysis->restart();
         m_PathSmoother.restart();
+        m_GyroSource.restart();
 	}
 
 //---------------------------------------------------------------------------------------------------------------------
 
     void StabilizationFilter::draw_trackers()
     {
+        // NOTE: Planar frames are packed so that the debug info is drawn in colour.
         auto& frame = m_FrameQueue.newest();
-        m_FrameTracker.draw_trackers(
+        if(frame.is_planar())
+            frame.reformat(VideoFrame::YUV);
+
+        frame_analysis().tracker().draw_trackers(
             frame,
             lerp<cv::Scalar,double>(
                 col::RED[frame.format],
@@ -178,7 +238,11 @@ namespace lvk
 
     void StabilizationFilter::draw_motion_mesh()
     {
+        // NOTE: Planar frames are packed so that the debug info is drawn in colour.
         auto& frame = m_FrameQueue.newest();
+        if(frame.is_planar())
+            frame.reformat(VideoFrame::YUV);
+
         draw_grid(
             frame,
             m_Settings.motion_resolution - cv::Size{1,1},
@@ -187,6 +251,96 @@ namespace lvk
         );
     }
 
+//---------------------------------------------------------------------------------------------------------------------
+
+    FrameAnalysis& StabilizationFilter::frame_analysis()
+    {
+        return m_Settings.frame_analysis != nullptr ? *m_Settings.frame_analysis : m_FrameAnalysis;
+    }
+
+//---------------------------------------------------------------------------------------------------------------------
+
+    void StabilizationFilter::prepare_lens_correction(const cv::Size& frame_size)
+    {
+        if(m_LensFrameSize == frame_size)
+            return;
+
+        const auto& parameters = m_Settings.camera_parameters;
+
+        // Scale the intrinsics from the calibration resolution to the frame.
+        cv::Mat camera_matrix = parameters.camera_matrix.clone();
+        if(m_Settings.calibration_resolution.area() > 0)
+        {
+            camera_matrix.row(0) *= static_cast<double>(frame_size.width) / m_Settings.calibration_resolution.width;
+            camera_matrix.row(1) *= static_cast<double>(frame_size.height) / m_Settings.calibration_resolution.height;
+        }
+
+        cv::Rect view_region;
+        const cv::Mat optimal_camera_matrix = cv::getOptimalNewCameraMatrix(
+            camera_matrix,
+            parameters.distortion_coefficients,
+            frame_size,
+            0,
+            frame_size,
+            &view_region
+        );
+
+        cv::Mat correction_map;
+        cv::initUndistortRectifyMap(
+            camera_matrix,
+            parameters.distortion_coefficients,
+            cv::noArray(),
+            optimal_camera_matrix,
+            frame_size,
+            CV_32FC2,
+            correction_map,
+            cv::noArray()
+        );
+
+        // Normalize the view region
+        const cv::Rect2f norm_view_region(
+            cv::Point2f(view_region.tl()) / cv::Size2f(frame_size),
+            cv::Size2f(view_region.size()) / cv::Size2f(frame_size)
+        );
+
+        // Convert the correction map to a warp field, then reduce it to the smallest
+        // resolution which keeps it within tolerance so that composing it is cheap.
+        m_LensCorrection.set_to(std::move(correction_map), false, false);
+        m_LensCorrection.crop_in(norm_view_region);
+        m_LensCorrection.resample(m_LensCorrection.fit_resolution(frame_size, LENS_CORRECTION_TOLERANCE));
+
+        m_LensFrameSize = frame_size;
+    }
+
+//---------------------------------------------------------------------------------------------------------------------
+
+    void StabilizationFilter::warp_frame(const WarpMesh& correction, VideoFrame& output)
+    {
+        const cv::Size output_size = is_scaling_fused(m_WarpFrame.size()) ? m_OutputSize : m_WarpFrame.size();
+        if(!m_Settings.correct_lens)
+        {
+            correction.apply(m_WarpFrame, output, output_size, m_Settings.background_colour);
+            return;
+        }
+
+        // Fold the lens correction into the correction so we only resample the frame once.
+        // The motion was tracked on the distorted frames, so the correction must be applied
+        // in the distorted geometry first, then the stabilized frame is undistorted. Hence
+        // the lens correction is the outer warp. As the lens correction is then fixed to the
+        // output rather than the optics, its centre is off by the correction's displacement,
+        // which is small relative to the distortion for the corrective limits in use.
+        prepare_lens_correction(m_WarpFrame.size());
+
+        const cv::Size correction_size = correction.size(), lens_size = m_LensCorrection.size();
+        const cv::Size resolution(
+            std::max(correction_size.width, lens_size.width),
+            std::max(correction_size.height, lens_size.height)
+        );
+
+        m_ComposedWarp.compose(m_LensCorrection, correction, resolution);
+        m_ComposedWarp.apply(m_WarpFrame, output, output_size, m_Settings.background_colour);
+    }
+
 //---------------------------------------------------------------------------------------------------------------------
 
     size_t StabilizationFilter::frame_delay() const
@@ -204,6 +358,63 @@ namespace lvk
         return {margins.tl() * frame_size, margins.size() * frame_size};
 	}
 
+//---------------------------------------------------------------------------------------------------------------------
+
+    std::vector<VideoFrame::Format> StabilizationFilter::supported_formats() const
+    {
+        // NOTE: planar formats are tracked on their luma and only packed for the warp.
+        return {VideoFrame::YUV, VideoFrame::BGR, VideoFrame::RGB, VideoFrame::NV12, VideoFrame::YUV420P};
+    }
+
+//---------------------------------------------------------------------------------------------------------------------
+
+    bool StabilizationFilter::fuse_scaling(const cv::Size& output_size)
+    {
+        // NOTE: the warp can render any size, but the scaling stage can only upscale, so
+        // a fusion which would downscale the last warped frame is rejected. As the frame
+        // size may still change, the fusion is also validated for every frame.
+        if(!output_size.empty() && !m_WarpFrame.empty() && !can_fuse_scaling(output_size, m_WarpFrame.size()))
+        {
+            m_OutputSize = {0,0};
+            return false;
+        }
+
+        m_OutputSize = output_size.empty() ? cv::Size(0,0) : output_size;
+        return true;
+    }
+
+//---------------------------------------------------------------------------------------------------------------------
+
+    bool StabilizationFilter::changes_geometry() const
+    {
+        return true;
+    }
+
+//---------------------------------------------------------------------------------------------------------------------
+
+    const FrameAnalysis* StabilizationFilter::shared_analysis() const
+    {
+        // NOTE: the gyro log replaces the analysis, and the analysis is unused while not stabilizing.
+        if(!m_Settings.stabilize_output || !m_GyroSource.empty())
+            return nullptr;
+
+        return m_Settings.frame_analysis.get();
+    }
+
+//---------------------------------------------------------------------------------------------------------------------
+
+    bool StabilizationFilter::is_scaling_fused(const cv::Size& frame_size) const
+    {
+        return !m_OutputSize.empty() && can_fuse_scaling(m_OutputSize, frame_size);
+    }
+
+//---------------------------------------------------------------------------------------------------------------------
+
+    bool StabilizationFilter::can_fuse_scaling(const cv::Size& output_size, const cv::Size& frame_size)
+    {
+        return output_size.width >= frame_size.width && output_size.height >= frame_size.height;
+    }
+
 //---------------------------------------------------------------------------------------------------------------------
 
 }
\ No newline at end of file
@@ -17,22 +17,43 @@
 
 #pragma once
 
+#include <memory>
+
 #include "VideoFilter.hpp"
-#include "Vision/FrameTracker.hpp"
+#include "Vision/FrameAnalysis.hpp"
 #include "Vision/PathSmoother.hpp"
+#include "Vision/GyroMotionSource.hpp"
+#include "Data/FrameQueue.hpp"
 #include "Utility/Configurable.hpp"
 
 namespace lvk
 {
 
-	struct StabilizationFilterSettings : public FrameTrackerSettings, public PathSmootherSettings
+	struct StabilizationFilterSettings
+        : public FrameTrackerSettings,
+          public PathSmootherSettings,
+          public GyroMotionSourceSettings,
+          public FrameQueueSettings
 	{
         cv::Size motion_resolution = {2, 2};
 
+        // NOTE: replaces the frame tracking with the rotations of the gyro log, if given.
+        std::filesystem::path gyro_log;
+
+        // NOTE: if given, the motion is taken from the shared analysis, which must be
+        // advanced by its owner (e.g. a CompositeFilter), and the tracker settings are unused.
+        std::shared_ptr<FrameAnalysis> frame_analysis = nullptr;
+
 		cv::Scalar background_colour = {255,0,255};
         bool crop_to_stable_region = false;
 		bool stabilize_output = true;
 
+        // NOTE: undistorts the output using the camera parameters. The correction is
+        // folded into the stabilization warp so each frame is only resampled once.
+        // Tracking runs on the distorted frames, so the stabilization is applied in
+        // the distorted geometry and the stabilized frame is undistorted after.
+        bool correct_lens = false;
+
         // Quality Assurance
         float min_scene_quality = 0.8f;
         float min_tracking_quality = 0.3f;
@@ -61,17 +82,43 @@ namespace lvk
 
 		cv::Rect stable_region() const;
 
+        std::vector<VideoFrame::Format> supported_formats() const override;
+
+        bool fuse_scaling(const cv::Size& output_size) override;
+
+        bool changes_geometry() const override;
+
+        const FrameAnalysis* shared_analysis() const override;
+
 	private:
 
         void filter(VideoFrame&& input, VideoFrame& output) override;
 
+        FrameAnalysis& frame_analysis();
+
+        void prepare_lens_correction(const cv::Size& frame_size);
+
+        void warp_frame(const WarpMesh& correction, VideoFrame& output);
+
+        bool is_scaling_fused(const cv::Size& frame_size) const;
+
+        static bool can_fuse_scaling(const cv::Size& output_size, const cv::Size& frame_size);
+
 	private:
-		FrameTracker m_FrameTracker;
+		FrameAnalysis m_FrameAnalysis;
 		PathSmoother m_PathSmoother;
-
-        StreamBuffer<Frame> m_FrameQueue{1};
-        VideoFrame m_WarpFrame, m_TrackingFrame;
-        WarpMesh m_NullMotion{WarpMesh::MinimumSize};
+        GyroMotionSource m_GyroSource;
+
+        FrameQueue m_FrameQueue{1};
+        VideoFrame m_WarpFrame;
+        WarpMesh m_Motion{WarpMesh::MinimumSize};
+        WarpMesh m_Correction{WarpMesh::MinimumSize};
+
+        WarpMesh m_NullCorrection{WarpMesh::MinimumSize};
+        WarpMesh m_LensCorrection{WarpMesh::MinimumSize};
+        WarpMesh m_ComposedWarp{WarpMesh::MinimumSize};
+        cv::Size m_LensFrameSize = {0,0};
+        cv::Size m_OutputSize = {0,0};
 
         float m_SceneQuality = 0.0f;
         float m_TrustFactor = 0.0f;
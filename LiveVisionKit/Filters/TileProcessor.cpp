@@ -0,0 +1,96 @@
+//    *************************** LiveVisionKit ****************************
+//    Copyright (C) 2022  Sebastian Di Marco (crowsinc.dev@gmail.com)
+//
+//    This program is free software: you can redistribute it and/or modify
+//    it under the terms of the GNU General Public License as published by
+//    the Free Software Foundation, either version 3 of the License, or
+//    (at your option) any later version.
+//
+//    This program is distributed in the hope that it will be useful,
+//    but WITHOUT ANY WARRANTY; without even the implied warranty of
+//    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//    GNU General Public License for more details.
+//
+//    You should have received a copy of the GNU General Public License
+//    along with this program.  If not, see <https://www.gnu.org/licenses/>.
+// 	  **********************************************************************
+
+#include "TileProcessor.hpp"
+
+#include "Directives.hpp"
+
+namespace lvk
+{
+
+//---------------------------------------------------------------------------------------------------------------------
+
+    TileProcessor::TileProcessor(const TileProcessorSettings& settings)
+    {
+        configure(settings);
+    }
+
+//---------------------------------------------------------------------------------------------------------------------
+
+    void TileProcessor::configure(const TileProcessorSettings& settings)
+    {
+        LVK_ASSERT(settings.tile_size.width > 0 && settings.tile_size.height > 0);
+        LVK_ASSERT(settings.alignment > 0);
+        LVK_ASSERT(settings.halo >= 0);
+
+        m_Settings = settings;
+
+        // Round the tile size and halo up to the alignment.
+        const int alignment = m_Settings.alignment;
+        m_Settings.halo = ((m_Settings.halo + alignment - 1) / alignment) * alignment;
+        m_Settings.tile_size.width = ((m_Settings.tile_size.width + alignment - 1) / alignment) * alignment;
+        m_Settings.tile_size.height = ((m_Settings.tile_size.height + alignment - 1) / alignment) * alignment;
+
+        // Force the tiles to be re-generated on the next use.
+        m_FrameSize = {0, 0};
+        m_Tiles.clear();
+    }
+
+//---------------------------------------------------------------------------------------------------------------------
+
+    const std::vector<Tile>& TileProcessor::tiles(const cv::Size& frame_size)
+    {
+        LVK_ASSERT(frame_size.width > 0 && frame_size.height > 0);
+
+        if(frame_size != m_FrameSize)
+            generate_tiles(frame_size);
+
+        return m_Tiles;
+    }
+
+//---------------------------------------------------------------------------------------------------------------------
+
+    void TileProcessor::generate_tiles(const cv::Size& frame_size)
+    {
+        const cv::Rect frame_region({0,0}, frame_size);
+        const auto& tile_size = m_Settings.tile_size;
+        const int halo = m_Settings.halo;
+
+        m_Tiles.clear();
+        for(int y = 0; y < frame_size.height; y += tile_size.height)
+        {
+            for(int x = 0; x < frame_size.width; x += tile_size.width)
+            {
+                auto& tile = m_Tiles.emplace_back();
+
+                tile.region = cv::Rect(x, y, tile_size.width, tile_size.height) & frame_region;
+                tile.padded_region = cv::Rect(
+                    tile.region.x - halo,
+                    tile.region.y - halo,
+                    tile.region.width + 2 * halo,
+                    tile.region.height + 2 * halo
+                ) & frame_region;
+                tile.inner_region = cv::Rect(tile.region.tl() - tile.padded_region.tl(), tile.region.size());
+            }
+        }
+
+        m_FrameSize = frame_size;
+    }
+
+//---------------------------------------------------------------------------------------------------------------------
+
+}
@@ -0,0 +1,69 @@
+//    *************************** LiveVisionKit ****************************
+//    Copyright (C) 2022  Sebastian Di Marco (crowsinc.dev@gmail.com)
+//
+//    This program is free software: you can redistribute it and/or modify
+//    it under the terms of the GNU General Public License as published by
+//    the Free Software Foundation, either version 3 of the License, or
+//    (at your option) any later version.
+//
+//    This program is distributed in the hope that it will be useful,
+//    but WITHOUT ANY WARRANTY; without even the implied warranty of
+//    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//    GNU General Public License for more details.
+//
+//    You should have received a copy of the GNU General Public License
+//    along with this program.  If not, see <https://www.gnu.org/licenses/>.
+// 	  **********************************************************************
+
+#pragma once
+
+#include <vector>
+#include <opencv2/opencv.hpp>
+
+#include "Utility/Configurable.hpp"
+
+namespace lvk
+{
+
+    struct Tile
+    {
+        cv::Rect region;        // The region of the frame owned by the tile.
+        cv::Rect padded_region; // The owned region plus its halo, clamped to the frame.
+        cv::Rect inner_region;  // The owned region, relative to the padded region.
+    };
+
+    struct TileProcessorSettings
+    {
+        cv::Size tile_size = {256, 256};
+        int halo = 0;
+        int alignment = 1; // Tile origins and halos are a multiple of this.
+    };
+
+    class TileProcessor final : public Configurable<TileProcessorSettings>
+    {
+    public:
+
+        explicit TileProcessor(const TileProcessorSettings& settings = {});
+
+        void configure(const TileProcessorSettings& settings) override;
+
+        // NOTE: Tiles are processed concurrently on the OpenCV worker pool, so
+        // any intermediate buffers used by the pass should be thread_local. Each
+        // pass must only write to the region owned by its tile.
+        template<typename TilePass>
+        void process(const cv::Size& frame_size, TilePass&& pass);
+
+        const std::vector<Tile>& tiles(const cv::Size& frame_size);
+
+    private:
+
+        void generate_tiles(const cv::Size& frame_size);
+
+    private:
+        cv::Size m_FrameSize{0, 0};
+        std::vector<Tile> m_Tiles;
+    };
+
+}
+
+#include "TileProcessor.tpp"
@@ -25,6 +25,7 @@
 #include <mutex>
 
 #include "Timing/TickTimer.hpp"
+#include "Functions/OpenCL/Execution.hpp"
 
 namespace lvk
 {
@@ -45,9 +46,17 @@ namespace lvk
 
     void VideoFilter::apply(VideoFrame&& input, VideoFrame& output, const bool profile)
     {
-        m_FrameTimer.sync_gpu(profile).start();
+        m_Profiling = profile;
+        m_Timings.allocations.start();
+        m_Timings.host.start();
+        if(profile) m_Timings.device.start();
+
         filter(std::move(input), output);
-        m_FrameTimer.sync_gpu(profile).stop();
+
+        if(profile) m_Timings.device.stop();
+        m_Timings.host.stop();
+        m_Timings.allocations.stop();
+        m_Profiling = false;
     }
 
 //---------------------------------------------------------------------------------------------------------------------
@@ -61,12 +70,26 @@ namespace lvk
 
     void VideoFilter::stream(cv::VideoCapture& input, const std::function<bool(Frame&)>& callback, const bool profile)
     {
-        LVK_ASSERT(input.isOpened());
+        CaptureSource source(input);
+        stream(source, callback, profile);
+    }
 
+//---------------------------------------------------------------------------------------------------------------------
+
+    void VideoFilter::stream(FrameSource& input, const std::function<bool(Frame&)>& callback, const bool profile)
+    {
         const size_t max_buffer_frames = 15;
 
+        // NOTE: each stage runs on its own thread and queue, so frames carry
+        // an event which signals when the previous stage has finished them.
+        struct StreamFrame
+        {
+            Frame frame;
+            ocl::Event ready;
+        };
+
         std::mutex input_mutex, output_mutex;
-        std::queue<Frame> input_queue, output_queue;
+        std::queue<StreamFrame> input_queue, output_queue;
 
         std::condition_variable input_consume_flag, output_consume_flag;
         std::condition_variable input_available_flag, output_available_flag;
@@ -75,16 +98,16 @@ namespace lvk
         // Input Processor
         // This reads frames from the input stream and passes them off for filtering.
         auto input_thread = std::thread([&](){
-            Frame read_frame;
-            while(input.read(read_frame) && !terminate_input)
+            auto& context = ocl::ExecutionContext::Default();
+            const auto read_frame = [&](Frame& frame){
+                // Upload on the transfer queue, to overlap with the filtering of earlier frames.
+                ocl::ExecutionContext::Scope transfer_scope(context, ocl::ExecutionContext::TRANSFER);
+                return input.read(frame);
+            };
+
+            Frame frame;
+            while(read_frame(frame) && !terminate_input)
             {
-                // Assume the input frame is BGR
-                read_frame.format = VideoFrame::BGR;
-
-                // Set frame timestamp if supported, otherwise set it to zero.
-                const auto stream_position = std::max(0.0, input.get(cv::CAP_PROP_POS_MSEC));
-                read_frame.timestamp = static_cast<uint64_t>(Time::Milliseconds(stream_position).nanoseconds());
-
                 // Push new frame onto the input queue
                 {
                     std::unique_lock<std::mutex> queue_lock(input_mutex);
@@ -93,7 +116,7 @@ namespace lvk
                     while(input_queue.size() >= max_buffer_frames)
                         input_consume_flag.wait(queue_lock);
 
-                    input_queue.push(std::move(read_frame));
+                    input_queue.push({std::move(frame), context.record(ocl::ExecutionContext::TRANSFER)});
                     if(input_queue.size() == 1)
                         input_available_flag.notify_one();
                 }
@@ -106,7 +129,10 @@ namespace lvk
         // Filter Processor
         // This grabs frames delivered by the input processor, filters them, and passes them off for output.
         auto filter_thread = std::thread([&](){
-            Frame input_frame, filtered_frame;
+            auto& context = ocl::ExecutionContext::Default();
+
+            StreamFrame input_frame;
+            Frame filtered_frame;
             while(true)
             {
                 // Pop a frame from the input queue
@@ -131,8 +157,9 @@ namespace lvk
                     input_consume_flag.notify_one();
                 }
 
-                // Process the frame
-                this->apply(std::move(input_frame), filtered_frame, profile);
+                // Process the frame once it has finished uploading
+                context.wait(ocl::ExecutionContext::COMPUTE, input_frame.ready);
+                this->apply(std::move(input_frame.frame), filtered_frame, profile);
                 if(filtered_frame.empty())
                     continue;
 
@@ -144,7 +171,7 @@ namespace lvk
                     while(output_queue.size() >= max_buffer_frames)
                         output_consume_flag.wait(queue_lock);
 
-                    output_queue.push(std::move(filtered_frame));
+                    output_queue.push({std::move(filtered_frame), context.record(ocl::ExecutionContext::COMPUTE)});
                     if(output_queue.size() == 1)
                         output_available_flag.notify_one();
                 }
@@ -154,7 +181,8 @@ namespace lvk
 
         // Output Processor
         // This grabs filtered frames delivered by the filter processor and sends them to the user callback.
-        Frame output_frame;
+        auto& context = ocl::ExecutionContext::Default();
+        StreamFrame output_frame;
         while(true)
         {
             // Pop next frame from the output queue
@@ -179,8 +207,10 @@ namespace lvk
                 output_consume_flag.notify_one();
             }
 
-            // Send frame to the output
-            if(callback(output_frame))
+            // Send frame to the output, downloading it on the transfer queue once it is filtered.
+            context.wait(ocl::ExecutionContext::TRANSFER, output_frame.ready);
+            ocl::ExecutionContext::Scope transfer_scope(context, ocl::ExecutionContext::TRANSFER);
+            if(callback(output_frame.frame))
             {
                 // User called for the processing to be terminated.
 
@@ -214,14 +244,50 @@ namespace lvk
     {
         LVK_ASSERT(samples >= 1);
 
-        m_FrameTimer.set_history_size(samples);
+        m_Timings.host.set_history_size(samples);
+        m_Timings.device.set_history_size(samples);
+    }
+
+//---------------------------------------------------------------------------------------------------------------------
+
+    const FilterTimings& VideoFilter::timings() const
+    {
+        return m_Timings;
+    }
+
+//---------------------------------------------------------------------------------------------------------------------
+
+    std::vector<VideoFrame::Format> VideoFilter::supported_formats() const
+    {
+        return {};
+    }
+
+//---------------------------------------------------------------------------------------------------------------------
+
+    bool VideoFilter::fuse_scaling(const cv::Size&)
+    {
+        return false;
+    }
+
+//---------------------------------------------------------------------------------------------------------------------
+
+    std::optional<cv::Size> VideoFilter::scaling_size() const
+    {
+        return std::nullopt;
     }
 
 //---------------------------------------------------------------------------------------------------------------------
 
-    const Stopwatch& VideoFilter::timings() const
+    bool VideoFilter::changes_geometry() const
     {
-        return m_FrameTimer;
+        return scaling_size().has_value();
+    }
+
+//---------------------------------------------------------------------------------------------------------------------
+
+    const FrameAnalysis* VideoFilter::shared_analysis() const
+    {
+        return nullptr;
     }
 
 //---------------------------------------------------------------------------------------------------------------------
@@ -232,6 +298,20 @@ namespace lvk
         output = std::move(input);
     }
 
+//---------------------------------------------------------------------------------------------------------------------
+
+    bool VideoFilter::is_profiling() const
+    {
+        return m_Profiling;
+    }
+
+//---------------------------------------------------------------------------------------------------------------------
+
+    AllocationCounter& VideoFilter::stage_allocations()
+    {
+        return m_Timings.stage_allocations;
+    }
+
 //---------------------------------------------------------------------------------------------------------------------
 
 }
\ No newline at end of file
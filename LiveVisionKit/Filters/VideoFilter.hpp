@@ -17,17 +17,39 @@
 
 #pragma once
 
+#include <vector>
+#include <optional>
 #include <functional>
 #include <opencv2/opencv.hpp>
 #include <opencv2/videoio.hpp>
 
 #include "Utility/Unique.hpp"
 #include "Data/VideoFrame.hpp"
+#include "Data/FrameSource.hpp"
 #include "Timing/Stopwatch.hpp"
+#include "Timing/DeviceTimer.hpp"
+#include "Utility/AllocationCounter.hpp"
 
 namespace lvk
 {
 
+    class FrameAnalysis;
+
+    // NOTE: Host time is the wall time spent submitting the filter, while device
+    // time is the OpenCL execution time of the filter, which is only profiled
+    // when requested, as it may be measured some frames after submission. The
+    // allocations of the last frame are only counted if the build supports it.
+    // The stage allocations are those of the stages which the filter itself
+    // brackets, such as the motion and path stages of the stabilization, and
+    // are zero for filters which do not count any stages.
+    struct FilterTimings
+    {
+        Stopwatch host;
+        DeviceTimer device;
+        AllocationCounter allocations;
+        AllocationCounter stage_allocations;
+    };
+
     // NOTE: standard colour format is YUV.
 	class VideoFilter : public Unique<VideoFilter>
 	{
@@ -46,17 +68,45 @@ namespace lvk
 
         void stream(cv::VideoCapture& input, const std::function<bool(Frame&)>& callback, const bool profile = false);
 
+        void stream(FrameSource& input, const std::function<bool(Frame&)>& callback, const bool profile = false);
+
 
         void set_timing_samples(const size_t samples);
 
-        const Stopwatch& timings() const;
+        const FilterTimings& timings() const;
+
+
+        // NOTE: the formats the filter processes without converting internally, in
+        // order of preference. An empty list means that any format is accepted.
+        virtual std::vector<VideoFrame::Format> supported_formats() const;
+
+        // NOTE: filters which finish by warping the frame may render the warp at
+        // another size, so that a following scaling stage is fused into the same
+        // remap. An empty size restores the input size. Returns false if unsupported.
+        virtual bool fuse_scaling(const cv::Size& output_size);
+
+        // NOTE: the size which the filter scales frames to, if it is a scaling stage.
+        virtual std::optional<cv::Size> scaling_size() const;
+
+        // NOTE: whether the filter may move the content of the frame, such as by warping
+        // or scaling it, so that an analysis of its input no longer matches its output.
+        virtual bool changes_geometry() const;
+
+        // NOTE: the shared frame analysis which the filter reads, if any. It must be
+        // advanced by its owner with the same frame which is given to the filter.
+        virtual const FrameAnalysis* shared_analysis() const;
 
     protected:
 
         virtual void filter(VideoFrame&& input, VideoFrame& output);
 
+        bool is_profiling() const;
+
+        AllocationCounter& stage_allocations();
+
     private:
-        Stopwatch m_FrameTimer;
+        bool m_Profiling = false;
+        FilterTimings m_Timings;
 		const std::string m_Alias;
 	};
 
@@ -0,0 +1,551 @@
+//     *************************** LiveVisionKit ****************************
+//     Copyright (C) 2022  Sebastian Di Marco (crowsinc.dev@gmail.com)
+//
+//     This program is free software: you can redistribute it and/or modify
+//     it under the terms of the GNU General Public License as published by
+//     the Free Software Foundation, either version 3 of the License, or
+//     (at your option) any later version.
+//
+//     This program is distributed in the hope that it will be useful,
+//     but WITHOUT ANY WARRANTY; without even the implied warranty of
+//     MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//     GNU General Public License for more details.
+//
+//     You should have received a copy of the GNU General Public License
+//     along with this program.  If not, see <https://www.gnu.org/licenses/>.
+//     **********************************************************************
+
+#include "Conversion.hpp"
+
+#include <array>
+#include <opencv2/core/hal/intrin.hpp>
+
+#include "OpenCL/Kernels.hpp"
+#include "Directives.hpp"
+
+namespace lvk
+{
+
+//---------------------------------------------------------------------------------------------------------------------
+
+    constexpr auto FORMAT_COUNT = static_cast<size_t>(VideoFrame::GRAY) + 1;
+
+    // NOTE: the dispatch tables are indexed by [src_format][dst_format], following
+    // the ordering of the packed VideoFrame formats (BGR, BGRA, RGB, RGBA, YUV, GRAY).
+
+    // Single-pass kernels, as generated by the CONVERSION macro in Conversion.cl
+    constexpr std::array<std::array<const char*, FORMAT_COUNT>, FORMAT_COUNT> CONVERSION_KERNELS = {{
+        {nullptr, "bgr_to_bgra", "bgr_to_rgb", "bgr_to_rgba", "bgr_to_yuv", "bgr_to_gray"},
+        {"bgra_to_bgr", nullptr, "bgra_to_rgb", "bgra_to_rgba", "bgra_to_yuv", "bgra_to_gray"},
+        {"rgb_to_bgr", "rgb_to_bgra", nullptr, "rgb_to_rgba", "rgb_to_yuv", "rgb_to_gray"},
+        {"rgba_to_bgr", "rgba_to_bgra", "rgba_to_rgb", nullptr, "rgba_to_yuv", "rgba_to_gray"},
+        {"yuv_to_bgr", "yuv_to_bgra", "yuv_to_rgb", "yuv_to_rgba", nullptr, "yuv_to_gray"},
+        {"gray_to_bgr", "gray_to_bgra", "gray_to_rgb", "gray_to_rgba", "gray_to_yuv", nullptr}
+    }};
+
+    // Single-pass CPU conversion codes, -1 denotes a custom SIMD conversion.
+    // NOTE: OpenCV's BGR2YUV accepts 4 channel inputs and YUV2BGR accepts a 4 channel output.
+    constexpr std::array<std::array<int, FORMAT_COUNT>, FORMAT_COUNT> CONVERSION_CODES = {{
+        {-1, cv::COLOR_BGR2BGRA, cv::COLOR_BGR2RGB, cv::COLOR_BGR2RGBA, cv::COLOR_BGR2YUV, cv::COLOR_BGR2GRAY},
+        {cv::COLOR_BGRA2BGR, -1, cv::COLOR_BGRA2RGB, cv::COLOR_BGRA2RGBA, cv::COLOR_BGR2YUV, cv::COLOR_BGRA2GRAY},
+        {cv::COLOR_RGB2BGR, cv::COLOR_RGB2BGRA, -1, cv::COLOR_RGB2RGBA, cv::COLOR_RGB2YUV, cv::COLOR_RGB2GRAY},
+        {cv::COLOR_RGBA2BGR, cv::COLOR_RGBA2BGRA, cv::COLOR_RGBA2RGB, -1, cv::COLOR_RGB2YUV, cv::COLOR_RGBA2GRAY},
+        {cv::COLOR_YUV2BGR, cv::COLOR_YUV2BGR, cv::COLOR_YUV2RGB, cv::COLOR_YUV2RGB, -1, -1},
+        {cv::COLOR_GRAY2BGR, cv::COLOR_GRAY2BGRA, cv::COLOR_GRAY2RGB, cv::COLOR_GRAY2RGBA, -1, -1}
+    }};
+
+    // NOTE: planar formats report the channels of their luma plane.
+    constexpr std::array<int, VideoFrame::UNKNOWN> FORMAT_CHANNELS = {3, 4, 3, 4, 3, 1, 1, 1};
+
+    // Single-pass luma downscaling kernels, as generated by the LUMA_AREA macro in Conversion.cl
+    constexpr std::array<const char*, FORMAT_COUNT> LUMA_AREA_KERNELS = {
+        "bgr_to_luma_area", "bgra_to_luma_area", "rgb_to_luma_area",
+        "rgba_to_luma_area", "yuv_to_luma_area", "gray_to_luma_area"
+    };
+
+    // NOTE: luma weights match those of cv::COLOR_BGR2GRAY.
+    constexpr float LUMA_R_WEIGHT = 0.299f, LUMA_G_WEIGHT = 0.587f, LUMA_B_WEIGHT = 0.114f;
+
+//---------------------------------------------------------------------------------------------------------------------
+
+    int channels_of(const VideoFrame::Format format)
+    {
+        LVK_ASSERT(format != VideoFrame::UNKNOWN);
+
+        return FORMAT_CHANNELS[format];
+    }
+
+//---------------------------------------------------------------------------------------------------------------------
+
+    bool is_planar_format(const VideoFrame::Format format)
+    {
+        return format == VideoFrame::YUV420P || format == VideoFrame::NV12;
+    }
+
+//---------------------------------------------------------------------------------------------------------------------
+
+    static cv::Size chroma_size_of(const cv::Size& luma_size)
+    {
+        return {(luma_size.width + 1) / 2, (luma_size.height + 1) / 2};
+    }
+
+//---------------------------------------------------------------------------------------------------------------------
+
+    static void convert_gray_to_yuv(const cv::Mat& src, cv::Mat& dst)
+    {
+        cv::parallel_for_(cv::Range(0, src.rows), [&](const cv::Range& rows){
+            for(int r = rows.start; r < rows.end; r++)
+            {
+                const uint8_t* src_row = src.ptr<uint8_t>(r);
+                uint8_t* dst_row = dst.ptr<uint8_t>(r);
+
+                int c = 0;
+#if CV_SIMD128
+                // Interleave the gray plane as luma, with two neutral chroma planes.
+                const cv::v_uint8x16 chroma = cv::v_setall_u8(128);
+                for(; c <= src.cols - cv::v_uint8x16::nlanes; c += cv::v_uint8x16::nlanes)
+                    cv::v_store_interleave(dst_row + 3 * c, cv::v_load(src_row + c), chroma, chroma);
+#endif
+                for(; c < src.cols; c++)
+                {
+                    dst_row[3 * c + 0] = src_row[c];
+                    dst_row[3 * c + 1] = 128;
+                    dst_row[3 * c + 2] = 128;
+                }
+            }
+        });
+    }
+
+//---------------------------------------------------------------------------------------------------------------------
+
+    static void convert_on_cpu(
+        const cv::UMat& src,
+        cv::UMat& dst,
+        const VideoFrame::Format src_format,
+        const VideoFrame::Format dst_format
+    )
+    {
+        if(const int code = CONVERSION_CODES[src_format][dst_format]; code >= 0)
+        {
+            cv::cvtColor(src, dst, code, FORMAT_CHANNELS[dst_format]);
+        }
+        else if(src_format == VideoFrame::YUV && dst_format == VideoFrame::GRAY)
+        {
+            cv::extractChannel(src, dst, 0);
+        }
+        else if(src_format == VideoFrame::GRAY && dst_format == VideoFrame::YUV)
+        {
+            dst.create(src.size(), CV_8UC3, cv::UMatUsageFlags::USAGE_ALLOCATE_DEVICE_MEMORY);
+
+            cv::Mat dst_data = dst.getMat(cv::ACCESS_WRITE);
+            convert_gray_to_yuv(src.getMat(cv::ACCESS_READ), dst_data);
+        }
+        else LVK_ASSERT(false && "Unsupported conversion");
+    }
+
+//---------------------------------------------------------------------------------------------------------------------
+
+    static void convert_on_ocl(
+        const cv::UMat& src,
+        cv::UMat& dst,
+        const VideoFrame::Format src_format,
+        const VideoFrame::Format dst_format
+    )
+    {
+        const char* kernel_name = CONVERSION_KERNELS[src_format][dst_format];
+        LVK_ASSERT(kernel_name != nullptr);
+
+        // NOTE: all conversion kernels are compiled within the same program.
+        static auto program = ocl::load_program("conversion", ocl::src::conversion_source);
+        LVK_ASSERT(!program.empty());
+
+        auto kernel = ocl::next_kernel(program, kernel_name);
+        LVK_ASSERT(!kernel.empty());
+
+        // Allocate the output.
+        dst.create(
+            src.size(),
+            CV_8UC(FORMAT_CHANNELS[dst_format]),
+            cv::UMatUsageFlags::USAGE_ALLOCATE_DEVICE_MEMORY
+        );
+
+        // Find optimal work sizes for the 2D src buffer. All the conversion
+        // kernels share the same access pattern, so they are tuned together.
+        size_t global_work_size[3], local_work_size[3];
+        ocl::optimal_groups("conversion", kernel, src, global_work_size, local_work_size);
+
+        // Run the kernel in async mode.
+        kernel.args(
+            cv::ocl::KernelArg::ReadOnly(src),
+            cv::ocl::KernelArg::WriteOnlyNoSize(dst)
+        );
+        ocl::launch(kernel, 2, global_work_size, local_work_size);
+    }
+
+//---------------------------------------------------------------------------------------------------------------------
+
+    void convert(
+        const cv::UMat& src,
+        cv::UMat& dst,
+        const VideoFrame::Format src_format,
+        const VideoFrame::Format dst_format
+    )
+    {
+        LVK_ASSERT(src_format != VideoFrame::UNKNOWN && !is_planar_format(src_format));
+        LVK_ASSERT(dst_format != VideoFrame::UNKNOWN && !is_planar_format(dst_format));
+        LVK_ASSERT(src_format != dst_format);
+        LVK_ASSERT(src.type() == CV_8UC(FORMAT_CHANNELS[src_format]));
+        LVK_ASSERT(!src.empty());
+
+        if(cv::ocl::useOpenCL())
+            convert_on_ocl(src, dst, src_format, dst_format);
+        else
+            convert_on_cpu(src, dst, src_format, dst_format);
+    }
+
+//---------------------------------------------------------------------------------------------------------------------
+
+    static void accumulate_luma_row(
+        const uint8_t* src,
+        float* dst,
+        const int cols,
+        const float weight,
+        const VideoFrame::Format format
+    )
+    {
+        const int channels = FORMAT_CHANNELS[format];
+        const bool has_colour = format <= VideoFrame::RGBA;
+        const bool bgr_order = format == VideoFrame::BGR || format == VideoFrame::BGRA;
+
+        // Weights of the first three channels, pre-multiplied by the row weight.
+        const float w0 = weight * (has_colour ? (bgr_order ? LUMA_B_WEIGHT : LUMA_R_WEIGHT) : 1.0f);
+        const float w1 = weight * (has_colour ? LUMA_G_WEIGHT : 0.0f);
+        const float w2 = weight * (has_colour ? (bgr_order ? LUMA_R_WEIGHT : LUMA_B_WEIGHT) : 0.0f);
+
+        int c = 0;
+#if CV_SIMD128
+        constexpr int lanes = cv::v_uint8x16::nlanes;
+        const auto expand_to_float = [](const cv::v_uint8x16& values, cv::v_float32x4 result[4]){
+            cv::v_uint16x8 low, high;
+            cv::v_uint32x4 a, b;
+
+            cv::v_expand(values, low, high);
+            cv::v_expand(low, a, b);
+            result[0] = cv::v_cvt_f32(cv::v_reinterpret_as_s32(a));
+            result[1] = cv::v_cvt_f32(cv::v_reinterpret_as_s32(b));
+            cv::v_expand(high, a, b);
+            result[2] = cv::v_cvt_f32(cv::v_reinterpret_as_s32(a));
+            result[3] = cv::v_cvt_f32(cv::v_reinterpret_as_s32(b));
+        };
+
+        const cv::v_float32x4 v_w0 = cv::v_setall_f32(w0), v_w1 = cv::v_setall_f32(w1), v_w2 = cv::v_setall_f32(w2);
+        for(; c <= cols - lanes; c += lanes)
+        {
+            cv::v_uint8x16 p0, p1, p2, p3;
+            if(channels == 1)
+                p0 = cv::v_load(src + c);
+            else if(channels == 3)
+                cv::v_load_deinterleave(src + 3 * c, p0, p1, p2);
+            else
+                cv::v_load_deinterleave(src + 4 * c, p0, p1, p2, p3);
+
+            cv::v_float32x4 c0[4], c1[4], c2[4];
+            expand_to_float(p0, c0);
+            if(has_colour)
+            {
+                expand_to_float(p1, c1);
+                expand_to_float(p2, c2);
+            }
+
+            for(int k = 0; k < 4; k++)
+            {
+                float* dst_ptr = dst + c + k * cv::v_float32x4::nlanes;
+
+                cv::v_float32x4 sum = cv::v_muladd(c0[k], v_w0, cv::v_load(dst_ptr));
+                if(has_colour)
+                    sum = cv::v_muladd(c2[k], v_w2, cv::v_muladd(c1[k], v_w1, sum));
+
+                cv::v_store(dst_ptr, sum);
+            }
+        }
+#endif
+        for(; c < cols; c++)
+        {
+            const uint8_t* pixel = src + c * channels;
+            dst[c] += w0 * pixel[0];
+            if(has_colour) dst[c] += w1 * pixel[1] + w2 * pixel[2];
+        }
+    }
+
+//---------------------------------------------------------------------------------------------------------------------
+
+    static void downscale_luma_on_cpu(
+        const cv::UMat& src,
+        cv::UMat& dst,
+        const VideoFrame::Format src_format,
+        const cv::Size& size
+    )
+    {
+        dst.create(size, CV_8UC1, cv::UMatUsageFlags::USAGE_ALLOCATE_DEVICE_MEMORY);
+
+        const cv::Mat src_data = src.getMat(cv::ACCESS_READ);
+        cv::Mat dst_data = dst.getMat(cv::ACCESS_WRITE);
+
+        const float scale_x = static_cast<float>(src.cols) / static_cast<float>(size.width);
+        const float scale_y = static_cast<float>(src.rows) / static_cast<float>(size.height);
+        const float normalization = 1.0f / (scale_x * scale_y);
+
+        cv::parallel_for_(cv::Range(0, size.height), [&](const cv::Range& rows){
+            thread_local std::vector<float> luma_sums;
+            luma_sums.resize(src.cols);
+
+            for(int r = rows.start; r < rows.end; r++)
+            {
+                // Vertically accumulate the luma of all rows covered by the destination row.
+                std::fill(luma_sums.begin(), luma_sums.end(), 0.0f);
+
+                const float y_start = static_cast<float>(r) * scale_y;
+                const float y_end = std::min(y_start + scale_y, static_cast<float>(src.rows));
+                for(int y = static_cast<int>(y_start); y < static_cast<int>(std::ceil(y_end)); y++)
+                {
+                    const float y_weight = std::min(y_end, y + 1.0f) - std::max(y_start, static_cast<float>(y));
+                    accumulate_luma_row(src_data.ptr<uint8_t>(y), luma_sums.data(), src.cols, y_weight, src_format);
+                }
+
+                // Horizontally accumulate the sums covered by each destination pixel.
+                auto* dst_row = dst_data.ptr<uint8_t>(r);
+                for(int c = 0; c < size.width; c++)
+                {
+                    const float x_start = static_cast<float>(c) * scale_x;
+                    const float x_end = std::min(x_start + scale_x, static_cast<float>(src.cols));
+
+                    float luma = 0.0f;
+                    for(int x = static_cast<int>(x_start); x < static_cast<int>(std::ceil(x_end)); x++)
+                    {
+                        const float x_weight = std::min(x_end, x + 1.0f) - std::max(x_start, static_cast<float>(x));
+                        luma += x_weight * luma_sums[x];
+                    }
+
+                    dst_row[c] = cv::saturate_cast<uint8_t>(luma * normalization);
+                }
+            }
+        });
+    }
+
+//---------------------------------------------------------------------------------------------------------------------
+
+    static void downscale_luma_on_ocl(
+        const cv::UMat& src,
+        cv::UMat& dst,
+        const VideoFrame::Format src_format,
+        const cv::Size& size
+    )
+    {
+        static auto program = ocl::load_program("conversion", ocl::src::conversion_source);
+        LVK_ASSERT(!program.empty());
+
+        auto kernel = ocl::next_kernel(program, LUMA_AREA_KERNELS[src_format]);
+        LVK_ASSERT(!kernel.empty());
+
+        dst.create(size, CV_8UC1, cv::UMatUsageFlags::USAGE_ALLOCATE_DEVICE_MEMORY);
+
+        // NOTE: the kernel is run over the destination, not the source.
+        size_t global_work_size[3], local_work_size[3];
+        ocl::optimal_groups("luma_area", kernel, dst, global_work_size, local_work_size);
+
+        // Run the kernel in async mode.
+        kernel.args(
+            cv::ocl::KernelArg::ReadOnly(src),
+            cv::ocl::KernelArg::WriteOnly(dst),
+            static_cast<float>(src.cols) / static_cast<float>(size.width),
+            static_cast<float>(src.rows) / static_cast<float>(size.height)
+        );
+        ocl::launch(kernel, 2, global_work_size, local_work_size);
+    }
+
+//---------------------------------------------------------------------------------------------------------------------
+
+    void downscale_luma(const VideoFrame& src, cv::UMat& dst, const cv::Size& size)
+    {
+        LVK_ASSERT(src.has_known_format());
+        LVK_ASSERT(size.width > 0 && size.height > 0);
+        LVK_ASSERT(!src.empty());
+
+        // NOTE: planar formats already hold their luma as the frame itself.
+        const auto src_format = src.is_planar() ? VideoFrame::GRAY : src.format;
+
+        // Area averaging only applies when downscaling, otherwise resize normally.
+        if(size.width > src.cols || size.height > src.rows)
+        {
+            if(src_format == VideoFrame::GRAY)
+                cv::resize(src, dst, size, 0, 0, cv::INTER_LINEAR);
+            else
+            {
+                convert(src, dst, src_format, VideoFrame::GRAY);
+                cv::resize(dst, dst, size, 0, 0, cv::INTER_LINEAR);
+            }
+            return;
+        }
+
+        if(cv::ocl::useOpenCL())
+            downscale_luma_on_ocl(src, dst, src_format, size);
+        else
+            downscale_luma_on_cpu(src, dst, src_format, size);
+    }
+
+//---------------------------------------------------------------------------------------------------------------------
+
+    static void pack_planes(const VideoFrame& src, cv::UMat& dst)
+    {
+        thread_local cv::UMat u_buffer(cv::UMatUsageFlags::USAGE_ALLOCATE_DEVICE_MEMORY);
+        thread_local cv::UMat v_buffer(cv::UMatUsageFlags::USAGE_ALLOCATE_DEVICE_MEMORY);
+
+        dst.create(src.size(), CV_8UC3, cv::UMatUsageFlags::USAGE_ALLOCATE_DEVICE_MEMORY);
+
+        // Up-sample the chroma to 4:4:4 and pack it with the luma.
+        if(src.format == VideoFrame::NV12)
+        {
+            cv::resize(src.chroma[0], u_buffer, src.size(), 0, 0, cv::INTER_LINEAR);
+            cv::mixChannels(
+                std::vector<cv::UMat>{src, u_buffer},
+                std::vector<cv::UMat>{dst},
+                {0,0,  1,1,  2,2}
+            );
+        }
+        else
+        {
+            cv::resize(src.chroma[0], u_buffer, src.size(), 0, 0, cv::INTER_LINEAR);
+            cv::resize(src.chroma[1], v_buffer, src.size(), 0, 0, cv::INTER_LINEAR);
+            cv::merge(std::vector<cv::UMat>{src, u_buffer, v_buffer}, dst);
+        }
+    }
+
+//---------------------------------------------------------------------------------------------------------------------
+
+    static void unpack_planes(const cv::UMat& src, VideoFrame& dst, const VideoFrame::Format dst_format)
+    {
+        thread_local cv::UMat u_buffer(cv::UMatUsageFlags::USAGE_ALLOCATE_DEVICE_MEMORY);
+        thread_local cv::UMat v_buffer(cv::UMatUsageFlags::USAGE_ALLOCATE_DEVICE_MEMORY);
+
+        const cv::Size chroma_size = chroma_size_of(src.size());
+        dst.create(src.size(), CV_8UC1, cv::UMatUsageFlags::USAGE_ALLOCATE_DEVICE_MEMORY);
+
+        // Split the luma from the chroma, then sub-sample the chroma to 4:2:0.
+        if(dst_format == VideoFrame::NV12)
+        {
+            u_buffer.create(src.size(), CV_8UC2, cv::UMatUsageFlags::USAGE_ALLOCATE_DEVICE_MEMORY);
+            cv::mixChannels({src}, std::vector<cv::UMat>{dst, u_buffer}, {0,0,  1,1,  2,2});
+            cv::resize(u_buffer, dst.chroma[0], chroma_size, 0, 0, cv::INTER_AREA);
+        }
+        else
+        {
+            u_buffer.create(src.size(), CV_8UC1, cv::UMatUsageFlags::USAGE_ALLOCATE_DEVICE_MEMORY);
+            v_buffer.create(src.size(), CV_8UC1, cv::UMatUsageFlags::USAGE_ALLOCATE_DEVICE_MEMORY);
+            cv::mixChannels({src}, std::vector<cv::UMat>{dst, u_buffer, v_buffer}, {0,0,  1,1,  2,2});
+            cv::resize(u_buffer, dst.chroma[0], chroma_size, 0, 0, cv::INTER_AREA);
+            cv::resize(v_buffer, dst.chroma[1], chroma_size, 0, 0, cv::INTER_AREA);
+        }
+    }
+
+//---------------------------------------------------------------------------------------------------------------------
+
+    static void convert_planar(const VideoFrame& src, VideoFrame& dst, const VideoFrame::Format dst_format)
+    {
+        const cv::Size chroma_size = chroma_size_of(src.size());
+
+        // Both formats share the same luma, so only the chroma layout changes.
+        src.cv::UMat::copyTo(dst);
+        if(dst_format == VideoFrame::NV12)
+        {
+            dst.chroma[0].create(chroma_size, CV_8UC2, cv::UMatUsageFlags::USAGE_ALLOCATE_DEVICE_MEMORY);
+            cv::mixChannels(
+                std::vector<cv::UMat>{src.chroma[0], src.chroma[1]},
+                std::vector<cv::UMat>{dst.chroma[0]},
+                {0,0,  1,1}
+            );
+        }
+        else
+        {
+            dst.chroma[0].create(chroma_size, CV_8UC1, cv::UMatUsageFlags::USAGE_ALLOCATE_DEVICE_MEMORY);
+            dst.chroma[1].create(chroma_size, CV_8UC1, cv::UMatUsageFlags::USAGE_ALLOCATE_DEVICE_MEMORY);
+            cv::mixChannels(
+                std::vector<cv::UMat>{src.chroma[0]},
+                std::vector<cv::UMat>{dst.chroma[0], dst.chroma[1]},
+                {0,0,  1,1}
+            );
+        }
+    }
+
+//---------------------------------------------------------------------------------------------------------------------
+
+    void convert(const VideoFrame& src, VideoFrame& dst, const VideoFrame::Format dst_format)
+    {
+        LVK_ASSERT(dst_format != VideoFrame::UNKNOWN);
+        LVK_ASSERT(src.format != dst_format);
+        LVK_ASSERT(src.has_known_format());
+
+        const bool planar_src = src.is_planar();
+        const bool planar_dst = is_planar_format(dst_format);
+
+        // NOTE: Only the conversions between packed and planar formats need a
+        // packed YUV intermediate, and only if the packed format is not YUV/GRAY.
+        thread_local cv::UMat yuv_buffer(cv::UMatUsageFlags::USAGE_ALLOCATE_DEVICE_MEMORY);
+
+        if(!planar_src && !planar_dst)
+        {
+            convert(src, dst, src.format, dst_format);
+        }
+        else if(planar_src && planar_dst)
+        {
+            convert_planar(src, dst, dst_format);
+        }
+        else if(planar_src)
+        {
+            // Planar to ...
+            switch(dst_format)
+            {
+                case VideoFrame::GRAY: src.cv::UMat::copyTo(dst); break;
+                case VideoFrame::YUV: pack_planes(src, dst); break;
+                default:
+                {
+                    pack_planes(src, yuv_buffer);
+                    convert(yuv_buffer, dst, VideoFrame::YUV, dst_format);
+                    break;
+                }
+            }
+        }
+        else
+        {
+            // ... to Planar
+            switch(src.format)
+            {
+                case VideoFrame::GRAY:
+                {
+                    const cv::Size chroma_size = chroma_size_of(src.size());
+                    const int chroma_type = dst_format == VideoFrame::NV12 ? CV_8UC2 : CV_8UC1;
+
+                    src.cv::UMat::copyTo(dst);
+                    dst.chroma[0].create(chroma_size, chroma_type, cv::UMatUsageFlags::USAGE_ALLOCATE_DEVICE_MEMORY);
+                    dst.chroma[0].setTo(cv::Scalar::all(128));
+
+                    if(dst_format == VideoFrame::YUV420P)
+                    {
+                        dst.chroma[1].create(chroma_size, CV_8UC1, cv::UMatUsageFlags::USAGE_ALLOCATE_DEVICE_MEMORY);
+                        dst.chroma[1].setTo(cv::Scalar::all(128));
+                    }
+                    break;
+                }
+                case VideoFrame::YUV: unpack_planes(src, dst, dst_format); break;
+                default:
+                {
+                    convert(src, yuv_buffer, src.format, VideoFrame::YUV);
+                    unpack_planes(yuv_buffer, dst, dst_format);
+                    break;
+                }
+            }
+        }
+    }
+
+//---------------------------------------------------------------------------------------------------------------------
+
+}
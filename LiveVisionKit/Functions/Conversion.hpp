@@ -0,0 +1,45 @@
+//     *************************** LiveVisionKit ****************************
+//     Copyright (C) 2022  Sebastian Di Marco (crowsinc.dev@gmail.com)
+//
+//     This program is free software: you can redistribute it and/or modify
+//     it under the terms of the GNU General Public License as published by
+//     the Free Software Foundation, either version 3 of the License, or
+//     (at your option) any later version.
+//
+//     This program is distributed in the hope that it will be useful,
+//     but WITHOUT ANY WARRANTY; without even the implied warranty of
+//     MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//     GNU General Public License for more details.
+//
+//     You should have received a copy of the GNU General Public License
+//     along with this program.  If not, see <https://www.gnu.org/licenses/>.
+//     **********************************************************************
+
+#pragma once
+
+#include <opencv2/opencv.hpp>
+#include "Data/VideoFrame.hpp"
+
+namespace lvk
+{
+
+    // NOTE: performs the conversion in a single pass for all packed format pairs.
+    void convert(
+        const cv::UMat& src,
+        cv::UMat& dst,
+        const VideoFrame::Format src_format,
+        const VideoFrame::Format dst_format
+    );
+
+    // NOTE: planar formats are packed via YUV unless converting to/from GRAY or YUV.
+    void convert(const VideoFrame& src, VideoFrame& dst, const VideoFrame::Format dst_format);
+
+    // NOTE: converts to luma and area-downscales to the given size in a single pass, which
+    // avoids creating a full resolution GRAY frame when only a small luma frame is needed.
+    void downscale_luma(const VideoFrame& src, cv::UMat& dst, const cv::Size& size);
+
+    int channels_of(const VideoFrame::Format format);
+
+    bool is_planar_format(const VideoFrame::Format format);
+
+}
@@ -61,10 +61,12 @@ namespace lvk
         LVK_ASSERT(thickness >= 1);
         LVK_ASSERT(!dst.empty());
 
-        // Create FSR RCAS kernel
+        // Get the next drawing kernel
         static auto program = ocl::load_program("draw", ocl::src::drawing_source);
-        thread_local cv::ocl::Kernel kernel("grid", program);
-        LVK_ASSERT(!program.empty() && !kernel.empty());
+        LVK_ASSERT(!program.empty());
+
+        auto kernel = ocl::next_kernel(program, "grid");
+        LVK_ASSERT(!kernel.empty());
 
         // Find cell size of the grid
         const float cell_width = static_cast<float>(dst.cols) / static_cast<float>(grid.width);
@@ -72,7 +74,7 @@ namespace lvk
 
         // Find optimal work sizes for the 2D dst buffer.
         size_t global_work_size[3], local_work_size[3];
-        ocl::optimal_groups(dst, global_work_size, local_work_size);
+        ocl::optimal_groups("grid", kernel, dst, global_work_size, local_work_size);
 
         // Run the kernel in async mode.
         kernel.args(
@@ -84,10 +86,8 @@ namespace lvk
                 static_cast<uint8_t>(color[2]),
                 0 // NOTE: 4th component is unused
             }
-        ).run_(2, global_work_size, local_work_size, false);
-
-        // Create next kernel while the last one runs.
-        kernel.create("grid", program);
+        );
+        ocl::launch(kernel, 2, global_work_size, local_work_size);
     }
 
 //---------------------------------------------------------------------------------------------------------------------
@@ -109,10 +109,12 @@ namespace lvk
         if(points.empty())
             return;
 
-        // Create FSR RCAS kernel
+        // Get the next drawing kernel
         static auto program = ocl::load_program("draw", ocl::src::drawing_source);
-        thread_local cv::ocl::Kernel kernel("points", program);
-        LVK_ASSERT(!program.empty() && !kernel.empty());
+        LVK_ASSERT(!program.empty());
+
+        auto kernel = ocl::next_kernel(program, "points");
+        LVK_ASSERT(!kernel.empty());
 
         // Upload and scale points to 32bit int image coords.
         thread_local cv::UMat staging_buffer, points_buffer;
@@ -121,7 +123,7 @@ namespace lvk
 
         // Find optimal work sizes for the 1D points buffer.
         size_t global_work_size[3], local_work_size[3];
-        ocl::optimal_groups(points_buffer, global_work_size, local_work_size);
+        ocl::optimal_groups("points", kernel, points_buffer, global_work_size, local_work_size);
 
         // Run the kernel in async mode.
         kernel.args(
@@ -134,10 +136,8 @@ namespace lvk
                 static_cast<uint8_t>(color[2]),
                 0 // NOTE: 4th component is unused
             }
-        ).run_(1, global_work_size, local_work_size, false);
-
-        // Create next kernel while the last one runs.
-        kernel.create("points", program);
+        );
+        ocl::launch(kernel, 1, global_work_size, local_work_size);
     }
 
 //---------------------------------------------------------------------------------------------------------------------
@@ -161,10 +161,12 @@ namespace lvk
         if(points.empty())
             return;
 
-        // Create FSR RCAS kernel
+        // Get the next drawing kernel
         static auto program = ocl::load_program("draw", ocl::src::drawing_source);
-        thread_local cv::ocl::Kernel kernel("crosses", program);
-        LVK_ASSERT(!program.empty() && !kernel.empty());
+        LVK_ASSERT(!program.empty());
+
+        auto kernel = ocl::next_kernel(program, "crosses");
+        LVK_ASSERT(!kernel.empty());
 
         // Upload and scale points to 32bit int image coords.
         thread_local cv::UMat staging_buffer, points_buffer;
@@ -173,7 +175,7 @@ namespace lvk
 
         // Find optimal work sizes for the 1D points buffer.
         size_t global_work_size[3], local_work_size[3];
-        ocl::optimal_groups(points_buffer, global_work_size, local_work_size);
+        ocl::optimal_groups("crosses", kernel, points_buffer, global_work_size, local_work_size);
 
         // Run the kernel in async mode.
         kernel.args(
@@ -187,10 +189,8 @@ namespace lvk
                 static_cast<uint8_t>(color[2]),
                 0 // NOTE: 4th component is unused
             }
-        ).run_(1, global_work_size, local_work_size, false);
-
-        // Create next kernel while the last one runs.
-        kernel.create("crosses", program);
+        );
+        ocl::launch(kernel, 1, global_work_size, local_work_size);
     }
 
 //---------------------------------------------------------------------------------------------------------------------
@@ -17,12 +17,19 @@
 
 #include "Image.hpp"
 
+#include <algorithm>
+#include <cstdint>
+#include <cmath>
+#include <bit>
+
 #include "OpenCL/Kernels.hpp"
 #include "Directives.hpp"
 
 namespace lvk
 {
 
+    constexpr float FSR_NORM_FACTOR = 0.00392156862f;
+
 //---------------------------------------------------------------------------------------------------------------------
 
     void remap(const VideoFrame& src, VideoFrame& dst, const cv::UMat& offset_map, const cv::Scalar& background)
@@ -40,13 +47,9 @@ namespace lvk
         static auto program_bgr = ocl::load_program("fsr", ocl::src::fsr_source);
         LVK_ASSERT(!program_yuv.empty() && !program_bgr.empty());
 
-        // Create FSR EASU kernel
-        thread_local cv::ocl::Kernel kernel;
-        thread_local bool kernel_is_yuv = yuv;
-        if(kernel.empty() || kernel_is_yuv != yuv)
-        {
-            kernel.create("easu_remap", yuv ? program_yuv : program_bgr);
-        }
+        // Get the next FSR EASU kernel
+        auto kernel = ocl::next_kernel(yuv ? program_yuv : program_bgr, "easu_remap");
+        LVK_ASSERT(!kernel.empty());
 
         // Allocate the output based on the size of the offset map. This allows
         // an ROI of the source to be remapped and scaling operations to occur.
@@ -59,7 +62,7 @@ namespace lvk
 
         // Find optimal work sizes for the 2D dst buffer.
         size_t global_work_size[3], local_work_size[3];
-        ocl::optimal_groups(dst, global_work_size, local_work_size);
+        ocl::optimal_groups("easu_remap", kernel, dst, global_work_size, local_work_size);
 
         // Run the kernel in async mode.
         kernel.args(
@@ -73,11 +76,8 @@ namespace lvk
                 static_cast<uint8_t>(background[2]),
                 0 // NOTE: 4th component is unused
             )
-        ).run_(2, global_work_size, local_work_size, false);
-
-        // Create next kernel while the last one runs.
-        kernel.create("easu_remap", yuv ? program_yuv : program_bgr);
-        kernel_is_yuv = yuv;
+        );
+        ocl::launch(kernel, 2, global_work_size, local_work_size);
     }
 
 //---------------------------------------------------------------------------------------------------------------------
@@ -87,7 +87,8 @@ namespace lvk
         VideoFrame& dst,
         const cv::Mat& homography,
         const cv::Scalar& background,
-        const bool inverted
+        const bool inverted,
+        const cv::Size& size
     )
     {
         LVK_ASSERT(homography.cols == 3 && homography.rows == 3);
@@ -104,16 +105,12 @@ namespace lvk
         static auto program_bgr = ocl::load_program("fsr", ocl::src::fsr_source);
         LVK_ASSERT(!program_yuv.empty() && !program_bgr.empty());
 
-        // Create FSR EASU kernel
-        thread_local cv::ocl::Kernel kernel;
-        thread_local bool kernel_is_yuv = yuv;
-        if(kernel.empty() || kernel_is_yuv != yuv)
-        {
-            kernel.create("easu_remap_homography", yuv ? program_yuv : program_bgr);
-        }
+        // Get the next FSR EASU kernel
+        auto kernel = ocl::next_kernel(yuv ? program_yuv : program_bgr, "easu_remap_homography");
+        LVK_ASSERT(!kernel.empty());
 
-        // Allocate the output based on the input size.
-        dst.create(src.size(), CV_8UC3);
+        // Allocate the output based on the input size, unless another size is given.
+        dst.create(size.empty() ? src.size() : size, CV_8UC3);
 
         // We need to account for the ROI offset in the dst
         // when we create the output coordinates in the kernel.
@@ -122,7 +119,7 @@ namespace lvk
 
         // Find optimal work sizes for the 2D dst buffer.
         size_t global_work_size[3], local_work_size[3];
-        ocl::optimal_groups(dst, global_work_size, local_work_size);
+        ocl::optimal_groups("easu_remap_homography", kernel, dst, global_work_size, local_work_size);
 
         // Invert homography if it isn't already.
         cv::Mat t;
@@ -143,11 +140,8 @@ namespace lvk
                         static_cast<uint8_t>(background[2]),
                         0 // NOTE: 4th component is unused
                 )
-        ).run_(2, global_work_size, local_work_size, false);
-
-        // Create next kernel while the last one runs.
-        kernel.create("easu_remap_homography", yuv ? program_yuv : program_bgr);
-        kernel_is_yuv = yuv;
+        );
+        ocl::launch(kernel, 2, global_work_size, local_work_size);
     }
 
 //---------------------------------------------------------------------------------------------------------------------
@@ -170,20 +164,16 @@ namespace lvk
         static auto program_bgr = ocl::load_program("fsr", ocl::src::fsr_source);
         LVK_ASSERT(!program_yuv.empty() && !program_bgr.empty());
 
-        // Create FSR EASU kernel
-        thread_local cv::ocl::Kernel kernel;
-        thread_local bool kernel_is_yuv = yuv;
-        if(kernel.empty() || kernel_is_yuv != yuv)
-        {
-            kernel.create("easu_scale", yuv ? program_yuv : program_bgr);
-        }
+        // Get the next FSR EASU kernel
+        auto kernel = ocl::next_kernel(yuv ? program_yuv : program_bgr, "easu_scale");
+        LVK_ASSERT(!kernel.empty());
 
         // Allocate the output.
         dst.create(size, CV_8UC3);
 
         // Find optimal work sizes for the 2D dst buffer.
         size_t global_work_size[3], local_work_size[3];
-        ocl::optimal_groups(dst, global_work_size, local_work_size);
+        ocl::optimal_groups("easu_scale", kernel, dst, global_work_size, local_work_size);
 
         // Run the kernel in async mode.
         kernel.args(
@@ -193,11 +183,8 @@ namespace lvk
                 static_cast<float>(src.cols) / static_cast<float>(dst.cols),
                 static_cast<float>(src.rows) / static_cast<float>(dst.rows)
             }
-        ).run_(2, global_work_size, local_work_size, false);
-
-        // Create next kernel while the last one runs.
-        kernel.create("easu_scale", yuv ? program_yuv : program_bgr);
-        kernel_is_yuv = yuv;
+        );
+        ocl::launch(kernel, 2, global_work_size, local_work_size);
     }
 
 //---------------------------------------------------------------------------------------------------------------------
@@ -209,27 +196,400 @@ namespace lvk
         LVK_ASSERT_01(sharpness);
         LVK_ASSERT(!src.empty());
 
-        // Create FSR RCAS kernel
+        // Get the next FSR RCAS kernel
         static auto program = ocl::load_program("fsr", ocl::src::fsr_source);
-        thread_local cv::ocl::Kernel kernel("rcas", program);
-        LVK_ASSERT(!program.empty() && !kernel.empty());
+        LVK_ASSERT(!program.empty());
+
+        auto kernel = ocl::next_kernel(program, "rcas");
+        LVK_ASSERT(!kernel.empty());
 
         // Allocate the output.
         dst.create(src.size(), CV_8UC3);
 
         // Find optimal work sizes for the 2D dst buffer.
         size_t global_work_size[3], local_work_size[3];
-        ocl::optimal_groups(dst, global_work_size, local_work_size);
+        ocl::optimal_groups("rcas", kernel, dst, global_work_size, local_work_size);
 
         // Run the kernel in async mode.
         kernel.args(
             cv::ocl::KernelArg::ReadOnly(src),
             cv::ocl::KernelArg::WriteOnlyNoSize(dst),
             std::exp2(-2.0f * (1.0f - sharpness))
-        ).run_(2, global_work_size, local_work_size, false);
+        );
+        ocl::launch(kernel, 2, global_work_size, local_work_size);
+    }
+
+//---------------------------------------------------------------------------------------------------------------------
+
+    void upscale_sharpen(
+        const cv::UMat& src,
+        cv::UMat& dst,
+        const cv::Size& size,
+        const float sharpness,
+        const bool yuv
+    )
+    {
+        LVK_ASSERT(size.width >= src.cols && size.height >= src.rows);
+        LVK_ASSERT(src.cols > 0 && src.rows > 0);
+        LVK_ASSERT(src.type() == CV_8UC3);
+        LVK_ASSERT_01(sharpness);
+        LVK_ASSERT(!src.empty());
+
+        if(size == src.size())
+        {
+            sharpen(src, dst, sharpness);
+            return;
+        }
+
+        // FSR program has yuv and bgr versions for different luma calculations.
+        static auto program_yuv = ocl::load_program("fsr", ocl::src::fsr_source, "-D YUV_INPUT");
+        static auto program_bgr = ocl::load_program("fsr", ocl::src::fsr_source);
+        LVK_ASSERT(!program_yuv.empty() && !program_bgr.empty());
+
+        // Get the next fused FSR EASU + RCAS kernel
+        auto kernel = ocl::next_kernel(yuv ? program_yuv : program_bgr, "easu_rcas_scale");
+        LVK_ASSERT(!kernel.empty());
+
+        // Allocate the output.
+        dst.create(size, CV_8UC3);
+
+        // NOTE: the kernel shares a 16x16 tile between each 8x8 group, with each thread
+        // covering a 2x2 block of the tile, so its work sizes cannot be tuned.
+        size_t local_work_size[3] = {8, 8, 1};
+        size_t global_work_size[3] = {
+            static_cast<size_t>((dst.cols + 15) / 16) * 8,
+            static_cast<size_t>((dst.rows + 15) / 16) * 8,
+            1
+        };
+
+        // Run the kernel in async mode.
+        kernel.args(
+            cv::ocl::KernelArg::ReadOnly(src),
+            cv::ocl::KernelArg::WriteOnly(dst),
+            cv::Vec2f{
+                static_cast<float>(src.cols) / static_cast<float>(dst.cols),
+                static_cast<float>(src.rows) / static_cast<float>(dst.rows)
+            },
+            std::exp2(-2.0f * (1.0f - sharpness))
+        );
+        ocl::launch(kernel, 2, global_work_size, local_work_size);
+    }
+
+//---------------------------------------------------------------------------------------------------------------------
+
+    // NOTE: the CPU path is a port of the FSR kernels, which keeps their float
+    // approximations so that it produces the same output as the OpenCL path.
+
+    static float approx_rcp_low(const float a)
+    {
+        return std::bit_cast<float>(0x7ef07ebbu - std::bit_cast<uint32_t>(a));
+    }
+
+//---------------------------------------------------------------------------------------------------------------------
+
+    static float approx_rsq_low(const float a)
+    {
+        return std::bit_cast<float>(0x5f347d74u - (std::bit_cast<uint32_t>(a) >> 1));
+    }
+
+//---------------------------------------------------------------------------------------------------------------------
+
+    static float approx_rcp_medium(const float a)
+    {
+        const float b = std::bit_cast<float>(0x7ef19fffu - std::bit_cast<uint32_t>(a));
+        return b * (-b * a + 2.0f);
+    }
+
+//---------------------------------------------------------------------------------------------------------------------
+
+    // NOTE: upscales a single pixel of the output, as easu_scale_pixel does in the FSR kernels.
+    static void easu_pixel(
+        const cv::Mat& src,
+        const cv::Point& dst_coord,
+        const cv::Point2f& rscale,
+        const bool yuv,
+        uchar* dst
+    )
+    {
+        // Taps in the order they are accumulated by the kernel.
+        //    b c
+        //  e f g h
+        //  i j k l
+        //    n o
+        enum {B, C, I, J, F, E, K, L, H, G, N, O, TAPS};
+        constexpr int TAP_OFFSETS[TAPS][2] = {
+            {0, -1}, {1, -1}, {-1, 1}, {0, 1}, {0, 0}, {-1, 0}, {1, 1}, {2, 1}, {2, 0}, {1, 0}, {0, 2}, {1, 2}
+        };
+
+        float sub_x = static_cast<float>(dst_coord.x) * rscale.x;
+        float sub_y = static_cast<float>(dst_coord.y) * rscale.y;
+        const int src_x = static_cast<int>(sub_x), src_y = static_cast<int>(sub_y);
+        sub_x -= std::floor(sub_x);
+        sub_y -= std::floor(sub_y);
+
+        // If we are out of the src bounds, scale by nearest neighbour.
+        if(src_x == 0 || src_y == 0 || src_x >= src.cols - 4 || src_y >= src.rows - 4)
+        {
+            std::copy_n(src.ptr<uchar>(src_y, src_x), 3, dst);
+            return;
+        }
+
+        cv::Vec3f px[TAPS];
+        float luma[TAPS];
+        for(int t = 0; t < TAPS; t++)
+        {
+            const uchar* tap = src.ptr<uchar>(src_y + TAP_OFFSETS[t][1], src_x + TAP_OFFSETS[t][0]);
+            px[t] = cv::Vec3f(tap[0], tap[1], tap[2]) * FSR_NORM_FACTOR;
+
+            // NOTE: the luma matches the FSR program built for the same format.
+            luma[t] = yuv ? px[t][2] * 0.5f + (px[t][0] * 0.5f + px[t][1]) : px[t][0];
+        }
+
+        // Accumulate direction and length for bilinear interpolation.
+        float dir_x = 0.0f, dir_y = 0.0f, len = 0.0f;
+        const auto accumulate = [&](const float w, float lA, float lB, float lC, float lD, float lE){
+            const float dx = lD - lB;
+            const float len_x = std::fmax(0.0f, std::fmin(1.0f,
+                std::abs(dx) * approx_rcp_low(std::max(std::abs(lD - lC), std::abs(lC - lB)))
+            ));
+            dir_x += dx * w;
+            len += len_x * len_x * w;
+
+            const float dy = lE - lA;
+            const float len_y = std::fmax(0.0f, std::fmin(1.0f,
+                std::abs(dy) * approx_rcp_low(std::max(std::abs(lE - lC), std::abs(lC - lA)))
+            ));
+            dir_y += dy * w;
+            len += len_y * len_y * w;
+        };
+        accumulate((1.0f - sub_x) * (1.0f - sub_y), luma[B], luma[E], luma[F], luma[G], luma[J]);
+        accumulate(sub_x * (1.0f - sub_y), luma[C], luma[F], luma[G], luma[H], luma[K]);
+        accumulate((1.0f - sub_x) * sub_y, luma[F], luma[I], luma[J], luma[K], luma[N]);
+        accumulate(sub_x * sub_y, luma[G], luma[J], luma[K], luma[L], luma[O]);
+
+        // Normalize with approximation, and cleanup close to zero.
+        float dir_r = dir_x * dir_x + dir_y * dir_y;
+        const bool zero = dir_r < (1.0f / 32768.0f);
+        dir_r = zero ? 1.0f : approx_rsq_low(dir_r);
+        dir_x = (zero ? 1.0f : dir_x) * dir_r;
+        dir_y *= dir_r;
+
+        // Shape the length, then find the anisotropic stretch and the window.
+        len = len * 0.5f;
+        len *= len;
+
+        const float dir_rcp = approx_rcp_low(std::max(std::abs(dir_x), std::abs(dir_y)));
+        const float stretch = (dir_x * dir_x + dir_y * dir_y) * dir_rcp;
+        const float len_x = 1.0f + (stretch - 1.0f) * len, len_y = 1.0f + -0.5f * len;
+        const float lob = 0.5f + ((1.0f / 4.0f - 0.04f) - 0.5f) * len;
+        const float clp = approx_rcp_low(lob);
+
+        // Accumulate the lanczos weighted taps.
+        cv::Vec3f colour(0.0f, 0.0f, 0.0f);
+        float weight = 0.0f;
+        for(int t = 0; t < TAPS; t++)
+        {
+            const float off_x = static_cast<float>(TAP_OFFSETS[t][0]) - sub_x;
+            const float off_y = static_cast<float>(TAP_OFFSETS[t][1]) - sub_y;
+            const float v_x = ((off_x * dir_x) + (off_y * dir_y)) * len_x;
+            const float v_y = ((off_x * -dir_y) + (off_y * dir_x)) * len_y;
+            const float d2 = std::min(v_x * v_x + v_y * v_y, clp);
+
+            float w_a = lob * d2 - 1.0f;
+            float w_b = (2.0f / 5.0f) * d2 - 1.0f;
+            w_a *= w_a;
+            w_b = (25.0f / 16.0f) * (w_b * w_b) - (25.0f / 16.0f - 1.0f);
+
+            const float w = w_b * w_a;
+            colour += px[t] * w;
+            weight += w;
+        }
+
+        // Normalize and dering against the 4 nearest taps.
+        const float rcp_weight = 1.0f / weight;
+        for(int c = 0; c < 3; c++)
+        {
+            const float min4 = std::min(px[F][c], std::min(px[G][c], std::min(px[J][c], px[K][c])));
+            const float max4 = std::max(px[F][c], std::max(px[G][c], std::max(px[J][c], px[K][c])));
+            dst[c] = static_cast<uchar>(std::min(max4, std::max(min4, colour[c] * rcp_weight)) * 255.0f);
+        }
+    }
 
-        // Create next kernel while the last one runs.
-        kernel.create("rcas", program);
+//---------------------------------------------------------------------------------------------------------------------
+
+    // NOTE: sharpens a span of pixels in a normalized CV_32FC3 buffer, whose rows are
+    // given at the first pixel of the span. The span must not touch the buffer edges.
+    static void rcas_span(
+        const float* above,
+        const float* centre,
+        const float* below,
+        uchar* dst,
+        const int length,
+        const float sharpness
+    )
+    {
+        // NOTE: the limiters are kept away from zero to avoid dividing by zero on flat regions.
+        constexpr float MIN_LIMITER = 1e-6f;
+        constexpr float MIN_LOBE = -0.1875f;
+
+        const auto channel_lobe = [](float b, float d, float e, float f, float h){
+            const float mn4 = std::min(std::min(b, d), std::min(f, h));
+            const float mx4 = std::max(std::max(b, d), std::max(f, h));
+            const float hit_min = std::min(mn4, e) / std::max(4.0f * mx4, MIN_LIMITER);
+            const float hit_max = (1.0f - std::max(mx4, e)) / std::min(4.0f * mn4 - 4.0f, -MIN_LIMITER);
+            return std::max(-hit_min, hit_max);
+        };
+
+        int i = 0;
+#if CV_SIMD128
+        constexpr int lanes = cv::v_float32x4::nlanes;
+
+        const cv::v_float32x4 zero = cv::v_setzero_f32(), one = cv::v_setall_f32(1.0f), two = cv::v_setall_f32(2.0f);
+        const cv::v_float32x4 four = cv::v_setall_f32(4.0f), scale = cv::v_setall_f32(255.0f);
+        const cv::v_float32x4 min_limiter = cv::v_setall_f32(MIN_LIMITER), max_limiter = zero - min_limiter;
+        const cv::v_float32x4 min_lobe = cv::v_setall_f32(MIN_LOBE);
+        const cv::v_float32x4 v_sharpness = cv::v_setall_f32(sharpness);
+        const cv::v_uint32x4 rcp_magic = cv::v_setall_u32(0x7ef19fffu);
+
+        const auto v_channel_lobe = [&](
+            const cv::v_float32x4& b,
+            const cv::v_float32x4& d,
+            const cv::v_float32x4& e,
+            const cv::v_float32x4& f,
+            const cv::v_float32x4& h
+        ){
+            const cv::v_float32x4 mn4 = cv::v_min(cv::v_min(b, d), cv::v_min(f, h));
+            const cv::v_float32x4 mx4 = cv::v_max(cv::v_max(b, d), cv::v_max(f, h));
+            const cv::v_float32x4 hit_min = cv::v_min(mn4, e) / cv::v_max(four * mx4, min_limiter);
+            const cv::v_float32x4 hit_max = (one - cv::v_max(mx4, e)) / cv::v_min(four * mn4 - four, max_limiter);
+            return cv::v_max(zero - hit_min, hit_max);
+        };
+
+        for(; i + lanes <= length; i += lanes)
+        {
+            cv::v_float32x4 b[3], d[3], e[3], f[3], h[3];
+            cv::v_load_deinterleave(above + 3 * i, b[0], b[1], b[2]);
+            cv::v_load_deinterleave(centre + 3 * (i - 1), d[0], d[1], d[2]);
+            cv::v_load_deinterleave(centre + 3 * i, e[0], e[1], e[2]);
+            cv::v_load_deinterleave(centre + 3 * (i + 1), f[0], f[1], f[2]);
+            cv::v_load_deinterleave(below + 3 * i, h[0], h[1], h[2]);
+
+            cv::v_float32x4 lobe = cv::v_max(
+                v_channel_lobe(b[0], d[0], e[0], f[0], h[0]),
+                cv::v_max(
+                    v_channel_lobe(b[1], d[1], e[1], f[1], h[1]),
+                    v_channel_lobe(b[2], d[2], e[2], f[2], h[2])
+                )
+            );
+            lobe = cv::v_min(cv::v_max(lobe, min_lobe), zero) * v_sharpness;
+
+            const cv::v_float32x4 denom = cv::v_muladd(four, lobe, one);
+            const cv::v_float32x4 approx = cv::v_reinterpret_as_f32(rcp_magic - cv::v_reinterpret_as_u32(denom));
+            const cv::v_float32x4 rcp_lobe = approx * (two - approx * denom);
+
+            // NOTE: the pixels are truncated, as by convert_uchar3 in the kernels.
+            cv::v_int32x4 pixels[3];
+            for(int c = 0; c < 3; c++)
+            {
+                const cv::v_float32x4 ring = b[c] + d[c] + f[c] + h[c];
+                pixels[c] = cv::v_trunc(cv::v_muladd(ring, lobe, e[c]) * rcp_lobe * scale);
+            }
+
+            int values[3 * lanes];
+            cv::v_store_interleave(values, pixels[0], pixels[1], pixels[2]);
+            for(int k = 0; k < 3 * lanes; k++)
+                dst[3 * i + k] = cv::saturate_cast<uchar>(values[k]);
+        }
+#endif
+        for(; i < length; i++)
+        {
+            const float* b = above + 3 * i;
+            const float* d = centre + 3 * (i - 1);
+            const float* e = centre + 3 * i;
+            const float* f = centre + 3 * (i + 1);
+            const float* h = below + 3 * i;
+
+            float lobe = std::max(
+                channel_lobe(b[0], d[0], e[0], f[0], h[0]),
+                std::max(channel_lobe(b[1], d[1], e[1], f[1], h[1]), channel_lobe(b[2], d[2], e[2], f[2], h[2]))
+            );
+            lobe = std::clamp(lobe, MIN_LOBE, 0.0f) * sharpness;
+            const float rcp_lobe = approx_rcp_medium(4.0f * lobe + 1.0f);
+
+            for(int c = 0; c < 3; c++)
+            {
+                const float ring = b[c] + d[c] + f[c] + h[c];
+                dst[3 * i + c] = cv::saturate_cast<uchar>(static_cast<int>((ring * lobe + e[c]) * rcp_lobe * 255.0f));
+            }
+        }
+    }
+
+//---------------------------------------------------------------------------------------------------------------------
+
+    void upscale_sharpen(
+        const cv::UMat& src,
+        cv::UMat& dst,
+        const cv::Size& size,
+        const float sharpness,
+        const bool yuv,
+        TileProcessor& tiler
+    )
+    {
+        LVK_ASSERT(size.width >= src.cols && size.height >= src.rows);
+        LVK_ASSERT(dst.u == nullptr || dst.u != src.u);
+        LVK_ASSERT(src.cols > 0 && src.rows > 0);
+        LVK_ASSERT(src.type() == CV_8UC3);
+        LVK_ASSERT_01(sharpness);
+        LVK_ASSERT(!src.empty());
+
+        dst.create(size, CV_8UC3);
+
+        // NOTE: as in the GPU version, frames which are already at the size are only sharpened.
+        const bool upscaling = size != src.size();
+        const float rcas_sharpness = std::exp2(-2.0f * (1.0f - sharpness));
+        const cv::Point2f rscale(
+            static_cast<float>(src.cols) / static_cast<float>(size.width),
+            static_cast<float>(src.rows) / static_cast<float>(size.height)
+        );
+
+        const cv::Mat src_frame = src.getMat(cv::ACCESS_READ);
+        cv::Mat dst_frame = dst.getMat(cv::ACCESS_WRITE);
+
+        tiler.process(size, [&](const Tile& tile){
+            const cv::Rect& region = tile.region;
+
+            // Upscale the tile with a one pixel border, whose coordinates are clamped to the
+            // frame. Like the fused kernel, this gives RCAS clamped taps on the frame border.
+            thread_local cv::Mat scaled_tile, float_tile;
+            scaled_tile.create(region.height + 2, region.width + 2, CV_8UC3);
+
+            for(int r = 0; r < scaled_tile.rows; r++)
+            {
+                const int y = std::clamp(region.y + r - 1, 0, size.height - 1);
+                for(int c = 0; c < scaled_tile.cols; c++)
+                {
+                    const int x = std::clamp(region.x + c - 1, 0, size.width - 1);
+                    if(upscaling)
+                        easu_pixel(src_frame, {x, y}, rscale, yuv, scaled_tile.ptr<uchar>(r, c));
+                    else
+                        std::copy_n(src_frame.ptr<uchar>(y, x), 3, scaled_tile.ptr<uchar>(r, c));
+                }
+            }
+            scaled_tile.convertTo(float_tile, CV_32FC3, FSR_NORM_FACTOR);
+
+            // Sharpen the whole tile directly into the output.
+            for(int r = 0; r < region.height; r++)
+            {
+                rcas_span(
+                    float_tile.ptr<float>(r, 1),
+                    float_tile.ptr<float>(r + 1, 1),
+                    float_tile.ptr<float>(r + 2, 1),
+                    dst_frame.ptr<uchar>(region.y + r, region.x),
+                    region.width,
+                    rcas_sharpness
+                );
+            }
+        });
     }
 
 //---------------------------------------------------------------------------------------------------------------------
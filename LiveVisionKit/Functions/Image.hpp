@@ -19,6 +19,7 @@
 
 #include <opencv2/opencv.hpp>
 #include "Data/VideoFrame.hpp"
+#include "Filters/TileProcessor.hpp"
 
 namespace lvk
 {
@@ -28,7 +29,8 @@ namespace lvk
         VideoFrame& dst,
         const cv::Mat& homography,
         const cv::Scalar& background,
-        const bool inverted = false
+        const bool inverted = false,
+        const cv::Size& size = {}
     );
 
     void remap(const VideoFrame& src, VideoFrame& dst, const cv::UMat& offset_map, const cv::Scalar& background);
@@ -37,4 +39,26 @@ namespace lvk
 
     void sharpen(const cv::UMat& src, cv::UMat& dst, const float sharpness = 0.7f);
 
+    // NOTE: upscales and sharpens in one pass, so the upscaled frame is never written out
+    // and read back. This is equivalent to an upscale followed by a sharpen.
+    void upscale_sharpen(
+        const cv::UMat& src,
+        cv::UMat& dst,
+        const cv::Size& size,
+        const float sharpness = 0.7f,
+        const bool yuv = true
+    );
+
+    // NOTE: a CPU version which upscales each tile of the output, with a border of one
+    // pixel, into a cache-sized buffer using EASU, then sharpens it. This is a port of
+    // the OpenCL kernels, so it produces the same output as the GPU version.
+    void upscale_sharpen(
+        const cv::UMat& src,
+        cv::UMat& dst,
+        const cv::Size& size,
+        const float sharpness,
+        const bool yuv,
+        TileProcessor& tiler
+    );
+
 }
\ No newline at end of file
@@ -0,0 +1,329 @@
+//     *************************** LiveVisionKit ****************************
+//     Copyright (C) 2022  Sebastian Di Marco (crowsinc.dev@gmail.com)
+//
+//     This program is free software: you can redistribute it and/or modify
+//     it under the terms of the GNU General Public License as published by
+//     the Free Software Foundation, either version 3 of the License, or
+//     (at your option) any later version.
+//
+//     This program is distributed in the hope that it will be useful,
+//     but WITHOUT ANY WARRANTY; without even the implied warranty of
+//     MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//     GNU General Public License for more details.
+//
+//     You should have received a copy of the GNU General Public License
+//     along with this program.  If not, see <https://www.gnu.org/licenses/>.
+//     **********************************************************************
+
+#include "Execution.hpp"
+
+#include <opencv2/core/opencl/runtime/opencl_core.hpp>
+
+#include "Directives.hpp"
+
+namespace lvk::ocl
+{
+
+//---------------------------------------------------------------------------------------------------------------------
+
+    Event::Event(void* handle)
+        : m_Handle(handle)
+    {}
+
+//---------------------------------------------------------------------------------------------------------------------
+
+    Event::Event(const Event& other)
+        : m_Handle(other.m_Handle)
+    {
+        if(m_Handle != nullptr)
+            clRetainEvent(static_cast<cl_event>(m_Handle));
+    }
+
+//---------------------------------------------------------------------------------------------------------------------
+
+    Event::Event(Event&& other) noexcept
+        : m_Handle(other.m_Handle)
+    {
+        other.m_Handle = nullptr;
+    }
+
+//---------------------------------------------------------------------------------------------------------------------
+
+    Event::~Event()
+    {
+        release();
+    }
+
+//---------------------------------------------------------------------------------------------------------------------
+
+    Event& Event::operator=(const Event& other)
+    {
+        if(this != &other)
+        {
+            release();
+            m_Handle = other.m_Handle;
+            if(m_Handle != nullptr)
+                clRetainEvent(static_cast<cl_event>(m_Handle));
+        }
+        return *this;
+    }
+
+//---------------------------------------------------------------------------------------------------------------------
+
+    Event& Event::operator=(Event&& other) noexcept
+    {
+        if(this != &other)
+        {
+            release();
+            m_Handle = other.m_Handle;
+            other.m_Handle = nullptr;
+        }
+        return *this;
+    }
+
+//---------------------------------------------------------------------------------------------------------------------
+
+    Event Event::Marker(const cv::ocl::Queue& queue)
+    {
+        auto handle = static_cast<cl_command_queue>(queue.ptr());
+        if(handle == nullptr)
+            return {};
+
+        cl_event event = nullptr;
+        if(clEnqueueMarkerWithWaitList(handle, 0, nullptr, &event) != CL_SUCCESS)
+            return {};
+
+        return Event(event);
+    }
+
+//---------------------------------------------------------------------------------------------------------------------
+
+    bool Event::empty() const
+    {
+        return m_Handle == nullptr;
+    }
+
+//---------------------------------------------------------------------------------------------------------------------
+
+    bool Event::is_complete() const
+    {
+        if(empty()) return true;
+
+        cl_int status = CL_COMPLETE;
+        clGetEventInfo(
+            static_cast<cl_event>(m_Handle),
+            CL_EVENT_COMMAND_EXECUTION_STATUS,
+            sizeof(status), &status, nullptr
+        );
+
+        // NOTE: errors are negative, so failed commands are also considered complete.
+        return status <= CL_COMPLETE;
+    }
+
+//---------------------------------------------------------------------------------------------------------------------
+
+    void Event::wait() const
+    {
+        if(empty()) return;
+
+        auto event = static_cast<cl_event>(m_Handle);
+        clWaitForEvents(1, &event);
+    }
+
+//---------------------------------------------------------------------------------------------------------------------
+
+    void* Event::ptr() const
+    {
+        return m_Handle;
+    }
+
+//---------------------------------------------------------------------------------------------------------------------
+
+    void Event::release()
+    {
+        if(m_Handle != nullptr)
+        {
+            clReleaseEvent(static_cast<cl_event>(m_Handle));
+            m_Handle = nullptr;
+        }
+    }
+
+//---------------------------------------------------------------------------------------------------------------------
+
+    ExecutionContext::Scope::Scope(ExecutionContext& context, const Role role)
+    {
+        if(!cv::ocl::useOpenCL())
+            return;
+
+        auto& default_queue = cv::ocl::Queue::getDefault();
+        auto& role_queue = context.queue(role);
+
+        if(role_queue.ptr() != nullptr && role_queue.ptr() != default_queue.ptr())
+        {
+            m_PreviousQueue = default_queue;
+            default_queue = role_queue;
+            m_Active = true;
+        }
+    }
+
+//---------------------------------------------------------------------------------------------------------------------
+
+    ExecutionContext::Scope::~Scope()
+    {
+        if(m_Active)
+        {
+            // Submit the scoped work so that other queues can depend on it.
+            clFlush(static_cast<cl_command_queue>(cv::ocl::Queue::getDefault().ptr()));
+            cv::ocl::Queue::getDefault() = m_PreviousQueue;
+        }
+    }
+
+//---------------------------------------------------------------------------------------------------------------------
+
+    ExecutionContext& ExecutionContext::Default()
+    {
+        thread_local ExecutionContext context(IsOverlapping());
+        return context;
+    }
+
+//---------------------------------------------------------------------------------------------------------------------
+
+    void ExecutionContext::SetOverlapping(const bool enabled)
+    {
+        s_Overlapping = enabled;
+    }
+
+//---------------------------------------------------------------------------------------------------------------------
+
+    bool ExecutionContext::IsOverlapping()
+    {
+        return s_Overlapping;
+    }
+
+//---------------------------------------------------------------------------------------------------------------------
+
+    ExecutionContext::ExecutionContext(const bool overlapped)
+        : m_Overlapped(overlapped)
+    {
+        if(cv::ocl::useOpenCL())
+            m_Queues[COMPUTE] = cv::ocl::Queue::getDefault();
+    }
+
+//---------------------------------------------------------------------------------------------------------------------
+
+    cv::ocl::Queue& ExecutionContext::queue(const Role role)
+    {
+        LVK_ASSERT_RANGE(role, COMPUTE, TRACKING);
+
+        if(!m_Overlapped || role == COMPUTE)
+            return m_Queues[COMPUTE];
+
+        // Create the queue on first use, falling back to the compute queue on failure.
+        auto& queue = m_Queues[role];
+        if(queue.ptr() == nullptr && cv::ocl::useOpenCL())
+        {
+            if(!queue.create(cv::ocl::Context::getDefault(), cv::ocl::Device::getDefault()))
+                queue = m_Queues[COMPUTE];
+        }
+
+        return queue;
+    }
+
+//---------------------------------------------------------------------------------------------------------------------
+
+    Event ExecutionContext::record(const Role role)
+    {
+        // All roles share the compute queue, so there is nothing to order.
+        if(!m_Overlapped)
+            return {};
+
+        auto& role_queue = queue(role);
+
+        Event event = Event::Marker(role_queue);
+        if(event.empty())
+            return {};
+
+        // The marker must be submitted before another queue can safely wait on it.
+        clFlush(static_cast<cl_command_queue>(role_queue.ptr()));
+
+        return event;
+    }
+
+//---------------------------------------------------------------------------------------------------------------------
+
+    void ExecutionContext::wait(const Role role, const Event& event)
+    {
+        if(!m_Overlapped)
+            return;
+
+        auto handle = static_cast<cl_command_queue>(queue(role).ptr());
+        if(handle == nullptr || event.empty())
+            return;
+
+        auto event_handle = static_cast<cl_event>(event.ptr());
+
+        // In-order queues already wait on their own events.
+        cl_command_queue event_queue = nullptr;
+        clGetEventInfo(event_handle, CL_EVENT_COMMAND_QUEUE, sizeof(event_queue), &event_queue, nullptr);
+        if(event_queue == handle)
+            return;
+
+        clEnqueueBarrierWithWaitList(handle, 1, &event_handle, nullptr);
+    }
+
+//---------------------------------------------------------------------------------------------------------------------
+
+    void ExecutionContext::flush(const Role role)
+    {
+        if(auto handle = static_cast<cl_command_queue>(queue(role).ptr()); handle != nullptr)
+            clFlush(handle);
+    }
+
+//---------------------------------------------------------------------------------------------------------------------
+
+    void ExecutionContext::synchronize()
+    {
+        for(auto& queue : m_Queues)
+            if(queue.ptr() != nullptr)
+                queue.finish();
+    }
+
+//---------------------------------------------------------------------------------------------------------------------
+
+    bool ExecutionContext::is_overlapped() const
+    {
+        return m_Overlapped;
+    }
+
+//---------------------------------------------------------------------------------------------------------------------
+
+    void ExecutionContext::enable_profiling()
+    {
+        auto& compute_queue = m_Queues[COMPUTE];
+        if(m_Profiled || compute_queue.ptr() == nullptr)
+            return;
+
+        const cv::ocl::Queue profiling_queue = compute_queue.getProfilingQueue();
+        if(profiling_queue.ptr() == nullptr)
+            return;
+
+        compute_queue.finish();
+
+        auto& default_queue = cv::ocl::Queue::getDefault();
+        if(default_queue.ptr() == compute_queue.ptr())
+            default_queue = profiling_queue;
+
+        compute_queue = profiling_queue;
+        m_Profiled = true;
+    }
+
+//---------------------------------------------------------------------------------------------------------------------
+
+    bool ExecutionContext::is_profiled() const
+    {
+        return m_Profiled;
+    }
+
+//---------------------------------------------------------------------------------------------------------------------
+
+}
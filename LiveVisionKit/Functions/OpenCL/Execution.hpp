@@ -0,0 +1,150 @@
+//     *************************** LiveVisionKit ****************************
+//     Copyright (C) 2022  Sebastian Di Marco (crowsinc.dev@gmail.com)
+//
+//     This program is free software: you can redistribute it and/or modify
+//     it under the terms of the GNU General Public License as published by
+//     the Free Software Foundation, either version 3 of the License, or
+//     (at your option) any later version.
+//
+//     This program is distributed in the hope that it will be useful,
+//     but WITHOUT ANY WARRANTY; without even the implied warranty of
+//     MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//     GNU General Public License for more details.
+//
+//     You should have received a copy of the GNU General Public License
+//     along with this program.  If not, see <https://www.gnu.org/licenses/>.
+//     **********************************************************************
+
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <opencv2/core/ocl.hpp>
+
+namespace lvk::ocl
+{
+
+    // NOTE: Ref-counted handle to an OpenCL event, which is empty if OpenCL is unavailable.
+    class Event
+    {
+    public:
+
+        Event() = default;
+
+        Event(const Event& other);
+
+        Event(Event&& other) noexcept;
+
+        ~Event();
+
+        Event& operator=(const Event& other);
+
+        Event& operator=(Event&& other) noexcept;
+
+        // Enqueues a marker which completes once all prior work on the queue completes.
+        static Event Marker(const cv::ocl::Queue& queue);
+
+        bool empty() const;
+
+        bool is_complete() const;
+
+        void wait() const;
+
+        void* ptr() const;
+
+    private:
+
+        friend class ExecutionContext;
+
+        explicit Event(void* handle);
+
+        void release();
+
+    private:
+        void* m_Handle = nullptr;
+    };
+
+
+    // NOTE: Owns an in-order OpenCL queue for each role of work, so that independent
+    // transfers, computations and tracking do not serialise on one queue. The compute
+    // queue is the default queue of the thread which created the context, while the
+    // other queues are only created on first use. Dependencies between the queues
+    // must be made explicit by recording an event on one queue and waiting on it
+    // in another. Each thread has its own default context, mirroring OpenCV.
+    //
+    // NOTE: Overlapping is disabled by default, so that all roles share the compute
+    // queue, as the cross-queue event ordering has not yet been validated on all
+    // OpenCL runtimes (notably PoCL). It must be opted into via SetOverlapping
+    // before the default contexts are first used, or via the constructor. Without
+    // overlapping, record returns an empty event and wait does nothing, so that
+    // the context adds no markers, flushes or queries to the submitted work.
+    class ExecutionContext
+    {
+    public:
+
+        enum Role
+        {
+            COMPUTE = 0,
+            TRANSFER,
+            TRACKING
+        };
+
+        // Makes a queue the default OpenCV queue of the calling thread for its lifetime.
+        class Scope
+        {
+        public:
+
+            Scope(ExecutionContext& context, const Role role);
+
+            Scope(const Scope& other) = delete;
+
+            ~Scope();
+
+        private:
+            cv::ocl::Queue m_PreviousQueue;
+            bool m_Active = false;
+        };
+
+    public:
+
+        static ExecutionContext& Default();
+
+        // Sets whether default contexts, which are created on first use, are overlapped.
+        static void SetOverlapping(const bool enabled);
+
+        static bool IsOverlapping();
+
+        explicit ExecutionContext(const bool overlapped = false);
+
+        ExecutionContext(const ExecutionContext& other) = delete;
+
+        cv::ocl::Queue& queue(const Role role);
+
+        // Enqueues an event which completes once all prior work on the queue completes.
+        Event record(const Role role);
+
+        // Stops all further work on the queue from starting before the event completes.
+        void wait(const Role role, const Event& event);
+
+        void flush(const Role role);
+
+        void synchronize();
+
+        bool is_overlapped() const;
+
+        // NOTE: moves the compute queue onto a profiling-enabled queue, which also becomes the
+        // default queue of the calling thread if the compute queue was. Prior work is finished
+        // first, so that it stays ordered before later work. Profiling remains enabled after.
+        void enable_profiling();
+
+        bool is_profiled() const;
+
+    private:
+        inline static std::atomic_bool s_Overlapping = false;
+
+        std::array<cv::ocl::Queue, 3> m_Queues;
+        bool m_Overlapped = false;
+        bool m_Profiled = false;
+    };
+
+}
@@ -17,32 +17,309 @@
 
 #include "Kernels.hpp"
 
+#include <unordered_map>
+#include <algorithm>
+#include <fstream>
+#include <deque>
+#include <mutex>
+#include <opencv2/core/opencl/runtime/opencl_core.hpp>
+
+#include "Tuning.hpp"
+#include "Execution.hpp"
 #include "Directives.hpp"
 
 namespace lvk::ocl
 {
 
+    constexpr uint64_t FNV_OFFSET_BASIS = 14695981039346656037ull;
+    constexpr uint64_t FNV_PRIME = 1099511628211ull;
+
+    struct RegistryEntry
+    {
+        cv::ocl::Program program;
+        std::vector<char> binary; // NOTE: Binary sources must outlive their programs.
+    };
+
+    // NOTE: a ring only grows while all of its kernels are in flight, which is a handful
+    // at most, so this limit is only reached if the launches never complete.
+    constexpr size_t MAX_KERNEL_RING_SIZE = 8;
+
+    struct KernelSlot
+    {
+        cv::ocl::Kernel kernel;
+        Event completion; // Completes after the last launch of the kernel.
+    };
+
+    struct KernelRing
+    {
+        const void* program = nullptr;
+        std::string kernel_name;
+        std::deque<KernelSlot> slots; // NOTE: a deque keeps the slots in place as it grows.
+    };
+
+    static std::mutex s_RegistryMutex;
+    static std::unordered_map<uint64_t, RegistryEntry> s_ProgramRegistry;
+    static thread_local KernelSlot* s_LaunchSlot = nullptr;
+    static thread_local size_t s_FailedLaunches = 0;
+    static std::filesystem::path s_ProgramCache = [](){
+        std::error_code error;
+        const auto temp_directory = std::filesystem::temp_directory_path(error);
+        return error ? std::filesystem::path() : temp_directory / "LiveVisionKit" / "OpenCL";
+    }();
+
 //---------------------------------------------------------------------------------------------------------------------
 
-cv::ocl::Program load_program(const char* name, const char* source, const char* flags)
-{
-    cv::String compilation_log;
-
-    cv::ocl::ProgramSource program_source(name, name, source, "");
-    cv::ocl::Program program(program_source, flags, compilation_log);
-    if(program.ptr() == nullptr)
-    {
-        // Perform custom assert with compilation error log.
-        lvk::context::assert_handler(
-            LVK_FILE,
-            __func__,
-            std::string("Failed to compile OpenCL program \'")
-                + name + "\' with compilation log: \n\n" + compilation_log
+    static uint64_t hash_of(const std::string& data, uint64_t hash = FNV_OFFSET_BASIS)
+    {
+        // FNV-1a, which is stable across platforms and runs unlike std::hash.
+        for(const char c : data)
+        {
+            hash ^= static_cast<uint8_t>(c);
+            hash *= FNV_PRIME;
+        }
+        return hash;
+    }
+
+//---------------------------------------------------------------------------------------------------------------------
+
+    static cv::ocl::Program compile_program(const char* name, const char* source, const char* flags)
+    {
+        cv::String compilation_log;
+
+        cv::ocl::ProgramSource program_source(name, name, source, "");
+        cv::ocl::Program program(program_source, flags, compilation_log);
+        if(program.ptr() == nullptr)
+        {
+            // Perform custom assert with compilation error log.
+            lvk::context::assert_handler(
+                LVK_FILE,
+                __func__,
+                std::string("Failed to compile OpenCL program \'")
+                    + name + "\' with compilation log: \n\n" + compilation_log
+            );
+            return {};
+        }
+        return program;
+    }
+
+//---------------------------------------------------------------------------------------------------------------------
+
+    static cv::ocl::Program load_binary(
+        const char* name,
+        const char* flags,
+        const std::filesystem::path& file,
+        std::vector<char>& binary
+    )
+    {
+        std::ifstream stream(file, std::ios::binary);
+        if(!stream.is_open())
+            return {};
+
+        binary.assign(std::istreambuf_iterator<char>(stream), std::istreambuf_iterator<char>());
+        if(binary.empty())
+            return {};
+
+        // NOTE: A stale or corrupted binary is simply rejected by the driver,
+        // in which case the program is re-compiled and the cache is updated.
+        cv::String build_log;
+        const auto program_source = cv::ocl::ProgramSource::fromBinary(
+            name, name, reinterpret_cast<const unsigned char*>(binary.data()), binary.size(), flags
         );
-        return {};
-    };
-    return std::move(program);
-}
+
+        cv::ocl::Program program(program_source, flags, build_log);
+        if(program.ptr() == nullptr)
+            binary.clear();
+
+        return program;
+    }
+
+//---------------------------------------------------------------------------------------------------------------------
+
+    static void store_binary(const cv::ocl::Program& program, const std::filesystem::path& file)
+    {
+        std::vector<char> binary;
+        program.getBinary(binary);
+        if(binary.empty())
+            return;
+
+        std::error_code error;
+        std::filesystem::create_directories(file.parent_path(), error);
+        if(error) return;
+
+        // Write to a temporary file first, so other processes never see a partial binary.
+        auto temp_file = file;
+        temp_file += ".tmp";
+        {
+            std::ofstream stream(temp_file, std::ios::binary | std::ios::trunc);
+            if(!stream.is_open())
+                return;
+
+            stream.write(binary.data(), static_cast<std::streamsize>(binary.size()));
+            if(!stream.good())
+                return;
+        }
+        std::filesystem::rename(temp_file, file, error);
+    }
+
+//---------------------------------------------------------------------------------------------------------------------
+
+    cv::ocl::Program load_program(const char* name, const char* source, const char* flags)
+    {
+        // NOTE: The source hash identifies the program across runs, while the
+        // registry key additionally identifies the context it was compiled in.
+        const uint64_t source_hash = hash_of(flags, hash_of(source));
+        const uint64_t binary_hash = hash_of(std::to_string(device_signature()), source_hash);
+        const uint64_t program_key = hash_of(
+            std::to_string(reinterpret_cast<uintptr_t>(cv::ocl::Context::getDefault().ptr())),
+            source_hash
+        );
+
+        std::lock_guard<std::mutex> registry_lock(s_RegistryMutex);
+
+        if(const auto entry = s_ProgramRegistry.find(program_key); entry != s_ProgramRegistry.end())
+            return entry->second.program;
+
+        RegistryEntry entry;
+        std::filesystem::path cache_file;
+        if(!s_ProgramCache.empty())
+        {
+            cache_file = s_ProgramCache / cv::format("%s-%016llx.bin", name, static_cast<unsigned long long>(binary_hash));
+            entry.program = load_binary(name, flags, cache_file, entry.binary);
+        }
+
+        if(entry.program.ptr() == nullptr)
+        {
+            entry.program = compile_program(name, source, flags);
+            if(entry.program.ptr() == nullptr)
+                return {};
+
+            if(!cache_file.empty())
+                store_binary(entry.program, cache_file);
+        }
+
+        return s_ProgramRegistry.emplace(program_key, std::move(entry)).first->second.program;
+    }
+
+//---------------------------------------------------------------------------------------------------------------------
+
+    void set_program_cache(const std::filesystem::path& directory)
+    {
+        std::lock_guard<std::mutex> registry_lock(s_RegistryMutex);
+        s_ProgramCache = directory;
+    }
+
+//---------------------------------------------------------------------------------------------------------------------
+
+    const std::filesystem::path& program_cache()
+    {
+        return s_ProgramCache;
+    }
+
+//---------------------------------------------------------------------------------------------------------------------
+
+    void warmup()
+    {
+        if(!cv::ocl::useOpenCL())
+            return;
+
+        load_program("fsr", src::fsr_source);
+        load_program("fsr", src::fsr_source, "-D YUV_INPUT");
+        load_program("draw", src::drawing_source);
+        load_program("conversion", src::conversion_source);
+    }
+
+//---------------------------------------------------------------------------------------------------------------------
+
+    cv::ocl::Kernel next_kernel(const cv::ocl::Program& program, const char* kernel_name)
+    {
+        thread_local std::deque<KernelRing> kernel_rings;
+
+        // NOTE: there are only a few rings per thread, so a linear search is cheaper than hashing.
+        auto ring = std::find_if(kernel_rings.begin(), kernel_rings.end(), [&](const KernelRing& candidate){
+            return candidate.program == program.ptr() && candidate.kernel_name == kernel_name;
+        });
+        if(ring == kernel_rings.end())
+            ring = kernel_rings.insert(kernel_rings.end(), KernelRing{program.ptr(), kernel_name, {}});
+
+        // Find a free slot, settling any slots whose last launch has since completed.
+        // NOTE: OpenCV releases a kernel from its launch in a completion callback, which may
+        // still be running when the launch is first seen to complete. So settled slots are
+        // only reused from the next call onwards, by which point the callback has run.
+        KernelSlot* free_slot = nullptr;
+        for(auto& slot : ring->slots)
+        {
+            if(slot.completion.empty())
+            {
+                if(free_slot == nullptr)
+                    free_slot = &slot;
+            }
+            else if(slot.completion.is_complete())
+                slot.completion = {};
+        }
+
+        if(free_slot == nullptr)
+        {
+            // Every kernel is still in flight, so submit their launches so that they can
+            // complete, and create another kernel for the ring unless it is already full.
+            clFlush(static_cast<cl_command_queue>(cv::ocl::Queue::getDefault().ptr()));
+
+            cv::ocl::Kernel kernel(kernel_name, program);
+            if(kernel.empty() || ring->slots.size() >= MAX_KERNEL_RING_SIZE)
+                return kernel;
+
+            free_slot = &ring->slots.emplace_back(KernelSlot{std::move(kernel), {}});
+        }
+        else if(free_slot->kernel.empty())
+            free_slot->kernel.create(kernel_name, program);
+
+        s_LaunchSlot = free_slot;
+        return free_slot->kernel;
+    }
+
+//---------------------------------------------------------------------------------------------------------------------
+
+    bool launch(cv::ocl::Kernel& kernel, const int dims, size_t global_groups[3], size_t local_groups[3])
+    {
+        auto& queue = cv::ocl::Queue::getDefault();
+        if(!kernel.run_(dims, global_groups, local_groups, false, queue))
+        {
+            // NOTE: only candidate groups which are being tuned are allowed to fail, as they are discarded.
+            s_FailedLaunches++;
+            s_LaunchSlot = nullptr;
+            LVK_ASSERT(is_tuning() && "Kernel failed to launch");
+            return false;
+        }
+
+        // Mark when the launch completes, so that a ring kernel is only reused afterwards.
+        // If the marker fails, the slot is given a new kernel instead of reusing this one.
+        if(s_LaunchSlot != nullptr && s_LaunchSlot->kernel.ptr() == kernel.ptr())
+        {
+            s_LaunchSlot->completion = Event::Marker(queue);
+            if(s_LaunchSlot->completion.empty())
+                s_LaunchSlot->kernel = cv::ocl::Kernel();
+        }
+        s_LaunchSlot = nullptr;
+
+        return true;
+    }
+
+//---------------------------------------------------------------------------------------------------------------------
+
+    size_t failed_launches()
+    {
+        return s_FailedLaunches;
+    }
+
+//---------------------------------------------------------------------------------------------------------------------
+
+    uint64_t device_signature()
+    {
+        const auto& device = cv::ocl::Device::getDefault();
+        return hash_of(
+            device.driverVersion(),
+            hash_of(device.version(), hash_of(device.vendorName(), hash_of(device.name())))
+        );
+    }
 
 //---------------------------------------------------------------------------------------------------------------------
 
@@ -72,4 +349,48 @@ cv::ocl::Program load_program(const char* name, const char* source, const char*
 
 //---------------------------------------------------------------------------------------------------------------------
 
-}
\ No newline at end of file
+    void optimal_groups(
+        const char* kernel_name,
+        const cv::ocl::Kernel& kernel,
+        const cv::UMat& buffer,
+        size_t global_groups[3],
+        size_t local_groups[3]
+    )
+    {
+        optimal_groups(buffer, global_groups, local_groups);
+
+        const bool is_1d = buffer.dims == 1 || buffer.cols == 1;
+        const int dimensions = is_1d ? 1 : 2;
+        const size_t extent[2] = {
+            static_cast<size_t>(is_1d ? buffer.rows : buffer.cols),
+            static_cast<size_t>(buffer.rows)
+        };
+
+        // NOTE: the kernel may support smaller groups than the device, e.g. if it uses many registers.
+        size_t max_group_size = cv::ocl::Device::getDefault().maxWorkGroupSize();
+        if(const size_t kernel_group_size = kernel.workGroupSize(); kernel_group_size > 0)
+            max_group_size = std::min(max_group_size, kernel_group_size);
+
+        size_t tuned_groups[3];
+        if(find_tuned_groups(kernel_name, dimensions, tuned_groups, max_group_size))
+        {
+            for(int d = 0; d < dimensions; d++)
+                local_groups[d] = tuned_groups[d];
+        }
+        else
+        {
+            // Shrink the default groups until they fit within the kernel's limit.
+            while(local_groups[0] * local_groups[1] > max_group_size && local_groups[0] * local_groups[1] > 1)
+            {
+                const int d = local_groups[0] >= local_groups[1] ? 0 : 1;
+                local_groups[d] /= 2;
+            }
+        }
+
+        for(int d = 0; d < dimensions; d++)
+            global_groups[d] = ((extent[d] + local_groups[d] - 1) / local_groups[d]) * local_groups[d];
+    }
+
+//---------------------------------------------------------------------------------------------------------------------
+
+}
@@ -18,16 +18,55 @@
 #pragma once
 
 #include <vector>
+#include <filesystem>
 #include <opencv2/opencv.hpp>
 #include <opencv2/core/ocl.hpp>
 
 namespace lvk::ocl
 {
 
+    // NOTE: Programs are compiled once per (source, flags) pair in each context and
+    // shared between all callers. Compiled binaries are also persisted in the program
+    // cache directory, keyed by the device, driver and source hash, so that they do
+    // not have to be re-compiled on the next run. An empty cache directory disables this.
     cv::ocl::Program load_program(const char* name, const char* source, const char* flags = "");
 
+    void set_program_cache(const std::filesystem::path& directory);
+
+    const std::filesystem::path& program_cache();
+
+    // Loads all LVK programs ahead of time, to avoid stalling on the first frame.
+    void warmup();
+
+    // NOTE: OpenCV does not allow a kernel to be launched again until its last async
+    // launch has completed. Each thread keeps a ring of kernels per program and kernel
+    // name, and hands out a kernel whose last launch has completed, so that kernels are
+    // only created while all of the ring is still in flight. Kernels from the ring must
+    // be launched with launch(), which tracks when each launch completes.
+    cv::ocl::Kernel next_kernel(const cv::ocl::Program& program, const char* kernel_name);
+
+    // Launches the kernel asynchronously on the default queue, returning false if it failed.
+    // Failed launches are asserted against, unless they are of groups that are being tuned.
+    bool launch(cv::ocl::Kernel& kernel, const int dims, size_t global_groups[3], size_t local_groups[3]);
+
+    // The number of failed launches on the calling thread.
+    size_t failed_launches();
+
+    // Uniquely identifies the default device and its driver.
+    uint64_t device_signature();
+
     void optimal_groups(const cv::UMat& buffer, size_t global_groups[3], size_t local_groups[3]);
 
+    // Uses the auto-tuned local groups of the kernel on this device, if they exist and fit within the
+    // work group limit of the given kernel instance. Otherwise the default groups are fit to the limit.
+    void optimal_groups(
+        const char* kernel_name,
+        const cv::ocl::Kernel& kernel,
+        const cv::UMat& buffer,
+        size_t global_groups[3],
+        size_t local_groups[3]
+    );
+
     // OpenCL Kernel Sources
     namespace src
     {
@@ -38,5 +77,9 @@ namespace lvk::ocl
         inline const char* drawing_source =
             #include "Sources/Drawing.cl"
 ;
+
+        inline const char* conversion_source =
+            #include "Sources/Conversion.cl"
+;
     }
 }
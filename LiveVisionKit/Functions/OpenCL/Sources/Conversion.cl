@@ -0,0 +1,177 @@
+R"(
+//     *************************** LiveVisionKit ****************************
+//     Copyright (C) 2022  Sebastian Di Marco (crowsinc.dev@gmail.com)
+//
+//     This program is free software: you can redistribute it and/or modify
+//     it under the terms of the GNU General Public License as published by
+//     the Free Software Foundation, either version 3 of the License, or
+//     (at your option) any later version.
+//
+//     This program is distributed in the hope that it will be useful,
+//     but WITHOUT ANY WARRANTY; without even the implied warranty of
+//     MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//     GNU General Public License for more details.
+//
+//     You should have received a copy of the GNU General Public License
+//     along with this program.  If not, see <https://www.gnu.org/licenses/>.
+//     **********************************************************************
+
+// NOTE: YUV uses the same analog coefficients as cv::COLOR_BGR2YUV so that
+// the results match those of the OpenCV conversions which this replaces.
+
+float3 rgb_to_yuv(const float3 rgb)
+{
+    const float y = dot(rgb, (float3)(0.299f, 0.587f, 0.114f));
+    return (float3)(y, (rgb.z - y) * 0.492f + 128.0f, (rgb.x - y) * 0.877f + 128.0f);
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+
+float3 yuv_to_rgb(const float3 yuv)
+{
+    const float u = yuv.y - 128.0f, v = yuv.z - 128.0f;
+    return (float3)(yuv.x + 1.140f * v, yuv.x - 0.395f * u - 0.581f * v, yuv.x + 2.032f * u);
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+
+float3 rgb_to_rgb(const float3 rgb) { return rgb; }
+
+float3 yuv_to_yuv(const float3 yuv) { return yuv; }
+
+//----------------------------------------------------------------------------------------------------------------------
+
+// NOTE: Each format is read into either the RGB or YUV space. GRAY is read as
+// YUV with neutral chroma so that GRAY <-> YUV conversions are exact copies.
+
+float3 read_bgr(__global const uchar* src) { return convert_float3(vload3(0, src)).zyx; }
+
+float3 read_rgb(__global const uchar* src) { return convert_float3(vload3(0, src)); }
+
+float3 read_bgra(__global const uchar* src) { return convert_float4(vload4(0, src)).zyx; }
+
+float3 read_rgba(__global const uchar* src) { return convert_float4(vload4(0, src)).xyz; }
+
+float3 read_yuv(__global const uchar* src) { return convert_float3(vload3(0, src)); }
+
+float3 read_gray(__global const uchar* src) { return (float3)(convert_float(src[0]), 128.0f, 128.0f); }
+
+//----------------------------------------------------------------------------------------------------------------------
+
+void write_bgr(const float3 rgb, __global uchar* dst) { vstore3(convert_uchar3_sat_rte(rgb.zyx), 0, dst); }
+
+void write_rgb(const float3 rgb, __global uchar* dst) { vstore3(convert_uchar3_sat_rte(rgb), 0, dst); }
+
+void write_bgra(const float3 rgb, __global uchar* dst) { vstore4((uchar4)(convert_uchar3_sat_rte(rgb.zyx), 255), 0, dst); }
+
+void write_rgba(const float3 rgb, __global uchar* dst) { vstore4((uchar4)(convert_uchar3_sat_rte(rgb), 255), 0, dst); }
+
+void write_yuv(const float3 yuv, __global uchar* dst) { vstore3(convert_uchar3_sat_rte(yuv), 0, dst); }
+
+void write_gray(const float3 yuv, __global uchar* dst) { dst[0] = convert_uchar_sat_rte(yuv.x); }
+
+//----------------------------------------------------------------------------------------------------------------------
+
+// Generates a single-pass kernel named SRC_to_DST for the given format pair.
+#define CONVERSION(SRC, SRC_SPACE, SRC_CHANNELS, DST, DST_SPACE, DST_CHANNELS)                              \
+__kernel void SRC##_to_##DST(                                                                               \
+    __global const uchar* src, int src_step, int src_offset, int src_rows, int src_cols,                    \
+    __global uchar* dst, int dst_step, int dst_offset                                                       \
+)                                                                                                           \
+{                                                                                                           \
+    const int2 coord = (int2)(get_global_id(0), get_global_id(1));                                          \
+    if(coord.x >= src_cols || coord.y >= src_rows) return;                                                  \
+                                                                                                            \
+    const int src_index = mad24(coord.y, src_step, mad24(coord.x, SRC_CHANNELS, src_offset));               \
+    const int dst_index = mad24(coord.y, dst_step, mad24(coord.x, DST_CHANNELS, dst_offset));               \
+                                                                                                            \
+    write_##DST(SRC_SPACE##_to_##DST_SPACE(read_##SRC(src + src_index)), dst + dst_index);                  \
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+
+CONVERSION(bgr, rgb, 3, bgra, rgb, 4)
+CONVERSION(bgr, rgb, 3, rgb,  rgb, 3)
+CONVERSION(bgr, rgb, 3, rgba, rgb, 4)
+CONVERSION(bgr, rgb, 3, yuv,  yuv, 3)
+CONVERSION(bgr, rgb, 3, gray, yuv, 1)
+
+CONVERSION(bgra, rgb, 4, bgr,  rgb, 3)
+CONVERSION(bgra, rgb, 4, rgb,  rgb, 3)
+CONVERSION(bgra, rgb, 4, rgba, rgb, 4)
+CONVERSION(bgra, rgb, 4, yuv,  yuv, 3)
+CONVERSION(bgra, rgb, 4, gray, yuv, 1)
+
+CONVERSION(rgb, rgb, 3, bgr,  rgb, 3)
+CONVERSION(rgb, rgb, 3, bgra, rgb, 4)
+CONVERSION(rgb, rgb, 3, rgba, rgb, 4)
+CONVERSION(rgb, rgb, 3, yuv,  yuv, 3)
+CONVERSION(rgb, rgb, 3, gray, yuv, 1)
+
+CONVERSION(rgba, rgb, 4, bgr,  rgb, 3)
+CONVERSION(rgba, rgb, 4, bgra, rgb, 4)
+CONVERSION(rgba, rgb, 4, rgb,  rgb, 3)
+CONVERSION(rgba, rgb, 4, yuv,  yuv, 3)
+CONVERSION(rgba, rgb, 4, gray, yuv, 1)
+
+CONVERSION(yuv, yuv, 3, bgr,  rgb, 3)
+CONVERSION(yuv, yuv, 3, bgra, rgb, 4)
+CONVERSION(yuv, yuv, 3, rgb,  rgb, 3)
+CONVERSION(yuv, yuv, 3, rgba, rgb, 4)
+CONVERSION(yuv, yuv, 3, gray, yuv, 1)
+
+CONVERSION(gray, yuv, 1, bgr,  rgb, 3)
+CONVERSION(gray, yuv, 1, bgra, rgb, 4)
+CONVERSION(gray, yuv, 1, rgb,  rgb, 3)
+CONVERSION(gray, yuv, 1, rgba, rgb, 4)
+CONVERSION(gray, yuv, 1, yuv,  yuv, 3)
+
+//----------------------------------------------------------------------------------------------------------------------
+
+// Generates a kernel named SRC_to_luma_area, which area averages the luma of the source
+// over each destination pixel. Pixels on the edge of an area are weighted by their coverage.
+#define LUMA_AREA(SRC, SRC_SPACE, SRC_CHANNELS)                                                             \
+__kernel void SRC##_to_luma_area(                                                                           \
+    __global const uchar* src, int src_step, int src_offset, int src_rows, int src_cols,                    \
+    __global uchar* dst, int dst_step, int dst_offset, int dst_rows, int dst_cols,                          \
+    float scale_x, float scale_y                                                                            \
+)                                                                                                           \
+{                                                                                                           \
+    const int2 coord = (int2)(get_global_id(0), get_global_id(1));                                          \
+    if(coord.x >= dst_cols || coord.y >= dst_rows) return;                                                  \
+                                                                                                            \
+    const float2 start = (float2)(coord.x * scale_x, coord.y * scale_y);                                    \
+    const float2 end = min(start + (float2)(scale_x, scale_y), (float2)(src_cols, src_rows));               \
+    const int2 first = convert_int2(start), last = convert_int2(ceil(end));                                 \
+                                                                                                            \
+    float luma = 0.0f;                                                                                      \
+    for(int y = first.y; y < last.y; y++)                                                                   \
+    {                                                                                                       \
+        const float y_weight = min(end.y, y + 1.0f) - max(start.y, (float)y);                               \
+        const int row_index = mad24(y, src_step, src_offset);                                               \
+                                                                                                            \
+        float row_luma = 0.0f;                                                                              \
+        for(int x = first.x; x < last.x; x++)                                                               \
+        {                                                                                                   \
+            const float x_weight = min(end.x, x + 1.0f) - max(start.x, (float)x);                           \
+            row_luma += x_weight * SRC_SPACE##_to_yuv(read_##SRC(src + row_index + x * SRC_CHANNELS)).x;    \
+        }                                                                                                   \
+        luma += y_weight * row_luma;                                                                        \
+    }                                                                                                       \
+                                                                                                            \
+    const int dst_index = mad24(coord.y, dst_step, coord.x + dst_offset);                                   \
+    dst[dst_index] = convert_uchar_sat_rte(luma / (scale_x * scale_y));                                     \
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+
+LUMA_AREA(bgr,  rgb, 3)
+LUMA_AREA(bgra, rgb, 4)
+LUMA_AREA(rgb,  rgb, 3)
+LUMA_AREA(rgba, rgb, 4)
+LUMA_AREA(yuv,  yuv, 3)
+LUMA_AREA(gray, yuv, 1)
+
+//----------------------------------------------------------------------------------------------------------------------
+
+// )"
@@ -321,36 +321,45 @@ void easu(__global uchar* src, int src_step, int src_offset, int2 src_coord, flo
 //----------------------------------------------------------------------------------------------------------------------
 
 
-__kernel void easu_scale(
+uchar3 easu_scale_pixel(
     __global uchar* src, int src_step, int src_offset, int src_rows, int src_cols,
-    __global uchar* dst, int dst_step, int dst_offset, int dst_rows, int dst_cols,
-    float2 rscale // Inverse scaling (from the point of view of the dst)
+    int2 dst_coord, float2 rscale
 )
 {
-    // Swizzle the threads for potentially better cache use.
-    int id = get_local_id(1) * 8 + get_local_id(0);
-    
-    int2 dst_coord = remapRed8x8(id) + (int2)(get_group_id(0) << 3, get_group_id(1) << 3); 
     float2 sub_pixel = convert_float2(dst_coord) * rscale;
     int2 src_coord = convert_int2_rtz(sub_pixel);
     sub_pixel -= floor(sub_pixel);
 
-    // Nest the border conditions together to help load balance and minimize branches.
-    if(src_coord.x == 0 || src_coord.y == 0 || src_coord.x >= src_cols - 4 || src_coord.y >= src_rows - 4 || dst_coord.x >= dst_cols || dst_coord.y >= dst_rows)
+    // If we are out of the src bounds, scale by nearest neighbour.
+    if(src_coord.x == 0 || src_coord.y == 0 || src_coord.x >= src_cols - 4 || src_coord.y >= src_rows - 4)
     {
-        // If we are out of the src bounds (but inside dst bounds), scale by nearest neighbour. 
-        if(dst_coord.x < dst_cols && dst_coord.y < dst_rows)
-        {
-            int src_index = src_coord.y * src_step + (3 * src_coord.x) + src_offset;
-            int dst_index = dst_coord.y * dst_step + (3 * dst_coord.x) + dst_offset;
-            vstore3(vload3(0, src + src_index), 0, dst + dst_index);
-        }
-        return;
+        int src_index = src_coord.y * src_step + (3 * src_coord.x) + src_offset;
+        return vload3(0, src + src_index);
     }
 
     // Run EASU
     uchar3 dst_pixel;
     easu(src, src_step, src_offset, src_coord, sub_pixel, &dst_pixel);
+    return dst_pixel;
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+
+__kernel void easu_scale(
+    __global uchar* src, int src_step, int src_offset, int src_rows, int src_cols,
+    __global uchar* dst, int dst_step, int dst_offset, int dst_rows, int dst_cols,
+    float2 rscale // Inverse scaling (from the point of view of the dst)
+)
+{
+    // Swizzle the threads for potentially better cache use.
+    int id = get_local_id(1) * 8 + get_local_id(0);
+    int2 dst_coord = remapRed8x8(id) + (int2)(get_group_id(0) << 3, get_group_id(1) << 3); 
+
+    // Exit early if out of bounds (for uneven output sizes)
+    if(dst_coord.x >= dst_cols || dst_coord.y >= dst_rows)
+        return;
+
+    uchar3 dst_pixel = easu_scale_pixel(src, src_step, src_offset, src_rows, src_cols, dst_coord, rscale);
 
     // Write pixel.
     int dst_index = dst_coord.y * dst_step + (3 * dst_coord.x) + dst_offset;
@@ -457,6 +466,41 @@ __kernel void easu_remap_homography(
 //                                      FSR - [RCAS] ROBUST CONTRAST ADAPTIVE SHARPENING
 //==============================================================================================================================
 
+float3 rcas_resolve(float3 b, float3 d, float3 e, float3 f, float3 h, float sharpness)
+{
+    // Algorithm uses minimal 3x3 pixel neighborhood.
+    //    b 
+    //  d e f
+    //    h
+
+    // Min and max of ring.
+    float3 mn4 = min4(b,d,f,h);
+    float3 mx4 = max4(b,d,f,h);
+
+    // Immediate constants for peak range.
+    float2 peakC = (float2)(1.0, -4.0);
+
+    // Limiters, these need to be high precision RCPs.
+    float3 hitMin = min(mn4, e) * native_recip(4.0f * mx4);
+    float3 hitMax = (peakC.x - max(mx4,e)) * native_recip(4.0f * mn4 + peakC.y);
+    float3 lobe3 = max(-hitMin, hitMax);
+    float lobe = clamp(max(lobe3.x,max(lobe3.y,lobe3.z)), -0.1875f, 0.0f) * sharpness;
+
+    // Resolve, which needs the medium precision rcp approximation to avoid visible tonality changes.
+    float rcpL = APrxMedRcpF1(4.0f * lobe + 1.0f);
+    return (((b + d + h + f) * lobe) + e) * rcpL;
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+
+float3 rcas_load(__global uchar* src, int src_step, int src_offset, int2 coord)
+{
+    const float norm_factor = 0.00392156862f;
+    return convert_float3(vload3(0, src + coord.y * src_step + (3 * coord.x) + src_offset)) * norm_factor;
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+
 __kernel void rcas(
     __global uchar* src, int src_step, int src_offset, int src_rows, int src_cols,
     __global uchar* dst, int dst_step, int dst_offset, float sharpness
@@ -471,67 +515,97 @@ __kernel void rcas(
     int id = get_local_id(1) * 8 + get_local_id(0);
     int2 coord = remapRed8x8(id) + (int2)(get_group_id(0) << 3, get_group_id(1) << 3); 
 
-    int src_index = coord.y * src_step + (3 * coord.x) + src_offset;
+    // Exit early if out of bounds (for uneven output sizes)
+    if(coord.x >= src_cols || coord.y >= src_rows)
+        return;
+
+    // Clamp the taps to the image, so that its border is also sharpened.
+    int2 lo = max(coord - (int2)(1), (int2)(0));
+    int2 hi = min(coord + (int2)(1), (int2)(src_cols - 1, src_rows - 1));
+
+    float3 b = rcas_load(src, src_step, src_offset, (int2)(coord.x, lo.y));
+    float3 d = rcas_load(src, src_step, src_offset, (int2)(lo.x, coord.y));
+    float3 e = rcas_load(src, src_step, src_offset, coord);
+    float3 f = rcas_load(src, src_step, src_offset, (int2)(hi.x, coord.y));
+    float3 h = rcas_load(src, src_step, src_offset, (int2)(coord.x, hi.y));
+
+    float3 fpx = rcas_resolve(b, d, e, f, h, sharpness);
+
     int dst_index = coord.y * dst_step + (3 * coord.x) + dst_offset;
+    vstore3(convert_uchar3(fpx * 255.0f), 0, dst + dst_index);
+} 
 
-    // Nest the border conditions together to help load balance and minimize branches.
-    if(coord.x == 0 || coord.x >= src_cols - 1 || coord.y == 0 || coord.y >= src_rows - 1)
+// )" R"(
+//==============================================================================================================================
+//                                      FSR - [EASU + RCAS] FUSED SCALING AND SHARPENING
+//==============================================================================================================================
+
+#define RCAS_GROUP_SIZE 8
+#define RCAS_THREAD_SPAN 2
+#define RCAS_TILE_SIZE (RCAS_GROUP_SIZE * RCAS_THREAD_SPAN)
+#define RCAS_HALO_TILE_SIZE (RCAS_TILE_SIZE + 2)
+
+__kernel void easu_rcas_scale(
+    __global uchar* src, int src_step, int src_offset, int src_rows, int src_cols,
+    __global uchar* dst, int dst_step, int dst_offset, int dst_rows, int dst_cols,
+    float2 rscale, // Inverse scaling (from the point of view of the dst)
+    float sharpness
+)
+{
+    // NOTE: each 8x8 group upscales a 16x16 tile plus a 1 pixel halo into local memory,
+    // then sharpens the tile from there, so the upscaled frame is never written out
+    // and read back. Each thread sharpens a 2x2 block of the tile, so that the halo
+    // only adds ~27% to the upscaling work, rather than ~56% for an 8x8 tile. The
+    // kernel must be run with 8x8 local groups, each covering 16x16 outputs. The halo
+    // is clamped to the frame, so that the border is sharpened with clamped taps as in rcas.
+    __local uchar3 tile[RCAS_HALO_TILE_SIZE * RCAS_HALO_TILE_SIZE];
+
+    int id = get_local_id(1) * RCAS_GROUP_SIZE + get_local_id(0);
+    int2 tile_origin = (int2)(get_group_id(0) * RCAS_TILE_SIZE, get_group_id(1) * RCAS_TILE_SIZE) - (int2)(1);
+
+    // Upscale the tile and its halo, with each thread covering at most six pixels.
+    for(int i = id; i < RCAS_HALO_TILE_SIZE * RCAS_HALO_TILE_SIZE; i += RCAS_GROUP_SIZE * RCAS_GROUP_SIZE)
     {
-        // Perform direct copy if we are on the border of the image. 
-        if(coord.x <= src_cols || coord.y <= src_rows)
-            vstore3(vload3(0, src + src_index), 0, dst + dst_index);
-        return;
+        int2 coord = clamp(
+            tile_origin + (int2)(i % RCAS_HALO_TILE_SIZE, i / RCAS_HALO_TILE_SIZE),
+            (int2)(0),
+            (int2)(dst_cols - 1, dst_rows - 1)
+        );
+        tile[i] = easu_scale_pixel(src, src_step, src_offset, src_rows, src_cols, coord, rscale);
     }
+    barrier(CLK_LOCAL_MEM_FENCE);
 
-    // Do not run sharpening on edges to avoid going out of bounds
+    // Swizzle the threads for potentially better cache use.
+    int2 block_coord = remapRed8x8(id) * RCAS_THREAD_SPAN;
     const float norm_factor = 0.00392156862f;
 
-    uchar3 r0 = vload3(0, src + src_index - src_step);
-    uchar8 r1 = vload8(0, src + src_index - 3);
-    uchar3 r2 = vload3(0, src + src_index + src_step);
-
-    float3 b = convert_float3(r0) * norm_factor;
-    float3 h = convert_float3(r2) * norm_factor;
-    float3 d = convert_float3((uchar3)(r1.s0, r1.s1, r1.s2)) * norm_factor;
-    float3 e = convert_float3((uchar3)(r1.s3, r1.s4, r1.s5)) * norm_factor;
-    float3 f = convert_float3((uchar3)(r1.s6, r1.s7, src[src_index + 5])) * norm_factor;
-    
-    // Rename 
-    float bR=b.z; float bG=b.y; float bB=b.x;
-    float dR=d.z; float dG=d.y; float dB=d.x;
-    float eR=e.z; float eG=e.y; float eB=e.x;
-    float fR=f.z; float fG=f.y; float fB=f.x;
-    float hR=h.z; float hG=h.y; float hB=h.x;
+    for(int y = 0; y < RCAS_THREAD_SPAN; y++)
+    {
+        for(int x = 0; x < RCAS_THREAD_SPAN; x++)
+        {
+            int2 local_coord = block_coord + (int2)(x, y);
+            int2 dst_coord = tile_origin + local_coord + (int2)(1);
 
-    // Min and max of ring.
-    float mn4R = min4f(bR,dR,fR,hR);
-    float mn4G = min4f(bG,dG,fG,hG);
-    float mn4B = min4f(bB,dB,fB,hB);
-    float mx4R = max4f(bR,dR,fR,hR);
-    float mx4G = max4f(bG,dG,fG,hG);
-    float mx4B = max4f(bB,dB,fB,hB);
+            // Skip if out of bounds (for uneven output sizes)
+            if(dst_coord.x >= dst_cols || dst_coord.y >= dst_rows)
+                continue;
 
-    // Immediate constants for peak range.
-    float2 peakC = (float2)(1.0, -4.0);
+            int tile_index = (local_coord.y + 1) * RCAS_HALO_TILE_SIZE + (local_coord.x + 1);
 
-    // Limiters, these need to be high precision RCPs.
-    float hitMinR = min(mn4R, eR) * native_recip(4.0f * mx4R);
-    float hitMinG = min(mn4G, eG) * native_recip(4.0f * mx4G);
-    float hitMinB = min(mn4B, eB) * native_recip(4.0f * mx4B);
-    float hitMaxR = (peakC.x - max(mx4R,eR)) * native_recip(4.0f * mn4R + peakC.y);
-    float hitMaxG = (peakC.x - max(mx4G,eG)) * native_recip(4.0f * mn4G + peakC.y);
-    float hitMaxB = (peakC.x - max(mx4B,eB)) * native_recip(4.0f * mn4B + peakC.y);
-    float lobeR = max(-hitMinR, hitMaxR);
-    float lobeG = max(-hitMinG, hitMaxG);
-    float lobeB = max(-hitMinB, hitMaxB);
-    float lobe = clamp(max(lobeR,max(lobeG,lobeB)), -0.1875f, 0.0f) * sharpness;
+            float3 b = convert_float3(tile[tile_index - RCAS_HALO_TILE_SIZE]) * norm_factor;
+            float3 d = convert_float3(tile[tile_index - 1]) * norm_factor;
+            float3 e = convert_float3(tile[tile_index]) * norm_factor;
+            float3 f = convert_float3(tile[tile_index + 1]) * norm_factor;
+            float3 h = convert_float3(tile[tile_index + RCAS_HALO_TILE_SIZE]) * norm_factor;
 
-    // Resolve, which needs the medium precision rcp approximation to avoid visible tonality changes.
-    float rcpL = APrxMedRcpF1(4.0f * lobe + 1.0f);
-    float3 fpx = (((b + d + h + f) * lobe) + e) * rcpL;
+            float3 fpx = rcas_resolve(b, d, e, f, h, sharpness);
+            uchar3 dst_pixel = convert_uchar3(fpx * 255.0f);
 
-    uchar3 dst_pixel = convert_uchar3(fpx * 255.0f);
-    vstore3(dst_pixel, 0, dst + dst_index);
-} 
+            // Write pixel.
+            int dst_index = dst_coord.y * dst_step + (3 * dst_coord.x) + dst_offset;
+            vstore3(dst_pixel, 0, dst + dst_index);
+        }
+    }
+}
 
 // )"
@@ -0,0 +1,286 @@
+//     *************************** LiveVisionKit ****************************
+//     Copyright (C) 2022  Sebastian Di Marco (crowsinc.dev@gmail.com)
+//
+//     This program is free software: you can redistribute it and/or modify
+//     it under the terms of the GNU General Public License as published by
+//     the Free Software Foundation, either version 3 of the License, or
+//     (at your option) any later version.
+//
+//     This program is distributed in the hope that it will be useful,
+//     but WITHOUT ANY WARRANTY; without even the implied warranty of
+//     MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//     GNU General Public License for more details.
+//
+//     You should have received a copy of the GNU General Public License
+//     along with this program.  If not, see <https://www.gnu.org/licenses/>.
+//     **********************************************************************
+
+#include "Tuning.hpp"
+
+#include <unordered_map>
+#include <optional>
+#include <cstring>
+#include <fstream>
+#include <limits>
+#include <array>
+#include <mutex>
+
+#include "Kernels.hpp"
+#include "Functions/Image.hpp"
+#include "Functions/Drawing.hpp"
+#include "Functions/Conversion.hpp"
+#include "Timing/Stopwatch.hpp"
+#include "Directives.hpp"
+
+namespace lvk::ocl
+{
+
+    constexpr std::array<std::array<size_t, 2>, 6> GROUP_CANDIDATES_1D = {{
+        {16, 1}, {32, 1}, {64, 1}, {128, 1}, {256, 1}, {512, 1}
+    }};
+
+    constexpr std::array<std::array<size_t, 2>, 9> GROUP_CANDIDATES_2D = {{
+        {4, 4}, {8, 4}, {8, 8}, {16, 4}, {16, 8}, {8, 16}, {16, 16}, {32, 4}, {32, 8}
+    }};
+
+    static const cv::Size TUNING_RESOLUTION = {1920, 1080};
+    constexpr auto TUNING_POINTS = 4096;
+
+    static std::mutex s_TuningMutex;
+    static std::unordered_map<std::string, std::array<size_t, 2>> s_TunedGroups;
+    static std::optional<uint64_t> s_TunedDevice;
+
+    // Forces the local groups of a kernel while it is being tuned.
+    thread_local const char* t_TuningKernel = nullptr;
+    thread_local std::array<size_t, 2> t_TuningGroups;
+    thread_local bool t_TuningRejected = false;
+
+//---------------------------------------------------------------------------------------------------------------------
+
+    static std::string tuning_key(const char* kernel_name, const int dimensions)
+    {
+        return std::string(kernel_name) + "/" + std::to_string(dimensions);
+    }
+
+//---------------------------------------------------------------------------------------------------------------------
+
+    static std::filesystem::path tuning_file()
+    {
+        if(program_cache().empty())
+            return {};
+
+        // NOTE: the version invalidates groups which were tuned without the kernel's work group limit.
+        return program_cache() / cv::format(
+            "groups-v2-%016llx.txt", static_cast<unsigned long long>(device_signature())
+        );
+    }
+
+//---------------------------------------------------------------------------------------------------------------------
+
+    static void load_tuned_groups()
+    {
+        // NOTE: Must be called with the tuning mutex locked.
+        const uint64_t device = device_signature();
+        if(s_TunedDevice == device)
+            return;
+
+        s_TunedGroups.clear();
+        s_TunedDevice = device;
+
+        const auto file = tuning_file();
+        if(file.empty())
+            return;
+
+        std::ifstream stream(file);
+        std::string key;
+        size_t width, height;
+        while(stream >> key >> width >> height)
+        {
+            if(width > 0 && height > 0)
+                s_TunedGroups[key] = {width, height};
+        }
+    }
+
+//---------------------------------------------------------------------------------------------------------------------
+
+    static void save_tuned_groups()
+    {
+        // NOTE: Must be called with the tuning mutex locked.
+        const auto file = tuning_file();
+        if(file.empty())
+            return;
+
+        std::error_code error;
+        std::filesystem::create_directories(file.parent_path(), error);
+        if(error) return;
+
+        std::ofstream stream(file, std::ios::trunc);
+        for(const auto& [key, groups] : s_TunedGroups)
+            stream << key << ' ' << groups[0] << ' ' << groups[1] << '\n';
+    }
+
+//---------------------------------------------------------------------------------------------------------------------
+
+    bool find_tuned_groups(
+        const char* kernel_name,
+        const int dimensions,
+        size_t local_groups[3],
+        const size_t max_group_size
+    )
+    {
+        if(t_TuningKernel != nullptr && std::strcmp(t_TuningKernel, kernel_name) == 0)
+        {
+            // Reject the candidate if the kernel cannot launch it.
+            if(t_TuningGroups[0] * t_TuningGroups[1] > max_group_size)
+            {
+                t_TuningRejected = true;
+                return false;
+            }
+
+            local_groups[0] = t_TuningGroups[0];
+            local_groups[1] = t_TuningGroups[1];
+            local_groups[2] = 1;
+            return true;
+        }
+
+        std::lock_guard<std::mutex> tuning_lock(s_TuningMutex);
+        load_tuned_groups();
+
+        const auto entry = s_TunedGroups.find(tuning_key(kernel_name, dimensions));
+        if(entry == s_TunedGroups.end() || entry->second[0] * entry->second[1] > max_group_size)
+            return false;
+
+        local_groups[0] = entry->second[0];
+        local_groups[1] = entry->second[1];
+        local_groups[2] = 1;
+        return true;
+    }
+
+//---------------------------------------------------------------------------------------------------------------------
+
+    bool is_tuning()
+    {
+        return t_TuningKernel != nullptr;
+    }
+
+//---------------------------------------------------------------------------------------------------------------------
+
+    void tune_groups(
+        const char* kernel_name,
+        const int dimensions,
+        const std::function<void()>& workload,
+        const int samples
+    )
+    {
+        LVK_ASSERT(dimensions == 1 || dimensions == 2);
+        LVK_ASSERT(samples > 0);
+
+        if(!cv::ocl::useOpenCL())
+            return;
+
+        const size_t max_group_size = cv::ocl::Device::getDefault().maxWorkGroupSize();
+
+        std::array<size_t, 2> best_groups = {0, 0};
+        uint64_t best_time = std::numeric_limits<uint64_t>::max();
+
+        const auto test_candidate = [&](const std::array<size_t, 2>& groups){
+            if(groups[0] * groups[1] > max_group_size)
+                return;
+
+            t_TuningKernel = kernel_name;
+            t_TuningGroups = groups;
+            t_TuningRejected = false;
+            const size_t prev_failures = failed_launches();
+
+            // Run once to warm up before timing the samples.
+            workload();
+
+            Stopwatch timer;
+            timer.sync_gpu().start();
+            for(int i = 0; i < samples; i++)
+                workload();
+
+            const uint64_t time = timer.sync_gpu().stop().nanoseconds();
+
+            // NOTE: rejected or failed candidates do no work, so they must not be timed.
+            if(t_TuningRejected || failed_launches() != prev_failures)
+                return;
+
+            if(time < best_time)
+            {
+                best_time = time;
+                best_groups = groups;
+            }
+        };
+
+        if(dimensions == 1)
+            for(const auto& groups : GROUP_CANDIDATES_1D) test_candidate(groups);
+        else
+            for(const auto& groups : GROUP_CANDIDATES_2D) test_candidate(groups);
+
+        t_TuningKernel = nullptr;
+
+        if(best_groups[0] == 0)
+            return;
+
+        std::lock_guard<std::mutex> tuning_lock(s_TuningMutex);
+        load_tuned_groups();
+
+        s_TunedGroups[tuning_key(kernel_name, dimensions)] = best_groups;
+        save_tuned_groups();
+    }
+
+//---------------------------------------------------------------------------------------------------------------------
+
+    void autotune(const bool retune)
+    {
+        if(!cv::ocl::useOpenCL())
+            return;
+
+        const auto should_tune = [&](const char* kernel_name, const int dimensions){
+            size_t local_groups[3];
+            return retune || !find_tuned_groups(kernel_name, dimensions, local_groups);
+        };
+
+        // Representative workloads for each of the LVK kernels.
+        VideoFrame src(cv::UMat(TUNING_RESOLUTION, CV_8UC3), 0, VideoFrame::YUV), dst;
+        cv::randu(src, cv::Scalar::all(0), cv::Scalar::all(255));
+
+        cv::UMat offset_map(TUNING_RESOLUTION, CV_32FC2, cv::Scalar::all(0));
+        const cv::Mat homography = cv::Mat::eye(3, 3, CV_64FC1);
+
+        std::vector<cv::Point2f> points(TUNING_POINTS);
+        cv::randu(points, cv::Scalar::all(0), cv::Scalar(TUNING_RESOLUTION.width, TUNING_RESOLUTION.height));
+
+        if(should_tune("easu_scale", 2))
+            tune_groups("easu_scale", 2, [&](){upscale(src, dst, TUNING_RESOLUTION * 2, true);});
+
+        if(should_tune("rcas", 2))
+            tune_groups("rcas", 2, [&](){sharpen(src, dst);});
+
+        if(should_tune("easu_remap", 2))
+            tune_groups("easu_remap", 2, [&](){remap(src, dst, offset_map, {0,0,0});});
+
+        if(should_tune("easu_remap_homography", 2))
+            tune_groups("easu_remap_homography", 2, [&](){remap(src, dst, homography, {0,0,0}, true);});
+
+        if(should_tune("conversion", 2))
+            tune_groups("conversion", 2, [&](){convert(src, dst, VideoFrame::YUV, VideoFrame::BGR);});
+
+        if(should_tune("luma_area", 2))
+            tune_groups("luma_area", 2, [&](){downscale_luma(src, dst, TUNING_RESOLUTION / 4);});
+
+        src.copyTo(dst);
+        if(should_tune("grid", 2))
+            tune_groups("grid", 2, [&](){draw_grid(dst, {32, 32}, yuv::MAGENTA, 1);});
+
+        if(should_tune("points", 1))
+            tune_groups("points", 1, [&](){draw_points(dst, points, yuv::MAGENTA, 3);});
+
+        if(should_tune("crosses", 1))
+            tune_groups("crosses", 1, [&](){draw_crosses(dst, points, yuv::MAGENTA, 5, 1);});
+    }
+
+//---------------------------------------------------------------------------------------------------------------------
+
+}
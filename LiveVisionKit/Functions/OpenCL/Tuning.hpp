@@ -0,0 +1,52 @@
+//     *************************** LiveVisionKit ****************************
+//     Copyright (C) 2022  Sebastian Di Marco (crowsinc.dev@gmail.com)
+//
+//     This program is free software: you can redistribute it and/or modify
+//     it under the terms of the GNU General Public License as published by
+//     the Free Software Foundation, either version 3 of the License, or
+//     (at your option) any later version.
+//
+//     This program is distributed in the hope that it will be useful,
+//     but WITHOUT ANY WARRANTY; without even the implied warranty of
+//     MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//     GNU General Public License for more details.
+//
+//     You should have received a copy of the GNU General Public License
+//     along with this program.  If not, see <https://www.gnu.org/licenses/>.
+//     **********************************************************************
+
+#pragma once
+
+#include <functional>
+#include <limits>
+#include <opencv2/opencv.hpp>
+
+namespace lvk::ocl
+{
+
+    // NOTE: Tunes the local groups of a kernel by benchmarking each candidate on
+    // the workload, which must launch the kernel using the named optimal_groups.
+    // Candidates above the work group limit of the kernel, or which fail to
+    // launch, are discarded. The winners are persisted per device in the
+    // program cache directory.
+    void tune_groups(
+        const char* kernel_name,
+        const int dimensions,
+        const std::function<void()>& workload,
+        const int samples = 10
+    );
+
+    // NOTE: tuned groups which are larger than the maximum group size are ignored.
+    bool find_tuned_groups(
+        const char* kernel_name,
+        const int dimensions,
+        size_t local_groups[3],
+        const size_t max_group_size = std::numeric_limits<size_t>::max()
+    );
+
+    bool is_tuning();
+
+    // Tunes all LVK kernels which have not yet been tuned for the current device.
+    void autotune(const bool retune = false);
+
+}
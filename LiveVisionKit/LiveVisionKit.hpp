@@ -28,37 +28,53 @@
 #include "Functions/Logic.hpp"
 #include "Functions/Drawing.hpp"
 #include "Functions/Container.hpp"
+#include "Functions/Conversion.hpp"
 #include "Functions/Extensions.hpp"
+#include "Functions/OpenCL/Kernels.hpp"
+#include "Functions/OpenCL/Tuning.hpp"
+#include "Functions/OpenCL/Execution.hpp"
 
 
 #include "Filters/VideoFilter.hpp"
 #include "Filters/CompositeFilter.hpp"
 #include "Filters/ConversionFilter.hpp"
 #include "Filters/DeblockingFilter.hpp"
+#include "Filters/ScalingLadderFilter.hpp"
 #include "Filters/StabilizationFilter.hpp"
+#include "Filters/TileProcessor.hpp"
 
 #include "Logging/Logger.hpp"
 #include "Logging/CSVLogger.hpp"
 
 #include "Math/WarpMesh.hpp"
 #include "Math/Homography.hpp"
+#include "Math/MeshExpression.hpp"
+#include "Math/MotionEstimator.hpp"
 #include "Math/VirtualGrid.hpp"
 #include "Math/BoundingQuad.hpp"
 
 #include "Data/VideoFrame.hpp"
 #include "Data/SpatialMap.hpp"
 #include "Data/StreamBuffer.hpp"
+#include "Data/FrameSource.hpp"
+#include "Data/SyntheticSource.hpp"
+#include "Data/FrameQueue.hpp"
 
 #include "Timing/Time.hpp"
 #include "Timing/Stopwatch.hpp"
+#include "Timing/DeviceTimer.hpp"
 #include "Timing/TickTimer.hpp"
 
 #include "Utility/Unique.hpp"
 #include "Utility/Configurable.hpp"
+#include "Utility/AllocationCounter.hpp"
 
 #include "Vision/FrameTracker.hpp"
+#include "Vision/FrameAnalysis.hpp"
+#include "Vision/GyroMotionSource.hpp"
 #include "Vision/PathSmoother.hpp"
 #include "Vision/FeatureDetector.hpp"
+#include "Vision/FeatureTrackSet.hpp"
 #include "Vision/CameraCalibrator.hpp"
 
 
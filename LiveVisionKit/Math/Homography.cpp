@@ -17,17 +17,36 @@
 
 #include "Homography.hpp"
 
+#include <limits>
+#include <opencv2/core/hal/intrin.hpp>
+
 #include "Directives.hpp"
 
 namespace lvk
 {
 
+//---------------------------------------------------------------------------------------------------------------------
+
+    // NOTE: points at infinity are mapped to zero, as with cv::perspectiveTransform.
+    constexpr double MIN_PERSPECTIVE_DIVISOR = std::numeric_limits<float>::epsilon();
+
+//---------------------------------------------------------------------------------------------------------------------
+
+    static cv::Matx33d to_matrix(const cv::Mat& matrix)
+    {
+        LVK_ASSERT(matrix.cols == 3);
+        LVK_ASSERT(matrix.rows == 3);
+        LVK_ASSERT(matrix.type() == CV_64FC1);
+
+        return static_cast<cv::Matx33d>(matrix);
+    }
+
 //---------------------------------------------------------------------------------------------------------------------
 
 	const Homography& Homography::Identity()
 	{
 		// NOTE: A default-initialised homography is identity
-        thread_local const Homography identity;
+        static const Homography identity;
 		return identity;
 	}
 
@@ -35,7 +54,7 @@ namespace lvk
 
 	const Homography& Homography::Zero()
 	{
-        thread_local const Homography zero(cv::Mat::zeros(3, 3, CV_64FC1));
+        static const Homography zero(cv::Matx33d::zeros());
         return zero;
 	}
 
@@ -51,7 +70,7 @@ namespace lvk
 		Homography perspective;
 		for(int r = 0; r < 2; r++)
 			for(int c = 0; c < 3; c++)
-                perspective.m_Matrix.at<double>(r, c) = affine.at<double>(r, c);
+                perspective.m_Matrix(r, c) = affine.at<double>(r, c);
 
 		return perspective;
 	}
@@ -59,74 +78,66 @@ namespace lvk
 //---------------------------------------------------------------------------------------------------------------------
 
 	Homography::Homography()
-		: m_Matrix(cv::Mat::eye(3, 3, CV_64FC1))
+		: m_Matrix(cv::Matx33d::eye())
 	{}
 
 //---------------------------------------------------------------------------------------------------------------------
 
     Homography::Homography(const Homography& other)
-        : Homography(other.m_Matrix)
+        : m_Matrix(other.m_Matrix)
     {}
 
 //---------------------------------------------------------------------------------------------------------------------
 
     Homography::Homography(Homography&& other) noexcept
-        : m_Matrix(std::move(other.m_Matrix))
+        : m_Matrix(other.m_Matrix)
     {}
 
 //---------------------------------------------------------------------------------------------------------------------
 
 	Homography::Homography(const cv::Mat& matrix)
-		: m_Matrix(matrix.clone())
-	{
-		LVK_ASSERT(matrix.cols == 3);
-		LVK_ASSERT(matrix.rows == 3);
-		LVK_ASSERT(matrix.type() == CV_64FC1);
-	}
+		: m_Matrix(to_matrix(matrix))
+	{}
 
 //---------------------------------------------------------------------------------------------------------------------
 
-    Homography::Homography(cv::Mat&& matrix) noexcept
-        : m_Matrix(std::move(matrix))
-    {
-        LVK_ASSERT(m_Matrix.cols == 3);
-        LVK_ASSERT(m_Matrix.rows == 3);
-        LVK_ASSERT(m_Matrix.type() == CV_64FC1);
-    }
+    Homography::Homography(const cv::Matx33d& matrix)
+        : m_Matrix(matrix)
+    {}
 
 //---------------------------------------------------------------------------------------------------------------------
 
     void Homography::set_zero()
     {
-        m_Matrix.setTo(cv::Scalar::all(0.0));
+        m_Matrix = cv::Matx33d::zeros();
     }
 
 //---------------------------------------------------------------------------------------------------------------------
 
     void Homography::set_identity()
     {
-        set_zero();
-        m_Matrix.at<double>(0,0) = 1.0;
-        m_Matrix.at<double>(1,1) = 1.0;
-        m_Matrix.at<double>(2,2) = 1.0;
+        m_Matrix = cv::Matx33d::eye();
     }
 
 //---------------------------------------------------------------------------------------------------------------------
 
 	cv::Point2d Homography::transform(const cv::Point2d& point) const
 	{
-		std::vector<cv::Point2d> out, in = {point};
-		cv::perspectiveTransform(in, out, m_Matrix);
-		return out[0];
+        const double w = m_Matrix(2, 0) * point.x + m_Matrix(2, 1) * point.y + m_Matrix(2, 2);
+        if(std::abs(w) <= MIN_PERSPECTIVE_DIVISOR)
+            return {0.0, 0.0};
+
+        return {
+            (m_Matrix(0, 0) * point.x + m_Matrix(0, 1) * point.y + m_Matrix(0, 2)) / w,
+            (m_Matrix(1, 0) * point.x + m_Matrix(1, 1) * point.y + m_Matrix(1, 2)) / w
+        };
 	}
 
 //---------------------------------------------------------------------------------------------------------------------
 
     cv::Point2f Homography::transform(const cv::Point2f& point) const
     {
-        std::vector<cv::Point2f> out, in = {point};
-        cv::perspectiveTransform(in, out, m_Matrix);
-        return out[0];
+        return cv::Point2f(transform(cv::Point2d(point)));
     }
 
 //---------------------------------------------------------------------------------------------------------------------
@@ -147,14 +158,53 @@ namespace lvk
 
 	void Homography::transform(const std::vector<cv::Point2d>& points, std::vector<cv::Point2d>& dst) const
 	{
-        cv::perspectiveTransform(points, dst, m_Matrix);
+        dst.resize(points.size());
+        for(size_t i = 0; i < points.size(); i++)
+            dst[i] = transform(points[i]);
 	}
 
 //---------------------------------------------------------------------------------------------------------------------
 
     void Homography::transform(const std::vector<cv::Point2f>& points, std::vector<cv::Point2f>& dst) const
     {
-        cv::perspectiveTransform(points, dst, m_Matrix);
+        dst.resize(points.size());
+        transform(points.data(), dst.data(), points.size());
+    }
+
+//---------------------------------------------------------------------------------------------------------------------
+
+    void Homography::transform(const cv::Point2f* points, cv::Point2f* dst, const size_t count) const
+    {
+        size_t i = 0;
+
+#if CV_SIMD128
+        constexpr int lanes = cv::v_float32x4::nlanes;
+
+        const cv::Matx33f model = m_Matrix;
+        const cv::v_float32x4 h00 = cv::v_setall_f32(model(0, 0)), h01 = cv::v_setall_f32(model(0, 1));
+        const cv::v_float32x4 h02 = cv::v_setall_f32(model(0, 2)), h10 = cv::v_setall_f32(model(1, 0));
+        const cv::v_float32x4 h11 = cv::v_setall_f32(model(1, 1)), h12 = cv::v_setall_f32(model(1, 2));
+        const cv::v_float32x4 h20 = cv::v_setall_f32(model(2, 0)), h21 = cv::v_setall_f32(model(2, 1));
+        const cv::v_float32x4 h22 = cv::v_setall_f32(model(2, 2));
+        const cv::v_float32x4 min_divisor = cv::v_setall_f32(static_cast<float>(MIN_PERSPECTIVE_DIVISOR));
+        const cv::v_float32x4 zero = cv::v_setzero_f32(), one = cv::v_setall_f32(1.0f);
+
+        // NOTE: the points are loaded before they are stored, so the transform may be in place.
+        for(; i + lanes <= count; i += lanes)
+        {
+            cv::v_float32x4 x, y;
+            cv::v_load_deinterleave(reinterpret_cast<const float*>(points + i), x, y);
+
+            const cv::v_float32x4 w = cv::v_muladd(h20, x, cv::v_muladd(h21, y, h22));
+            const cv::v_float32x4 inv_w = cv::v_select(cv::v_abs(w) > min_divisor, one / w, zero);
+
+            const cv::v_float32x4 tx = cv::v_muladd(h00, x, cv::v_muladd(h01, y, h02)) * inv_w;
+            const cv::v_float32x4 ty = cv::v_muladd(h10, x, cv::v_muladd(h11, y, h12)) * inv_w;
+            cv::v_store_interleave(reinterpret_cast<float*>(dst + i), tx, ty);
+        }
+#endif
+        for(; i < count; i++)
+            dst[i] = transform(points[i]);
     }
 
 //---------------------------------------------------------------------------------------------------------------------
@@ -186,14 +236,14 @@ namespace lvk
 	void Homography::warp(const cv::UMat& src, cv::UMat& dst) const
 	{
 		if(is_affine())
-			cv::warpAffine(src, dst, m_Matrix.rowRange(0, 2), src.size());
+			cv::warpAffine(src, dst, m_Matrix.get_minor<2, 3>(0, 0), src.size());
 		else
 			cv::warpPerspective(src, dst, m_Matrix, src.size());
 	}
 
 //---------------------------------------------------------------------------------------------------------------------
 
-	const cv::Mat& Homography::data() const
+	const cv::Matx33d& Homography::data() const
 	{
 		return m_Matrix;
 	}
@@ -202,17 +252,14 @@ namespace lvk
 
     Homography Homography::invert() const
     {
-        cv::Mat result = m_Matrix.inv();
-        return Homography(result);
+        return Homography(m_Matrix.inv());
     }
 
 //---------------------------------------------------------------------------------------------------------------------
 
     bool Homography::is_identity() const
     {
-        return m_Matrix.at<cv::Vec3d>(0,0) == cv::Vec3d(1.0, 0.0, 0.0)
-            && m_Matrix.at<cv::Vec3d>(1,0) == cv::Vec3d(0.0, 1.0, 0.0)
-            && m_Matrix.at<cv::Vec3d>(2,0) == cv::Vec3d(0.0, 0.0, 1.0);
+        return m_Matrix == cv::Matx33d::eye();
     }
 
 //---------------------------------------------------------------------------------------------------------------------
@@ -220,31 +267,29 @@ namespace lvk
 	bool Homography::is_affine() const
 	{
 		// We consider the homography affine if the bottom row is unchanged from identity
-		return m_Matrix.at<cv::Vec3d>(2, 0) == cv::Vec3d(0.0, 0.0, 1.0);
+		return m_Matrix(2, 0) == 0.0 && m_Matrix(2, 1) == 0.0 && m_Matrix(2, 2) == 1.0;
 	}
 
 //---------------------------------------------------------------------------------------------------------------------
 
     bool Homography::is_zero() const
     {
-        return m_Matrix.at<cv::Vec3d>(0,0) == cv::Vec3d(0.0, 0.0, 0.0)
-            && m_Matrix.at<cv::Vec3d>(1,0) == cv::Vec3d(0.0, 0.0, 0.0)
-            && m_Matrix.at<cv::Vec3d>(2,0) == cv::Vec3d(0.0, 0.0, 0.0);
+        return m_Matrix == cv::Matx33d::zeros();
     }
 
 //---------------------------------------------------------------------------------------------------------------------
 
     Homography& Homography::operator=(const cv::Mat& other)
     {
-        m_Matrix = other.clone();
+        m_Matrix = to_matrix(other);
         return *this;
     }
 
 //---------------------------------------------------------------------------------------------------------------------
 
-    Homography& Homography::operator=(cv::Mat&& other) noexcept
+    Homography& Homography::operator=(const cv::Matx33d& other)
     {
-        m_Matrix = std::move(other);
+        m_Matrix = other;
         return *this;
     }
 
@@ -252,7 +297,7 @@ namespace lvk
 
     Homography& Homography::operator=(const Homography& other)
 	{
-		m_Matrix = other.m_Matrix.clone();
+		m_Matrix = other.m_Matrix;
         return *this;
 	}
 
@@ -260,7 +305,7 @@ namespace lvk
 
     Homography& Homography::operator=(Homography&& other) noexcept
 	{
-		m_Matrix = std::move(other.m_Matrix);
+		m_Matrix = other.m_Matrix;
         return *this;
     }
 
@@ -268,28 +313,28 @@ namespace lvk
 
 	void Homography::operator+=(const Homography& other)
 	{
-		cv::add(m_Matrix, other.m_Matrix, m_Matrix);
+		m_Matrix += other.m_Matrix;
 	}
 
 //---------------------------------------------------------------------------------------------------------------------
 
     void Homography::operator+=(const cv::Mat& other)
     {
-        cv::add(m_Matrix, other, m_Matrix);
+        m_Matrix += to_matrix(other);
     }
 
 //---------------------------------------------------------------------------------------------------------------------
 
 	void Homography::operator-=(const Homography& other)
 	{
-		cv::subtract(m_Matrix, other.m_Matrix, m_Matrix);
+		m_Matrix -= other.m_Matrix;
 	}
 
 //---------------------------------------------------------------------------------------------------------------------
 
     void Homography::operator-=(const cv::Mat& other)
     {
-        cv::subtract(m_Matrix, other, m_Matrix);
+        m_Matrix -= to_matrix(other);
     }
 
 //---------------------------------------------------------------------------------------------------------------------
@@ -297,7 +342,7 @@ namespace lvk
 	void Homography::operator*=(const Homography& other)
 	{
         // This is matrix multiplication
-        cv::gemm(m_Matrix, other.m_Matrix, 1, cv::Mat(), 0, m_Matrix, 0);
+        m_Matrix = m_Matrix * other.m_Matrix;
 	}
 
 //---------------------------------------------------------------------------------------------------------------------
@@ -305,7 +350,7 @@ namespace lvk
     void Homography::operator*=(const cv::Mat& other)
     {
         // This is matrix multiplication
-        cv::gemm(m_Matrix, other, 1, cv::Mat(), 0, m_Matrix, 0);
+        m_Matrix = m_Matrix * to_matrix(other);
     }
 
 //---------------------------------------------------------------------------------------------------------------------
@@ -321,23 +366,21 @@ namespace lvk
 	{
 		LVK_ASSERT(scaling != 0.0);
 
-		m_Matrix /= scaling;
+		m_Matrix *= (1.0 / scaling);
 	}
 
 //---------------------------------------------------------------------------------------------------------------------
 
 	Homography operator+(const Homography& left, const Homography& right)
 	{
-        cv::Mat result = left.data() + right.data();
-		return Homography(std::move(result));
+		return Homography(left.data() + right.data());
 	}
 
 //---------------------------------------------------------------------------------------------------------------------
 
 	Homography operator-(const Homography& left, const Homography& right)
 	{
-        cv::Mat result = left.data() - right.data();
-        return Homography(std::move(result));
+        return Homography(left.data() - right.data());
 	}
 
 //---------------------------------------------------------------------------------------------------------------------
@@ -345,16 +388,14 @@ namespace lvk
 	Homography operator*(const Homography& left, const Homography& right)
 	{
         // This is matrix multiplication
-        cv::Mat result = left.data() * right.data();
-        return Homography(std::move(result));
+        return Homography(left.data() * right.data());
 	}
 
 //---------------------------------------------------------------------------------------------------------------------
 
 	Homography operator*(const Homography& homography, const double scaling)
 	{
-		cv::Mat result = homography.data() * scaling;
-        return Homography(std::move(result));
+        return Homography(homography.data() * scaling);
 	}
 
 //---------------------------------------------------------------------------------------------------------------------
@@ -363,8 +404,7 @@ namespace lvk
 	{
 		LVK_ASSERT(scaling != 0.0);
 
-        cv::Mat result = homography.data() / scaling;
-        return Homography(std::move(result));
+        return Homography(homography.data() * (1.0 / scaling));
 	}
 
 //---------------------------------------------------------------------------------------------------------------------
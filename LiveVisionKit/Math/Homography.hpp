@@ -23,6 +23,7 @@
 namespace lvk
 {
 
+    // NOTE: the matrix is held by value, so homographies never touch the heap.
 	class Homography
 	{
 	public:
@@ -42,7 +43,7 @@ namespace lvk
 
         explicit Homography(const cv::Mat& matrix);
 
-        explicit Homography(cv::Mat&& matrix) noexcept;
+        explicit Homography(const cv::Matx33d& matrix);
 
 
         void set_zero();
@@ -63,6 +64,9 @@ namespace lvk
 
 		void transform(const std::vector<cv::Point2f>& points, std::vector<cv::Point2f>& dst) const;
 
+        // NOTE: the points are transformed in vectorized batches, and may be transformed in place.
+        void transform(const cv::Point2f* points, cv::Point2f* dst, const size_t count) const;
+
         std::vector<cv::Point2d> operator*(const std::vector<cv::Point2d>& points) const;
 
         std::vector<cv::Point2f> operator*(const std::vector<cv::Point2f>& points) const;
@@ -71,7 +75,7 @@ namespace lvk
 		void warp(const cv::UMat& src, cv::UMat& dst) const;
 
 
-        const cv::Mat& data() const;
+        const cv::Matx33d& data() const;
 
         Homography invert() const;
 
@@ -84,7 +88,7 @@ namespace lvk
 
         Homography& operator=(const cv::Mat& other);
 
-        Homography& operator=(cv::Mat&& other) noexcept;
+        Homography& operator=(const cv::Matx33d& other);
 
         Homography& operator=(const Homography& other);
 
@@ -108,7 +112,7 @@ namespace lvk
 		void operator/=(const double scaling);
 
 	private:
-		cv::Mat m_Matrix;
+		cv::Matx33d m_Matrix;
 	};
 
 	Homography operator+(const Homography& left, const Homography& right);
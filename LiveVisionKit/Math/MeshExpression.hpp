@@ -0,0 +1,174 @@
+//     *************************** LiveVisionKit ****************************
+//     Copyright (C) 2022  Sebastian Di Marco (crowsinc.dev@gmail.com)
+//
+//     This program is free software: you can redistribute it and/or modify
+//     it under the terms of the GNU General Public License as published by
+//     the Free Software Foundation, either version 3 of the License, or
+//     (at your option) any later version.
+//
+//     This program is distributed in the hope that it will be useful,
+//     but WITHOUT ANY WARRANTY; without even the implied warranty of
+//     MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//     GNU General Public License for more details.
+//
+//     You should have received a copy of the GNU General Public License
+//     along with this program.  If not, see <https://www.gnu.org/licenses/>.
+//     **********************************************************************
+#pragma once
+
+#include <opencv2/opencv.hpp>
+
+namespace lvk
+{
+
+    // NOTE: Lightweight expression templates over mesh offsets, which are evaluated in a
+    // single pass by WarpMesh::evaluate, without any temporary meshes. All operations are
+    // element-wise, so the evaluated mesh may also be an operand of the expression. The
+    // expressions reference their meshes, so they should be evaluated in the same statement.
+    template<typename Expression>
+    struct MeshExpression
+    {
+        const Expression& derived() const;
+    };
+
+
+    class MeshTerm : public MeshExpression<MeshTerm>
+    {
+    public:
+
+        explicit MeshTerm(const cv::Mat& offsets);
+
+        cv::Size size() const;
+
+        cv::Point2f at(const int row, const int col) const;
+
+    private:
+        const cv::Mat& m_Offsets;
+    };
+
+
+    template<typename L, typename R>
+    class MeshSum : public MeshExpression<MeshSum<L, R>>
+    {
+    public:
+
+        MeshSum(const L& left, const R& right);
+
+        cv::Size size() const;
+
+        cv::Point2f at(const int row, const int col) const;
+
+    private:
+        const L m_Left;
+        const R m_Right;
+    };
+
+
+    template<typename L, typename R>
+    class MeshDifference : public MeshExpression<MeshDifference<L, R>>
+    {
+    public:
+
+        MeshDifference(const L& left, const R& right);
+
+        cv::Size size() const;
+
+        cv::Point2f at(const int row, const int col) const;
+
+    private:
+        const L m_Left;
+        const R m_Right;
+    };
+
+
+    template<typename E>
+    class MeshScale : public MeshExpression<MeshScale<E>>
+    {
+    public:
+
+        MeshScale(const E& expression, const cv::Size2f& scaling);
+
+        cv::Size size() const;
+
+        cv::Point2f at(const int row, const int col) const;
+
+    private:
+        const E m_Expression;
+        const cv::Size2f m_Scaling;
+    };
+
+
+    template<typename E>
+    class MeshShift : public MeshExpression<MeshShift<E>>
+    {
+    public:
+
+        MeshShift(const E& expression, const cv::Point2f& offset);
+
+        cv::Size size() const;
+
+        cv::Point2f at(const int row, const int col) const;
+
+    private:
+        const E m_Expression;
+        const cv::Point2f m_Offset;
+    };
+
+
+    template<typename E>
+    class MeshClamp : public MeshExpression<MeshClamp<E>>
+    {
+    public:
+
+        MeshClamp(const E& expression, const cv::Size2f& min, const cv::Size2f& max);
+
+        cv::Size size() const;
+
+        cv::Point2f at(const int row, const int col) const;
+
+    private:
+        const E m_Expression;
+        const cv::Size2f m_Min, m_Max;
+    };
+
+
+    template<typename L, typename R>
+    MeshSum<L, R> operator+(const MeshExpression<L>& left, const MeshExpression<R>& right);
+
+    template<typename L, typename R>
+    MeshDifference<L, R> operator-(const MeshExpression<L>& left, const MeshExpression<R>& right);
+
+
+    template<typename E>
+    MeshShift<E> operator+(const MeshExpression<E>& expression, const cv::Point2f& offset);
+
+    template<typename E>
+    MeshShift<E> operator-(const MeshExpression<E>& expression, const cv::Point2f& offset);
+
+
+    template<typename E>
+    MeshScale<E> operator*(const MeshExpression<E>& expression, const cv::Size2f& scaling);
+
+    template<typename E>
+    MeshScale<E> operator*(const MeshExpression<E>& expression, const float scaling);
+
+    template<typename E>
+    MeshScale<E> operator*(const float scaling, const MeshExpression<E>& expression);
+
+
+    template<typename E>
+    MeshClamp<E> clamp(const MeshExpression<E>& expression, const cv::Size2f& magnitude);
+
+    template<typename E>
+    MeshClamp<E> clamp(const MeshExpression<E>& expression, const cv::Size2f& min, const cv::Size2f& max);
+
+    template<typename L, typename R>
+    MeshSum<MeshScale<L>, MeshScale<R>> blend(
+        const MeshExpression<L>& left,
+        const MeshExpression<R>& right,
+        const float right_weight
+    );
+
+}
+
+#include "MeshExpression.tpp"
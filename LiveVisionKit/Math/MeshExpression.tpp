@@ -0,0 +1,274 @@
+//     *************************** LiveVisionKit ****************************
+//     Copyright (C) 2022  Sebastian Di Marco (crowsinc.dev@gmail.com)
+//
+//     This program is free software: you can redistribute it and/or modify
+//     it under the terms of the GNU General Public License as published by
+//     the Free Software Foundation, either version 3 of the License, or
+//     (at your option) any later version.
+//
+//     This program is distributed in the hope that it will be useful,
+//     but WITHOUT ANY WARRANTY; without even the implied warranty of
+//     MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//     GNU General Public License for more details.
+//
+//     You should have received a copy of the GNU General Public License
+//     along with this program.  If not, see <https://www.gnu.org/licenses/>.
+//     **********************************************************************
+#pragma once
+
+#include <algorithm>
+
+#include "Directives.hpp"
+
+namespace lvk
+{
+
+//---------------------------------------------------------------------------------------------------------------------
+
+    template<typename Expression>
+    inline const Expression& MeshExpression<Expression>::derived() const
+    {
+        return static_cast<const Expression&>(*this);
+    }
+
+//---------------------------------------------------------------------------------------------------------------------
+
+    inline MeshTerm::MeshTerm(const cv::Mat& offsets)
+        : m_Offsets(offsets)
+    {
+        LVK_ASSERT(offsets.type() == CV_32FC2);
+    }
+
+//---------------------------------------------------------------------------------------------------------------------
+
+    inline cv::Size MeshTerm::size() const
+    {
+        return m_Offsets.size();
+    }
+
+//---------------------------------------------------------------------------------------------------------------------
+
+    inline cv::Point2f MeshTerm::at(const int row, const int col) const
+    {
+        return m_Offsets.ptr<cv::Point2f>(row)[col];
+    }
+
+//---------------------------------------------------------------------------------------------------------------------
+
+    template<typename L, typename R>
+    inline MeshSum<L, R>::MeshSum(const L& left, const R& right)
+        : m_Left(left),
+          m_Right(right)
+    {
+        LVK_ASSERT(left.size() == right.size());
+    }
+
+//---------------------------------------------------------------------------------------------------------------------
+
+    template<typename L, typename R>
+    inline cv::Size MeshSum<L, R>::size() const
+    {
+        return m_Left.size();
+    }
+
+//---------------------------------------------------------------------------------------------------------------------
+
+    template<typename L, typename R>
+    inline cv::Point2f MeshSum<L, R>::at(const int row, const int col) const
+    {
+        return m_Left.at(row, col) + m_Right.at(row, col);
+    }
+
+//---------------------------------------------------------------------------------------------------------------------
+
+    template<typename L, typename R>
+    inline MeshDifference<L, R>::MeshDifference(const L& left, const R& right)
+        : m_Left(left),
+          m_Right(right)
+    {
+        LVK_ASSERT(left.size() == right.size());
+    }
+
+//---------------------------------------------------------------------------------------------------------------------
+
+    template<typename L, typename R>
+    inline cv::Size MeshDifference<L, R>::size() const
+    {
+        return m_Left.size();
+    }
+
+//---------------------------------------------------------------------------------------------------------------------
+
+    template<typename L, typename R>
+    inline cv::Point2f MeshDifference<L, R>::at(const int row, const int col) const
+    {
+        return m_Left.at(row, col) - m_Right.at(row, col);
+    }
+
+//---------------------------------------------------------------------------------------------------------------------
+
+    template<typename E>
+    inline MeshScale<E>::MeshScale(const E& expression, const cv::Size2f& scaling)
+        : m_Expression(expression),
+          m_Scaling(scaling)
+    {}
+
+//---------------------------------------------------------------------------------------------------------------------
+
+    template<typename E>
+    inline cv::Size MeshScale<E>::size() const
+    {
+        return m_Expression.size();
+    }
+
+//---------------------------------------------------------------------------------------------------------------------
+
+    template<typename E>
+    inline cv::Point2f MeshScale<E>::at(const int row, const int col) const
+    {
+        const cv::Point2f value = m_Expression.at(row, col);
+        return {value.x * m_Scaling.width, value.y * m_Scaling.height};
+    }
+
+//---------------------------------------------------------------------------------------------------------------------
+
+    template<typename E>
+    inline MeshShift<E>::MeshShift(const E& expression, const cv::Point2f& offset)
+        : m_Expression(expression),
+          m_Offset(offset)
+    {}
+
+//---------------------------------------------------------------------------------------------------------------------
+
+    template<typename E>
+    inline cv::Size MeshShift<E>::size() const
+    {
+        return m_Expression.size();
+    }
+
+//---------------------------------------------------------------------------------------------------------------------
+
+    template<typename E>
+    inline cv::Point2f MeshShift<E>::at(const int row, const int col) const
+    {
+        return m_Expression.at(row, col) + m_Offset;
+    }
+
+//---------------------------------------------------------------------------------------------------------------------
+
+    template<typename E>
+    inline MeshClamp<E>::MeshClamp(const E& expression, const cv::Size2f& min, const cv::Size2f& max)
+        : m_Expression(expression),
+          m_Min(min),
+          m_Max(max)
+    {
+        LVK_ASSERT(min.width <= max.width && min.height <= max.height);
+    }
+
+//---------------------------------------------------------------------------------------------------------------------
+
+    template<typename E>
+    inline cv::Size MeshClamp<E>::size() const
+    {
+        return m_Expression.size();
+    }
+
+//---------------------------------------------------------------------------------------------------------------------
+
+    template<typename E>
+    inline cv::Point2f MeshClamp<E>::at(const int row, const int col) const
+    {
+        const cv::Point2f value = m_Expression.at(row, col);
+        return {
+            std::clamp(value.x, m_Min.width, m_Max.width),
+            std::clamp(value.y, m_Min.height, m_Max.height)
+        };
+    }
+
+//---------------------------------------------------------------------------------------------------------------------
+
+    template<typename L, typename R>
+    inline MeshSum<L, R> operator+(const MeshExpression<L>& left, const MeshExpression<R>& right)
+    {
+        return MeshSum<L, R>(left.derived(), right.derived());
+    }
+
+//---------------------------------------------------------------------------------------------------------------------
+
+    template<typename L, typename R>
+    inline MeshDifference<L, R> operator-(const MeshExpression<L>& left, const MeshExpression<R>& right)
+    {
+        return MeshDifference<L, R>(left.derived(), right.derived());
+    }
+
+//---------------------------------------------------------------------------------------------------------------------
+
+    template<typename E>
+    inline MeshShift<E> operator+(const MeshExpression<E>& expression, const cv::Point2f& offset)
+    {
+        return MeshShift<E>(expression.derived(), offset);
+    }
+
+//---------------------------------------------------------------------------------------------------------------------
+
+    template<typename E>
+    inline MeshShift<E> operator-(const MeshExpression<E>& expression, const cv::Point2f& offset)
+    {
+        return MeshShift<E>(expression.derived(), -offset);
+    }
+
+//---------------------------------------------------------------------------------------------------------------------
+
+    template<typename E>
+    inline MeshScale<E> operator*(const MeshExpression<E>& expression, const cv::Size2f& scaling)
+    {
+        return MeshScale<E>(expression.derived(), scaling);
+    }
+
+//---------------------------------------------------------------------------------------------------------------------
+
+    template<typename E>
+    inline MeshScale<E> operator*(const MeshExpression<E>& expression, const float scaling)
+    {
+        return MeshScale<E>(expression.derived(), cv::Size2f(scaling, scaling));
+    }
+
+//---------------------------------------------------------------------------------------------------------------------
+
+    template<typename E>
+    inline MeshScale<E> operator*(const float scaling, const MeshExpression<E>& expression)
+    {
+        return expression * scaling;
+    }
+
+//---------------------------------------------------------------------------------------------------------------------
+
+    template<typename E>
+    inline MeshClamp<E> clamp(const MeshExpression<E>& expression, const cv::Size2f& magnitude)
+    {
+        return MeshClamp<E>(expression.derived(), cv::Size2f(-magnitude.width, -magnitude.height), magnitude);
+    }
+
+//---------------------------------------------------------------------------------------------------------------------
+
+    template<typename E>
+    inline MeshClamp<E> clamp(const MeshExpression<E>& expression, const cv::Size2f& min, const cv::Size2f& max)
+    {
+        return MeshClamp<E>(expression.derived(), min, max);
+    }
+
+//---------------------------------------------------------------------------------------------------------------------
+
+    template<typename L, typename R>
+    inline MeshSum<MeshScale<L>, MeshScale<R>> blend(
+        const MeshExpression<L>& left,
+        const MeshExpression<R>& right,
+        const float right_weight
+    )
+    {
+        return (left * (1.0f - right_weight)) + (right * right_weight);
+    }
+
+//---------------------------------------------------------------------------------------------------------------------
+
+}
@@ -0,0 +1,473 @@
+//     *************************** LiveVisionKit ****************************
+//     Copyright (C) 2022  Sebastian Di Marco (crowsinc.dev@gmail.com)
+//
+//     This program is free software: you can redistribute it and/or modify
+//     it under the terms of the GNU General Public License as published by
+//     the Free Software Foundation, either version 3 of the License, or
+//     (at your option) any later version.
+//
+//     This program is distributed in the hope that it will be useful,
+//     but WITHOUT ANY WARRANTY; without even the implied warranty of
+//     MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//     GNU General Public License for more details.
+//
+//     You should have received a copy of the GNU General Public License
+//     along with this program.  If not, see <https://www.gnu.org/licenses/>.
+//     **********************************************************************
+
+#include "MotionEstimator.hpp"
+
+#include <limits>
+#include <numeric>
+#include <algorithm>
+#include <opencv2/core/hal/intrin.hpp>
+
+#include "Directives.hpp"
+
+namespace lvk
+{
+
+//---------------------------------------------------------------------------------------------------------------------
+
+    constexpr uint64_t RANDOM_SEED = 0x4C564B;
+    constexpr auto REFINEMENT_ITERATIONS = 2;
+
+    // NOTE: the SPRT assumes that bad models are consistent with a small fraction
+    // of the points, and that solving a model costs as much as verifying ~200 points.
+    constexpr auto SPRT_BAD_RATIO = 0.05f;
+    constexpr auto SPRT_MODEL_COST = 200.0f;
+    constexpr auto SPRT_INITIAL_INLIER_RATIO = 0.25f;
+
+//---------------------------------------------------------------------------------------------------------------------
+
+    MotionEstimator::MotionEstimator(const MotionEstimatorSettings& settings)
+        : m_Random(RANDOM_SEED)
+    {
+        configure(settings);
+    }
+
+//---------------------------------------------------------------------------------------------------------------------
+
+    void MotionEstimator::configure(const MotionEstimatorSettings& settings)
+    {
+        LVK_ASSERT(settings.inlier_threshold >= 0.0f);
+        LVK_ASSERT_RANGE(settings.confidence, 0.0f, 0.9999f);
+        LVK_ASSERT(settings.max_iterations > 0);
+
+        if(!settings.use_prior)
+            m_Prior.reset();
+
+        m_Settings = settings;
+    }
+
+//---------------------------------------------------------------------------------------------------------------------
+
+    void MotionEstimator::reset()
+    {
+        m_Prior.reset();
+        m_Random = cv::RNG(RANDOM_SEED);
+    }
+
+//---------------------------------------------------------------------------------------------------------------------
+
+    size_t MotionEstimator::last_iterations() const
+    {
+        return m_LastIterations;
+    }
+
+//---------------------------------------------------------------------------------------------------------------------
+
+    static size_t required_iterations(const float inlier_ratio, const int sample_size, const float confidence)
+    {
+        const double good_sample_probability = std::pow(static_cast<double>(inlier_ratio), sample_size);
+
+        if(good_sample_probability >= 1.0)
+            return 0;
+        if(good_sample_probability <= std::numeric_limits<double>::epsilon())
+            return std::numeric_limits<size_t>::max();
+
+        return static_cast<size_t>(std::ceil(
+            std::log(1.0 - confidence) / std::log(1.0 - good_sample_probability)
+        ));
+    }
+
+//---------------------------------------------------------------------------------------------------------------------
+
+    static float cross(const float ax, const float ay, const float bx, const float by)
+    {
+        return ax * by - ay * bx;
+    }
+
+//---------------------------------------------------------------------------------------------------------------------
+
+    std::optional<Homography> MotionEstimator::estimate(
+        const std::vector<cv::Point2f>& src_points,
+        const std::vector<cv::Point2f>& dst_points,
+        std::vector<uint8_t>& inlier_status,
+        const bool homography
+    )
+    {
+        LVK_ASSERT(src_points.size() == dst_points.size());
+
+        const size_t point_count = src_points.size();
+        const int sample_size = homography ? 4 : 2;
+
+        inlier_status.assign(point_count, 0);
+        m_LastIterations = 0;
+
+        if(point_count < static_cast<size_t>(sample_size))
+        {
+            m_Prior.reset();
+            return std::nullopt;
+        }
+
+        // Shuffle the points into SoA buffers, so that the SPRT sees the points
+        // in a random order and the verification can be vectorized.
+        m_Order.resize(point_count);
+        std::iota(m_Order.begin(), m_Order.end(), 0);
+        for(size_t i = point_count - 1; i > 0; i--)
+            std::swap(m_Order[i], m_Order[m_Random.uniform(0, static_cast<int>(i) + 1)]);
+
+        m_SrcX.resize(point_count);
+        m_SrcY.resize(point_count);
+        m_DstX.resize(point_count);
+        m_DstY.resize(point_count);
+        for(size_t i = 0; i < point_count; i++)
+        {
+            const auto& src = src_points[m_Order[i]];
+            const auto& dst = dst_points[m_Order[i]];
+            m_SrcX[i] = src.x;
+            m_SrcY[i] = src.y;
+            m_DstX[i] = dst.x;
+            m_DstY[i] = dst.y;
+        }
+
+        cv::Matx33f best_model;
+        size_t best_inliers = 0;
+        size_t max_iterations = m_Settings.max_iterations;
+        update_sprt(SPRT_INITIAL_INLIER_RATIO);
+
+        const auto accept_model = [&](const cv::Matx33f& model, const size_t inliers){
+            const float inlier_ratio = static_cast<float>(inliers) / static_cast<float>(point_count);
+
+            best_model = model;
+            best_inliers = inliers;
+            update_sprt(inlier_ratio);
+            max_iterations = std::min(
+                max_iterations, required_iterations(inlier_ratio, sample_size, m_Settings.confidence)
+            );
+        };
+
+        // The prior is the most likely hypothesis, so it is scored in full first.
+        if(m_Settings.use_prior && m_Prior.has_value())
+        {
+            if(const auto inliers = score(*m_Prior, false); inliers >= static_cast<size_t>(sample_size))
+                accept_model(*m_Prior, inliers);
+        }
+
+        int sample[4];
+        for(size_t i = 0; i < max_iterations; i++)
+        {
+            m_LastIterations++;
+
+            // Draw a minimal sample of unique points.
+            for(int s = 0; s < sample_size; s++)
+            {
+                bool unique;
+                do
+                {
+                    sample[s] = m_Random.uniform(0, static_cast<int>(point_count));
+                    unique = std::find(sample, sample + s, sample[s]) == sample + s;
+                }
+                while(!unique);
+            }
+
+            cv::Matx33f model;
+            if(!solve_minimal(sample, homography, model))
+                continue;
+
+            if(const auto inliers = score(model, true); inliers > best_inliers)
+                accept_model(model, inliers);
+        }
+
+        if(best_inliers < static_cast<size_t>(sample_size))
+        {
+            m_Prior.reset();
+            return std::nullopt;
+        }
+
+        // Refine the best model on all its inliers, which also ensures that
+        // a prior of a different motion model is re-fit to the requested one.
+        for(int i = 0; i < REFINEMENT_ITERATIONS; i++)
+        {
+            cv::Matx33f refined_model = best_model;
+            if(!refine(refined_model, homography))
+                break;
+
+            const auto inliers = score(refined_model, false);
+            if(inliers < best_inliers)
+                break;
+
+            best_model = refined_model;
+            best_inliers = inliers;
+        }
+
+        collect_inliers(best_model, inlier_status);
+        if(m_Settings.use_prior)
+            m_Prior = best_model;
+
+        return Homography(static_cast<cv::Matx33d>(best_model));
+    }
+
+//---------------------------------------------------------------------------------------------------------------------
+
+    void MotionEstimator::update_sprt(const float inlier_ratio)
+    {
+        const float bad_ratio = SPRT_BAD_RATIO;
+        const float good_ratio = std::clamp(inlier_ratio, bad_ratio + 0.01f, 0.99f);
+
+        // Log likelihood ratio steps of a point agreeing or disagreeing with the model.
+        m_SPRTInlierStep = std::log(bad_ratio / good_ratio);
+        m_SPRTOutlierStep = std::log((1.0f - bad_ratio) / (1.0f - good_ratio));
+
+        // Find the optimal decision threshold (Chum & Matas, 2008).
+        const float c = (1.0f - bad_ratio) * m_SPRTOutlierStep + bad_ratio * m_SPRTInlierStep;
+        float threshold = SPRT_MODEL_COST * c + 1.0f;
+        for(int i = 0; i < 10; i++)
+            threshold = SPRT_MODEL_COST * c + 1.0f + std::log(threshold);
+
+        m_SPRTThreshold = std::log(threshold);
+    }
+
+//---------------------------------------------------------------------------------------------------------------------
+
+    size_t MotionEstimator::score(const cv::Matx33f& model, const bool sprt)
+    {
+        const size_t point_count = m_SrcX.size();
+        const float threshold = m_Settings.inlier_threshold * m_Settings.inlier_threshold;
+
+        size_t inliers = 0, i = 0;
+        float likelihood_ratio = 0.0f;
+
+#if CV_SIMD128
+        constexpr int lanes = cv::v_float32x4::nlanes;
+
+        const cv::v_float32x4 h00 = cv::v_setall_f32(model(0, 0)), h01 = cv::v_setall_f32(model(0, 1));
+        const cv::v_float32x4 h02 = cv::v_setall_f32(model(0, 2)), h10 = cv::v_setall_f32(model(1, 0));
+        const cv::v_float32x4 h11 = cv::v_setall_f32(model(1, 1)), h12 = cv::v_setall_f32(model(1, 2));
+        const cv::v_float32x4 h20 = cv::v_setall_f32(model(2, 0)), h21 = cv::v_setall_f32(model(2, 1));
+        const cv::v_float32x4 h22 = cv::v_setall_f32(model(2, 2)), v_threshold = cv::v_setall_f32(threshold);
+
+        for(; i + lanes <= point_count; i += lanes)
+        {
+            const cv::v_float32x4 x = cv::v_load(m_SrcX.data() + i);
+            const cv::v_float32x4 y = cv::v_load(m_SrcY.data() + i);
+
+            const cv::v_float32x4 w = cv::v_muladd(h20, x, cv::v_muladd(h21, y, h22));
+            const cv::v_float32x4 dx = cv::v_muladd(h00, x, cv::v_muladd(h01, y, h02)) / w - cv::v_load(m_DstX.data() + i);
+            const cv::v_float32x4 dy = cv::v_muladd(h10, x, cv::v_muladd(h11, y, h12)) / w - cv::v_load(m_DstY.data() + i);
+
+            // NOTE: true lanes are all ones, which is -1 as an integer.
+            const cv::v_float32x4 inlier_mask = cv::v_muladd(dx, dx, dy * dy) < v_threshold;
+            const int lane_inliers = -cv::v_reduce_sum(cv::v_reinterpret_as_s32(inlier_mask));
+            inliers += lane_inliers;
+
+            if(sprt)
+            {
+                likelihood_ratio += static_cast<float>(lane_inliers) * m_SPRTInlierStep
+                                  + static_cast<float>(lanes - lane_inliers) * m_SPRTOutlierStep;
+
+                // Reject the model once it is most likely bad.
+                if(likelihood_ratio > m_SPRTThreshold)
+                    return 0;
+            }
+        }
+#endif
+        for(; i < point_count; i++)
+        {
+            const float x = m_SrcX[i], y = m_SrcY[i];
+            const float w = model(2, 0) * x + model(2, 1) * y + model(2, 2);
+            const float dx = (model(0, 0) * x + model(0, 1) * y + model(0, 2)) / w - m_DstX[i];
+            const float dy = (model(1, 0) * x + model(1, 1) * y + model(1, 2)) / w - m_DstY[i];
+
+            const bool inlier = dx * dx + dy * dy < threshold;
+            inliers += inlier;
+
+            if(sprt)
+            {
+                likelihood_ratio += inlier ? m_SPRTInlierStep : m_SPRTOutlierStep;
+                if(likelihood_ratio > m_SPRTThreshold)
+                    return 0;
+            }
+        }
+
+        return inliers;
+    }
+
+//---------------------------------------------------------------------------------------------------------------------
+
+    void MotionEstimator::collect_inliers(const cv::Matx33f& model, std::vector<uint8_t>& inlier_status) const
+    {
+        const float threshold = m_Settings.inlier_threshold * m_Settings.inlier_threshold;
+
+        inlier_status.assign(m_Order.size(), 0);
+        for(size_t i = 0; i < m_Order.size(); i++)
+        {
+            const float x = m_SrcX[i], y = m_SrcY[i];
+            const float w = model(2, 0) * x + model(2, 1) * y + model(2, 2);
+            const float dx = (model(0, 0) * x + model(0, 1) * y + model(0, 2)) / w - m_DstX[i];
+            const float dy = (model(1, 0) * x + model(1, 1) * y + model(1, 2)) / w - m_DstY[i];
+
+            inlier_status[m_Order[i]] = dx * dx + dy * dy < threshold;
+        }
+    }
+
+//---------------------------------------------------------------------------------------------------------------------
+
+    bool MotionEstimator::solve_minimal(const int* indices, const bool homography, cv::Matx33f& model) const
+    {
+        if(!homography)
+        {
+            // The similarity is the complex ratio of the two point differences.
+            const int i = indices[0], j = indices[1];
+            const float sx = m_SrcX[j] - m_SrcX[i], sy = m_SrcY[j] - m_SrcY[i];
+            const float dx = m_DstX[j] - m_DstX[i], dy = m_DstY[j] - m_DstY[i];
+
+            const float length = sx * sx + sy * sy;
+            if(length < 1e-6f)
+                return false;
+
+            const float a = (dx * sx + dy * sy) / length;
+            const float b = (dy * sx - dx * sy) / length;
+            model = {
+                a, -b, m_DstX[i] - (a * m_SrcX[i] - b * m_SrcY[i]),
+                b,  a, m_DstY[i] - (b * m_SrcX[i] + a * m_SrcY[i]),
+                0,  0, 1
+            };
+            return true;
+        }
+
+        // Reject collinear samples, or those which flip orientation, as they
+        // cannot produce a valid homography (also see cv::findHomography).
+        constexpr int triplets[4][3] = {{0, 1, 2}, {0, 1, 3}, {0, 2, 3}, {1, 2, 3}};
+        for(const auto& t : triplets)
+        {
+            const int a = indices[t[0]], b = indices[t[1]], c = indices[t[2]];
+            const float src_area = cross(
+                m_SrcX[b] - m_SrcX[a], m_SrcY[b] - m_SrcY[a],
+                m_SrcX[c] - m_SrcX[a], m_SrcY[c] - m_SrcY[a]
+            );
+            const float dst_area = cross(
+                m_DstX[b] - m_DstX[a], m_DstY[b] - m_DstY[a],
+                m_DstX[c] - m_DstX[a], m_DstY[c] - m_DstY[a]
+            );
+
+            if(std::abs(src_area) < 1e-3f || src_area * dst_area <= 0.0f)
+                return false;
+        }
+
+        // Solve the 8x8 DLT system, with the last element fixed to one.
+        cv::Matx<double, 8, 8> A;
+        cv::Vec<double, 8> b;
+        for(int k = 0; k < 4; k++)
+        {
+            const double x = m_SrcX[indices[k]], y = m_SrcY[indices[k]];
+            const double u = m_DstX[indices[k]], v = m_DstY[indices[k]];
+
+            const int r = 2 * k;
+            A(r, 0) = x; A(r, 1) = y; A(r, 2) = 1.0;
+            A(r, 6) = -x * u; A(r, 7) = -y * u;
+            b(r) = u;
+
+            A(r + 1, 3) = x; A(r + 1, 4) = y; A(r + 1, 5) = 1.0;
+            A(r + 1, 6) = -x * v; A(r + 1, 7) = -y * v;
+            b(r + 1) = v;
+        }
+
+        cv::Vec<double, 8> h;
+        if(!cv::solve(A, b, h, cv::DECOMP_LU))
+            return false;
+
+        model = {
+            static_cast<float>(h(0)), static_cast<float>(h(1)), static_cast<float>(h(2)),
+            static_cast<float>(h(3)), static_cast<float>(h(4)), static_cast<float>(h(5)),
+            static_cast<float>(h(6)), static_cast<float>(h(7)), 1.0f
+        };
+        return true;
+    }
+
+//---------------------------------------------------------------------------------------------------------------------
+
+    bool MotionEstimator::refine(cv::Matx33f& model, const bool homography) const
+    {
+        const float threshold = m_Settings.inlier_threshold * m_Settings.inlier_threshold;
+
+        thread_local std::vector<cv::Point2f> src_inliers, dst_inliers;
+        src_inliers.clear();
+        dst_inliers.clear();
+
+        for(size_t i = 0; i < m_SrcX.size(); i++)
+        {
+            const float x = m_SrcX[i], y = m_SrcY[i];
+            const float w = model(2, 0) * x + model(2, 1) * y + model(2, 2);
+            const float dx = (model(0, 0) * x + model(0, 1) * y + model(0, 2)) / w - m_DstX[i];
+            const float dy = (model(1, 0) * x + model(1, 1) * y + model(1, 2)) / w - m_DstY[i];
+
+            if(dx * dx + dy * dy < threshold)
+            {
+                src_inliers.emplace_back(x, y);
+                dst_inliers.emplace_back(m_DstX[i], m_DstY[i]);
+            }
+        }
+
+        if(homography)
+        {
+            if(src_inliers.size() < 4)
+                return false;
+
+            // Least-squares fit over all the inliers.
+            const cv::Mat refined = cv::findHomography(src_inliers, dst_inliers, 0);
+            if(refined.empty())
+                return false;
+
+            model = static_cast<cv::Matx33f>(cv::Matx33d(refined));
+            return true;
+        }
+
+        if(src_inliers.size() < 2)
+            return false;
+
+        // Closed-form least-squares similarity, about the centroids of the inliers.
+        cv::Point2f src_mean(0, 0), dst_mean(0, 0);
+        for(size_t i = 0; i < src_inliers.size(); i++)
+        {
+            src_mean += src_inliers[i];
+            dst_mean += dst_inliers[i];
+        }
+        src_mean /= static_cast<float>(src_inliers.size());
+        dst_mean /= static_cast<float>(dst_inliers.size());
+
+        double dot = 0.0, det = 0.0, length = 0.0;
+        for(size_t i = 0; i < src_inliers.size(); i++)
+        {
+            const cv::Point2f s = src_inliers[i] - src_mean, d = dst_inliers[i] - dst_mean;
+            dot += s.x * d.x + s.y * d.y;
+            det += s.x * d.y - s.y * d.x;
+            length += s.x * s.x + s.y * s.y;
+        }
+
+        if(length < 1e-6)
+            return false;
+
+        const auto a = static_cast<float>(dot / length), b = static_cast<float>(det / length);
+        model = {
+            a, -b, dst_mean.x - (a * src_mean.x - b * src_mean.y),
+            b,  a, dst_mean.y - (b * src_mean.x + a * src_mean.y),
+            0,  0, 1
+        };
+        return true;
+    }
+
+//---------------------------------------------------------------------------------------------------------------------
+
+}
@@ -0,0 +1,91 @@
+//     *************************** LiveVisionKit ****************************
+//     Copyright (C) 2022  Sebastian Di Marco (crowsinc.dev@gmail.com)
+//
+//     This program is free software: you can redistribute it and/or modify
+//     it under the terms of the GNU General Public License as published by
+//     the Free Software Foundation, either version 3 of the License, or
+//     (at your option) any later version.
+//
+//     This program is distributed in the hope that it will be useful,
+//     but WITHOUT ANY WARRANTY; without even the implied warranty of
+//     MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//     GNU General Public License for more details.
+//
+//     You should have received a copy of the GNU General Public License
+//     along with this program.  If not, see <https://www.gnu.org/licenses/>.
+//     **********************************************************************
+
+#pragma once
+
+#include <vector>
+#include <optional>
+#include <opencv2/opencv.hpp>
+
+#include "Homography.hpp"
+#include "Utility/Configurable.hpp"
+
+namespace lvk
+{
+
+    struct MotionEstimatorSettings
+    {
+        float inlier_threshold = 8.0f;
+        float confidence = 0.99f;
+        size_t max_iterations = 50;
+
+        // Scores the last estimated motion before any random hypotheses.
+        bool use_prior = true;
+    };
+
+    // NOTE: Robustly estimates the global motion between two point sets, using RANSAC with
+    // minimal solvers for homographies (4 points) and similarities (2 points). Hypotheses
+    // are verified with the SPRT test, so that bad models are rejected after only a few
+    // points. As consecutive frames have similar motion, the last result is scored first,
+    // which often finds most inliers upfront and allows for very early termination.
+    class MotionEstimator final : public Configurable<MotionEstimatorSettings>
+    {
+    public:
+
+        explicit MotionEstimator(const MotionEstimatorSettings& settings = {});
+
+        void configure(const MotionEstimatorSettings& settings) override;
+
+        // NOTE: If homography is false, a similarity (partial affine) motion is estimated.
+        std::optional<Homography> estimate(
+            const std::vector<cv::Point2f>& src_points,
+            const std::vector<cv::Point2f>& dst_points,
+            std::vector<uint8_t>& inlier_status,
+            const bool homography
+        );
+
+        void reset();
+
+        size_t last_iterations() const;
+
+    private:
+
+        size_t score(const cv::Matx33f& model, const bool sprt);
+
+        void collect_inliers(const cv::Matx33f& model, std::vector<uint8_t>& inlier_status) const;
+
+        bool solve_minimal(const int* indices, const bool homography, cv::Matx33f& model) const;
+
+        bool refine(cv::Matx33f& model, const bool homography) const;
+
+        void update_sprt(const float inlier_ratio);
+
+    private:
+        std::optional<cv::Matx33f> m_Prior;
+
+        // Shuffled point data in SoA layout, for vectorized verification.
+        std::vector<float> m_SrcX, m_SrcY, m_DstX, m_DstY;
+        std::vector<int> m_Order;
+
+        // SPRT parameters (log-space)
+        float m_SPRTInlierStep = 0.0f, m_SPRTOutlierStep = 0.0f, m_SPRTThreshold = 0.0f;
+
+        cv::RNG m_Random;
+        size_t m_LastIterations = 0;
+    };
+
+}
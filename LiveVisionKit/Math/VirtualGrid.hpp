@@ -79,9 +79,12 @@ namespace lvk
 
 
 
-        void for_each(const std::function<void(const int index, const cv::Point& coord)>& operation) const;
+        // NOTE: the operations take the vertex index and coordinate, and are inlined.
+        template<typename Operation>
+        void for_each(Operation&& operation) const;
 
-        void for_each_aligned(const std::function<void(const int index, const cv::Point2f& coord)>& operation) const;
+        template<typename Operation>
+        void for_each_aligned(Operation&& operation) const;
 
     private:
         cv::Size m_Resolution;
@@ -90,3 +93,5 @@ namespace lvk
     };
 
 }
+
+#include "VirtualGrid.tpp"
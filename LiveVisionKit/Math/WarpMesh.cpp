@@ -19,6 +19,7 @@
 
 #include <opencv2/core/ocl.hpp>
 #include <array>
+#include <algorithm>
 
 #include "Functions/Extensions.hpp"
 #include "Functions/Drawing.hpp"
@@ -178,34 +179,203 @@ namespace lvk
         cv::multiply(m_MeshOffsets, norm_factor, m_MeshOffsets);
     }
 
+//---------------------------------------------------------------------------------------------------------------------
+
+    // NOTE: the offsets which take each dst pixel to the src pixel at the same
+    // normalized position, so that a warp map can also scale the frame.
+    static const cv::UMat& scaling_offsets(const cv::Size& src_size, const cv::Size& dst_size)
+    {
+        thread_local cv::UMat offsets(cv::UMatUsageFlags::USAGE_ALLOCATE_DEVICE_MEMORY);
+        thread_local cv::Size offsets_src_size, offsets_dst_size;
+
+        if(offsets_src_size != src_size || offsets_dst_size != dst_size)
+        {
+            const cv::Size2f scaling = cv::Size2f(src_size) / cv::Size2f(dst_size);
+
+            cv::Mat offset_map(dst_size, CV_32FC2);
+            for(int r = 0; r < dst_size.height; r++)
+            {
+                auto* offset_row = offset_map.ptr<cv::Point2f>(r);
+
+                const auto y = static_cast<float>(r);
+                const float y_offset = (y + 0.5f) * scaling.height - 0.5f - y;
+                for(int c = 0; c < dst_size.width; c++)
+                {
+                    const auto x = static_cast<float>(c);
+                    offset_row[c] = {(x + 0.5f) * scaling.width - 0.5f - x, y_offset};
+                }
+            }
+            offset_map.copyTo(offsets);
+
+            offsets_src_size = src_size;
+            offsets_dst_size = dst_size;
+        }
+
+        return offsets;
+    }
+
+//---------------------------------------------------------------------------------------------------------------------
+
+    // NOTE: the normalized positions at which apply samples each vertex of a mesh with
+    // the given size. A 2x2 mesh is modelled by the homography between the frame corners,
+    // so its vertices lie on the corners. Larger meshes are resized to the frame, so their
+    // vertices lie on the centres of the resized cells, as do the pixels of a frame.
+    static void vertex_positions(const cv::Size& mesh_size, cv::Mat& dst)
+    {
+        dst.create(mesh_size, CV_32FC2);
+
+        const bool corner_aligned = mesh_size == WarpMesh::MinimumSize;
+        const cv::Size2f vertex_spacing(
+            1.0f / static_cast<float>(mesh_size.width),
+            1.0f / static_cast<float>(mesh_size.height)
+        );
+
+        for(int r = 0; r < mesh_size.height; r++)
+        {
+            auto* position_row = dst.ptr<cv::Point2f>(r);
+
+            const auto y = static_cast<float>(r);
+            for(int c = 0; c < mesh_size.width; c++)
+            {
+                const auto x = static_cast<float>(c);
+                position_row[c] = corner_aligned ? cv::Point2f(x, y) : cv::Point2f(
+                    (x + 0.5f) * vertex_spacing.width,
+                    (y + 0.5f) * vertex_spacing.height
+                );
+            }
+        }
+    }
+
+//---------------------------------------------------------------------------------------------------------------------
+
+    // NOTE: samples the mesh offsets at the normalized positions, exactly as apply warps
+    // with them. This is the homography of a 2x2 mesh, or the bilinear interpolation of a
+    // larger mesh with its edges replicated, as performed by resize when upscaling it.
+    static void sample_offsets(const cv::Mat& offsets, const cv::Mat& positions, cv::Mat& dst)
+    {
+        LVK_ASSERT(offsets.type() == CV_32FC2 && positions.type() == CV_32FC2);
+        LVK_ASSERT(dst.data != positions.data && dst.data != offsets.data);
+
+        dst.create(positions.size(), CV_32FC2);
+
+        if(offsets.size() == WarpMesh::MinimumSize)
+        {
+            const std::array<cv::Point2f, 4> corners = {
+                cv::Point2f(0, 0), cv::Point2f(1, 0),
+                cv::Point2f(0, 1), cv::Point2f(1, 1)
+            };
+
+            const std::array<cv::Point2f, 4> sources = {
+                corners[0] + offsets.at<cv::Point2f>(0, 0),
+                corners[1] + offsets.at<cv::Point2f>(0, 1),
+                corners[2] + offsets.at<cv::Point2f>(1, 0),
+                corners[3] + offsets.at<cv::Point2f>(1, 1)
+            };
+
+            const Homography warp(cv::getPerspectiveTransform(corners.data(), sources.data()));
+            for(int r = 0; r < positions.rows; r++)
+            {
+                const auto* position_row = positions.ptr<cv::Point2f>(r);
+                auto* offset_row = dst.ptr<cv::Point2f>(r);
+
+                warp.transform(position_row, offset_row, static_cast<size_t>(positions.cols));
+                for(int c = 0; c < positions.cols; c++)
+                    offset_row[c] -= position_row[c];
+            }
+            return;
+        }
+
+        const cv::Size2f mesh_size(offsets.size());
+        const float max_x = mesh_size.width - 1.0f, max_y = mesh_size.height - 1.0f;
+        const auto sample_rows = [&](const cv::Range& rows){
+            for(int r = rows.start; r < rows.end; r++)
+            {
+                const auto* position_row = positions.ptr<cv::Point2f>(r);
+                auto* offset_row = dst.ptr<cv::Point2f>(r);
+
+                for(int c = 0; c < positions.cols; c++)
+                {
+                    const float u = std::clamp(position_row[c].x * mesh_size.width - 0.5f, 0.0f, max_x);
+                    const float v = std::clamp(position_row[c].y * mesh_size.height - 0.5f, 0.0f, max_y);
+
+                    const int x = std::min(static_cast<int>(u), offsets.cols - 2);
+                    const int y = std::min(static_cast<int>(v), offsets.rows - 2);
+                    const float fx = u - static_cast<float>(x), fy = v - static_cast<float>(y);
+
+                    const auto* top = offsets.ptr<cv::Point2f>(y) + x;
+                    const auto* bottom = offsets.ptr<cv::Point2f>(y + 1) + x;
+                    offset_row[c] = (top[0] * (1.0f - fx) + top[1] * fx) * (1.0f - fy)
+                                  + (bottom[0] * (1.0f - fx) + bottom[1] * fx) * fy;
+                }
+            }
+        };
+
+        if(positions.total() >= MIN_PARALLEL_MESH_VERTICES)
+            cv::parallel_for_(cv::Range(0, positions.rows), sample_rows);
+        else
+            sample_rows(cv::Range(0, positions.rows));
+    }
+
 //---------------------------------------------------------------------------------------------------------------------
 
     void WarpMesh::apply(const VideoFrame& src, VideoFrame& dst, const cv::Scalar& background) const
     {
+        apply(src, dst, src.size(), background);
+    }
+
+//---------------------------------------------------------------------------------------------------------------------
+
+    void WarpMesh::apply(
+        const VideoFrame& src,
+        VideoFrame& dst,
+        const cv::Size& size,
+        const cv::Scalar& background
+    ) const
+    {
+        LVK_ASSERT(size.width > 0 && size.height > 0);
+
+        // Remapping requires packed frames, so planar formats are packed as YUV first.
+        if(src.is_planar())
+        {
+            thread_local VideoFrame packed_frame;
+            src.reformatTo(packed_frame, VideoFrame::YUV);
+            apply(packed_frame, dst, size, background);
+            return;
+        }
+
         const cv::Scalar motion_scaling(src.cols, src.rows);
 
         if(m_MeshOffsets.size() != MinimumSize)
         {
             // If our mesh is larger than 2x2 then scale it up and remap the input.
-            cv::resize(m_MeshOffsets, m_WarpMap, src.size(), 0, 0, cv::INTER_LINEAR_EXACT);
+            // When scaling, the map is made at the output size and also carries
+            // each output pixel to its position in the input.
+            cv::resize(m_MeshOffsets, m_WarpMap, size, 0, 0, cv::INTER_LINEAR_EXACT);
             cv::multiply(m_WarpMap, motion_scaling, m_WarpMap);
+            if(size != src.size())
+                cv::add(m_WarpMap, scaling_offsets(src.size(), size), m_WarpMap);
+
             lvk::remap(src, dst, m_WarpMap, background);
         }
         else
         {
             // If our mesh is 2x2, then we can directly model it with a homography.
+            // NOTE: the destination corners are those of the output, so that the
+            // homography also scales the frame when the output size differs.
             const auto w = static_cast<float>(src.cols);
             const auto h = static_cast<float>(src.rows);
+            const auto dst_w = static_cast<float>(size.width);
+            const auto dst_h = static_cast<float>(size.height);
             const std::array<cv::Point2f, 4> destination = {
-                cv::Point2f(0, 0), cv::Point2f(w, 0),
-                cv::Point2f(0, h), cv::Point2f(w, h)
+                cv::Point2f(0, 0), cv::Point2f(dst_w, 0),
+                cv::Point2f(0, dst_h), cv::Point2f(dst_w, dst_h)
             };
 
             const std::array<cv::Point2f, 4> source = {
-                destination[0] + m_MeshOffsets.at<cv::Point2f>(0, 0) * motion_scaling,
-                destination[1] + m_MeshOffsets.at<cv::Point2f>(0, 1) * motion_scaling,
-                destination[2] + m_MeshOffsets.at<cv::Point2f>(1, 0) * motion_scaling,
-                destination[3] + m_MeshOffsets.at<cv::Point2f>(1, 1) * motion_scaling
+                cv::Point2f(0, 0) + m_MeshOffsets.at<cv::Point2f>(0, 0) * motion_scaling,
+                cv::Point2f(w, 0) + m_MeshOffsets.at<cv::Point2f>(0, 1) * motion_scaling,
+                cv::Point2f(0, h) + m_MeshOffsets.at<cv::Point2f>(1, 0) * motion_scaling,
+                cv::Point2f(w, h) + m_MeshOffsets.at<cv::Point2f>(1, 1) * motion_scaling
             };
 
             remap(
@@ -213,7 +383,8 @@ namespace lvk
                 dst,
                 cv::getPerspectiveTransform(destination.data(), source.data()),
                 background,
-                true
+                true,
+                size
             );
         }
 
@@ -222,6 +393,118 @@ namespace lvk
         dst.format = src.format;
     }
 
+//---------------------------------------------------------------------------------------------------------------------
+
+    void WarpMesh::apply(
+        const VideoFrame& src,
+        VideoFrame& dst,
+        TileProcessor& tiler,
+        const cv::Scalar& background
+    ) const
+    {
+        // NOTE: This is a CPU remapping path which generates the warp map one
+        // tile at a time, so that the map and the remapped tile stay resident in
+        // the cache instead of streaming a full resolution map through memory.
+
+        if(src.is_planar())
+        {
+            thread_local VideoFrame packed_frame;
+            src.reformatTo(packed_frame, VideoFrame::YUV);
+            apply(packed_frame, dst, tiler, background);
+            return;
+        }
+
+        LVK_ASSERT(!src.empty());
+        LVK_ASSERT(dst.u == nullptr || dst.u != src.u);
+
+        dst.create(src.size(), src.type());
+
+        const cv::Size2f motion_scaling(src.size());
+        const cv::Size2f mesh_scaling(
+            static_cast<float>(m_MeshOffsets.cols) / static_cast<float>(src.cols),
+            static_cast<float>(m_MeshOffsets.rows) / static_cast<float>(src.rows)
+        );
+
+        // If our mesh is 2x2, then we can directly model it with a homography.
+        cv::Mat homography;
+        if(m_MeshOffsets.size() == MinimumSize)
+        {
+            const auto w = static_cast<float>(src.cols);
+            const auto h = static_cast<float>(src.rows);
+            const std::array<cv::Point2f, 4> destination = {
+                cv::Point2f(0, 0), cv::Point2f(w, 0),
+                cv::Point2f(0, h), cv::Point2f(w, h)
+            };
+
+            const std::array<cv::Point2f, 4> source = {
+                destination[0] + m_MeshOffsets.at<cv::Point2f>(0, 0) * motion_scaling,
+                destination[1] + m_MeshOffsets.at<cv::Point2f>(0, 1) * motion_scaling,
+                destination[2] + m_MeshOffsets.at<cv::Point2f>(1, 0) * motion_scaling,
+                destination[3] + m_MeshOffsets.at<cv::Point2f>(1, 1) * motion_scaling
+            };
+
+            homography = cv::getPerspectiveTransform(destination.data(), source.data());
+        }
+
+        {
+            const cv::Mat src_frame = src.getMat(cv::ACCESS_READ);
+            cv::Mat dst_frame = dst.getMat(cv::ACCESS_WRITE);
+
+            tiler.process(src.size(), [&](const Tile& tile){
+                cv::Mat dst_tile = dst_frame(tile.region);
+
+                if(!homography.empty())
+                {
+                    // Shift the homography into the coordinate space of the tile.
+                    const cv::Mat tile_homography = homography * cv::Mat(cv::Matx33d(
+                        1.0, 0.0, tile.region.x,
+                        0.0, 1.0, tile.region.y,
+                        0.0, 0.0, 1.0
+                    ));
+
+                    cv::warpPerspective(
+                        src_frame, dst_tile, tile_homography, tile.region.size(),
+                        cv::INTER_LINEAR | cv::WARP_INVERSE_MAP, cv::BORDER_CONSTANT, background
+                    );
+                    return;
+                }
+
+                // Sample the tile's portion of the mesh, with the same pixel
+                // alignment that resizing the mesh to the frame would give us.
+                thread_local cv::Mat tile_map;
+                const cv::Matx23f mesh_transform(
+                    mesh_scaling.width, 0.0f, mesh_scaling.width * (static_cast<float>(tile.region.x) + 0.5f) - 0.5f,
+                    0.0f, mesh_scaling.height, mesh_scaling.height * (static_cast<float>(tile.region.y) + 0.5f) - 0.5f
+                );
+
+                cv::warpAffine(
+                    m_MeshOffsets, tile_map, mesh_transform, tile.region.size(),
+                    cv::INTER_LINEAR | cv::WARP_INVERSE_MAP, cv::BORDER_REPLICATE
+                );
+
+                // Turn the offsets into absolute source coordinates.
+                for(int r = 0; r < tile_map.rows; r++)
+                {
+                    auto* map_row = tile_map.ptr<cv::Point2f>(r);
+                    const auto y = static_cast<float>(tile.region.y + r);
+
+                    for(int c = 0; c < tile_map.cols; c++)
+                    {
+                        const auto x = static_cast<float>(tile.region.x + c);
+                        map_row[c].x = x + map_row[c].x * motion_scaling.width;
+                        map_row[c].y = y + map_row[c].y * motion_scaling.height;
+                    }
+                }
+
+                cv::remap(src_frame, dst_tile, tile_map, cv::noArray(), cv::INTER_LINEAR, cv::BORDER_CONSTANT, background);
+            });
+        }
+
+        // Update metadata.
+        dst.timestamp = src.timestamp;
+        dst.format = src.format;
+    }
+
 //---------------------------------------------------------------------------------------------------------------------
 
     // TODO: optimize this
@@ -259,60 +542,6 @@ namespace lvk
         dst.setTo(color, gpu_draw_mask);
     }
 
-//---------------------------------------------------------------------------------------------------------------------
-
-    void WarpMesh::read(
-        const std::function<void(const cv::Point2f&, const cv::Point&)>& operation,
-        const bool parallel
-    ) const
-    {
-        if(parallel)
-        {
-            // NOTE: this uses a parallel loop internally
-            m_MeshOffsets.forEach<cv::Point2f>([&](const cv::Point2f& value, const int coord[]){
-                operation(value, {coord[1], coord[0]});
-            });
-        }
-        else
-        {
-            for(int r = 0; r < m_MeshOffsets.rows; r++)
-            {
-                const auto* row_ptr = m_MeshOffsets.ptr<cv::Point2f>(r);
-                for(int c = 0; c < m_MeshOffsets.cols; c++)
-                {
-                    operation(row_ptr[c], {c, r});
-                }
-            }
-        }
-    }
-
-//---------------------------------------------------------------------------------------------------------------------
-
-    void WarpMesh::write(
-        const std::function<void(cv::Point2f&, const cv::Point&)>& operation,
-        const bool parallel
-    )
-    {
-        if(parallel)
-        {
-            // NOTE: this uses a parallel loop internally
-            m_MeshOffsets.forEach<cv::Point2f>([&](cv::Point2f& value, const int coord[]){
-                operation(value, {coord[1], coord[0]});
-            });
-        }
-        else
-        {
-            for(int r = 0; r < m_MeshOffsets.rows; r++)
-            {
-                auto* row_ptr = m_MeshOffsets.ptr<cv::Point2f>(r);
-                for(int c = 0; c < m_MeshOffsets.cols; c++)
-                {
-                    operation(row_ptr[c], {c, r});
-                }
-            }
-        }
-    }
-
 //---------------------------------------------------------------------------------------------------------------------
 
     void WarpMesh::set_identity()
@@ -335,10 +564,21 @@ namespace lvk
         const auto coord_scaling = motion_scale / cv::Size2f(size() - 1);
         const auto norm_factor = 1.0f / motion_scale;
 
-        write([&](cv::Point2f& offset, const cv::Point& coord){
-            const auto sample_point = cv::Point2f(coord) * coord_scaling;
-            offset = (sample_point - (motion * sample_point)) * norm_factor;
-        });
+        // NOTE: each row is transformed as one batch, using the row itself as the buffer.
+        for(int r = 0; r < m_MeshOffsets.rows; r++)
+        {
+            auto* row_ptr = m_MeshOffsets.ptr<cv::Point2f>(r);
+            for(int c = 0; c < m_MeshOffsets.cols; c++)
+                row_ptr[c] = cv::Point2f(c, r) * coord_scaling;
+
+            motion.transform(row_ptr, row_ptr, m_MeshOffsets.cols);
+
+            for(int c = 0; c < m_MeshOffsets.cols; c++)
+            {
+                const auto sample_point = cv::Point2f(c, r) * coord_scaling;
+                row_ptr[c] = (sample_point - row_ptr[c]) * norm_factor;
+            }
+        }
     }
 
 //---------------------------------------------------------------------------------------------------------------------
@@ -410,20 +650,16 @@ namespace lvk
 
     void WarpMesh::clamp(const cv::Size2f& magnitude)
     {
-        write([&](cv::Point2f& offset, const cv::Point& coord){
-            offset.x = std::clamp(offset.x, -magnitude.width, magnitude.width);
-            offset.y = std::clamp(offset.y, -magnitude.height, magnitude.height);
-        });
+        clamp(cv::Size2f(-magnitude.width, -magnitude.height), magnitude);
     }
 
 //---------------------------------------------------------------------------------------------------------------------
 
     void WarpMesh::clamp(const cv::Size2f& min, const cv::Size2f& max)
     {
-        write([&](cv::Point2f& offset, const cv::Point& coord){
-            offset.x = std::clamp(offset.x, min.width, max.width);
-            offset.y = std::clamp(offset.y, min.height, max.height);
-        });
+        // NOTE: clamps in place, without the parallel loop of a write.
+        cv::max(m_MeshOffsets, cv::Scalar(min.width, min.height), m_MeshOffsets);
+        cv::min(m_MeshOffsets, cv::Scalar(max.width, max.height), m_MeshOffsets);
     }
 
 //---------------------------------------------------------------------------------------------------------------------
@@ -447,6 +683,83 @@ namespace lvk
         cv::scaleAdd(mesh.m_MeshOffsets, scaling, m_MeshOffsets, m_MeshOffsets);
     }
 
+//---------------------------------------------------------------------------------------------------------------------
+
+    void WarpMesh::compose(const WarpMesh& outer, const WarpMesh& inner, const cv::Size& resolution)
+    {
+        LVK_ASSERT(&outer != this && &inner != this);
+        LVK_ASSERT(resolution.height >= MinimumSize.height);
+        LVK_ASSERT(resolution.width >= MinimumSize.width);
+
+        // The outer mesh moves each vertex to the point at which it samples the output
+        // of the inner mesh, so the composition is the sum of the outer offset and the
+        // inner offset there. All meshes are sampled exactly as apply warps with them.
+        thread_local cv::Mat positions, outer_offsets, inner_offsets;
+
+        vertex_positions(resolution, positions);
+        sample_offsets(outer.m_MeshOffsets, positions, outer_offsets);
+
+        cv::add(positions, outer_offsets, positions);
+        sample_offsets(inner.m_MeshOffsets, positions, inner_offsets);
+
+        cv::add(outer_offsets, inner_offsets, m_MeshOffsets);
+    }
+
+//---------------------------------------------------------------------------------------------------------------------
+
+    void WarpMesh::resample(const cv::Size& resolution)
+    {
+        LVK_ASSERT(resolution.height >= MinimumSize.height);
+        LVK_ASSERT(resolution.width >= MinimumSize.width);
+
+        thread_local cv::Mat positions;
+        vertex_positions(resolution, positions);
+
+        cv::Mat resampled_offsets;
+        sample_offsets(m_MeshOffsets, positions, resampled_offsets);
+        m_MeshOffsets = std::move(resampled_offsets);
+    }
+
+//---------------------------------------------------------------------------------------------------------------------
+
+    cv::Size WarpMesh::fit_resolution(const cv::Size& frame_size, const float max_error) const
+    {
+        LVK_ASSERT(frame_size.width > 0 && frame_size.height > 0);
+        LVK_ASSERT(max_error > 0.0f);
+
+        const cv::Size mesh_size = size();
+        const cv::Scalar motion_scaling(frame_size.width, frame_size.height);
+
+        // Render the mesh at every pixel of the frame, as apply would warp with it,
+        // so that each candidate is measured against the dense warp of the frame.
+        cv::Mat pixel_positions, reference_offsets;
+        vertex_positions(frame_size, pixel_positions);
+        sample_offsets(m_MeshOffsets, pixel_positions, reference_offsets);
+
+        // Double the resolution until the resampled mesh is within the error.
+        cv::Mat reduced_positions, reduced_offsets, rendered_offsets;
+        cv::Size resolution = MinimumSize;
+        while(resolution.width < mesh_size.width || resolution.height < mesh_size.height)
+        {
+            vertex_positions(resolution, reduced_positions);
+            sample_offsets(m_MeshOffsets, reduced_positions, reduced_offsets);
+            sample_offsets(reduced_offsets, pixel_positions, rendered_offsets);
+
+            cv::absdiff(rendered_offsets, reference_offsets, rendered_offsets);
+            cv::multiply(rendered_offsets, motion_scaling, rendered_offsets);
+
+            double error = 0.0;
+            cv::minMaxLoc(rendered_offsets.reshape(1), nullptr, &error);
+            if(error <= max_error)
+                return resolution;
+
+            resolution.width = std::min(2 * resolution.width, mesh_size.width);
+            resolution.height = std::min(2 * resolution.height, mesh_size.height);
+        }
+
+        return mesh_size;
+    }
+
 //---------------------------------------------------------------------------------------------------------------------
 
     // NOTE: This returns a view into a shared cache, do not modify the value.
@@ -22,8 +22,10 @@
 #include <opencv2/opencv.hpp>
 
 #include "Math/Homography.hpp"
+#include "Math/MeshExpression.hpp"
 #include "Data/VideoFrame.hpp"
 #include "Functions/Drawing.hpp"
+#include "Filters/TileProcessor.hpp"
 
 namespace lvk
 {
@@ -79,18 +81,36 @@ namespace lvk
 
         void apply(const VideoFrame& src, VideoFrame& dst, const cv::Scalar& background = {0,0,0}) const;
 
+        // NOTE: renders the warp straight to the given size, scaling the frame in the same remap.
+        void apply(
+            const VideoFrame& src,
+            VideoFrame& dst,
+            const cv::Size& size,
+            const cv::Scalar& background = {0,0,0}
+        ) const;
+
+        void apply(
+            const VideoFrame& src,
+            VideoFrame& dst,
+            TileProcessor& tiler,
+            const cv::Scalar& background = {0,0,0}
+        ) const;
+
         void draw(cv::UMat& dst, const cv::Scalar& color = yuv::MAGENTA, const int thickness = 2) const;
 
 
-        void read(
-            const std::function<void(const cv::Point2f& offset, const cv::Point& coord)>& operation,
-            const bool parallel = true
-        ) const;
+        // NOTE: the operations take the offset and coordinate of each vertex, and are
+        // inlined. Only large meshes are visited in parallel, even if it is requested.
+        template<typename Operation>
+        void read(Operation&& operation, const bool parallel = true) const;
+
+        template<typename Operation>
+        void write(Operation&& operation, const bool parallel = true);
+
 
-        void write(
-            const std::function<void(cv::Point2f& offset, const cv::Point& coord)>& operation,
-            const bool parallel = true
-        );
+        // NOTE: evaluates the mesh expression into this mesh in one pass, see MeshExpression.
+        template<typename Expression>
+        void evaluate(const MeshExpression<Expression>& expression);
 
 
         void set_identity();
@@ -122,6 +142,20 @@ namespace lvk
 
         void combine(const WarpMesh& mesh, const float scaling = 1.0f);
 
+        // NOTE: sets the mesh to the single warp which is equivalent to applying the inner
+        // mesh and then the outer mesh, sampled at the given resolution. Neither mesh may
+        // be this mesh. Each mesh is sampled as apply warps with it, so 2x2 meshes act as
+        // homographies. Use fit_resolution to find a resolution which bounds the error.
+        void compose(const WarpMesh& outer, const WarpMesh& inner, const cv::Size& resolution);
+
+        // NOTE: unlike resize, this samples the warp as apply does, so that the resampled
+        // mesh warps the frame as closely as possible, even when resampled down to 2x2.
+        void resample(const cv::Size& resolution);
+
+        // NOTE: finds the smallest resolution at which the resampled mesh stays within the
+        // given error, in pixels, of the dense warp which this mesh applies to the frame.
+        cv::Size fit_resolution(const cv::Size& frame_size, const float max_error) const;
+
 
         WarpMesh& operator=(WarpMesh&& other) noexcept;
 
@@ -188,4 +222,9 @@ namespace lvk
 
     WarpMesh operator/(const float scaling, const WarpMesh& mesh);
 
+
+    MeshTerm lazy(const WarpMesh& mesh);
+
 }
+
+#include "WarpMesh.tpp"
@@ -0,0 +1,129 @@
+//     *************************** LiveVisionKit ****************************
+//     Copyright (C) 2022  Sebastian Di Marco (crowsinc.dev@gmail.com)
+//
+//     This program is free software: you can redistribute it and/or modify
+//     it under the terms of the GNU General Public License as published by
+//     the Free Software Foundation, either version 3 of the License, or
+//     (at your option) any later version.
+//
+//     This program is distributed in the hope that it will be useful,
+//     but WITHOUT ANY WARRANTY; without even the implied warranty of
+//     MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//     GNU General Public License for more details.
+//
+//     You should have received a copy of the GNU General Public License
+//     along with this program.  If not, see <https://www.gnu.org/licenses/>.
+//     **********************************************************************
+#pragma once
+
+#include "Directives.hpp"
+
+namespace lvk
+{
+
+//---------------------------------------------------------------------------------------------------------------------
+
+    // NOTE: smaller meshes are likely not worth the dispatch cost of a parallel loop. As a rough
+    // estimate, not yet measured, the per-vertex operations take a few nanoseconds each, so that
+    // a 32x32 mesh would be visited serially in a few microseconds, which is expected to be on the
+    // order of waking the workers of a parallel_for_. Below it, the meshes used for motion (2x2 to
+    // 16x16) are always visited serially. The threshold should be tuned to the crossover which the
+    // mesh/visitors benchmark of lvk-bench reports, once it has been run on the target hardware.
+    constexpr size_t MIN_PARALLEL_MESH_VERTICES = 32 * 32;
+
+//---------------------------------------------------------------------------------------------------------------------
+
+    template<typename Operation>
+    inline void WarpMesh::read(Operation&& operation, const bool parallel) const
+    {
+        if(parallel && m_MeshOffsets.total() >= MIN_PARALLEL_MESH_VERTICES)
+        {
+            // NOTE: this uses a parallel loop internally
+            m_MeshOffsets.forEach<cv::Point2f>([&](const cv::Point2f& value, const int coord[]){
+                operation(value, cv::Point(coord[1], coord[0]));
+            });
+        }
+        else
+        {
+            for(int r = 0; r < m_MeshOffsets.rows; r++)
+            {
+                const auto* row_ptr = m_MeshOffsets.ptr<cv::Point2f>(r);
+                for(int c = 0; c < m_MeshOffsets.cols; c++)
+                {
+                    operation(row_ptr[c], cv::Point(c, r));
+                }
+            }
+        }
+    }
+
+//---------------------------------------------------------------------------------------------------------------------
+
+    template<typename Operation>
+    inline void WarpMesh::write(Operation&& operation, const bool parallel)
+    {
+        if(parallel && m_MeshOffsets.total() >= MIN_PARALLEL_MESH_VERTICES)
+        {
+            // NOTE: this uses a parallel loop internally
+            m_MeshOffsets.forEach<cv::Point2f>([&](cv::Point2f& value, const int coord[]){
+                operation(value, cv::Point(coord[1], coord[0]));
+            });
+        }
+        else
+        {
+            for(int r = 0; r < m_MeshOffsets.rows; r++)
+            {
+                auto* row_ptr = m_MeshOffsets.ptr<cv::Point2f>(r);
+                for(int c = 0; c < m_MeshOffsets.cols; c++)
+                {
+                    operation(row_ptr[c], cv::Point(c, r));
+                }
+            }
+        }
+    }
+
+//---------------------------------------------------------------------------------------------------------------------
+
+    template<typename Expression>
+    inline void WarpMesh::evaluate(const MeshExpression<Expression>& expression)
+    {
+        const auto& source = expression.derived();
+        const cv::Size mesh_size = source.size();
+
+        LVK_ASSERT(mesh_size.height >= MinimumSize.height);
+        LVK_ASSERT(mesh_size.width >= MinimumSize.width);
+
+        // NOTE: the offsets are only evaluated in place if the size is unchanged,
+        // otherwise this mesh may be an operand which would be lost on reallocation.
+        cv::Mat offsets = m_MeshOffsets;
+        if(offsets.size() != mesh_size)
+            offsets = cv::Mat(mesh_size, CV_32FC2);
+
+        const auto evaluate_rows = [&](const cv::Range& rows){
+            for(int r = rows.start; r < rows.end; r++)
+            {
+                auto* row_ptr = offsets.ptr<cv::Point2f>(r);
+                for(int c = 0; c < mesh_size.width; c++)
+                {
+                    row_ptr[c] = source.at(r, c);
+                }
+            }
+        };
+
+        if(static_cast<size_t>(mesh_size.area()) >= MIN_PARALLEL_MESH_VERTICES)
+            cv::parallel_for_(cv::Range(0, mesh_size.height), evaluate_rows);
+        else
+            evaluate_rows(cv::Range(0, mesh_size.height));
+
+        m_MeshOffsets = offsets;
+    }
+
+//---------------------------------------------------------------------------------------------------------------------
+
+    inline MeshTerm lazy(const WarpMesh& mesh)
+    {
+        return MeshTerm(mesh.offsets());
+    }
+
+//---------------------------------------------------------------------------------------------------------------------
+
+}
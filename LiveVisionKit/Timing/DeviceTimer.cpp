@@ -0,0 +1,183 @@
+//    Copyright (C) 2022  Sebastian Di Marco (crowsinc.dev@gmail.com)
+//
+//    This program is free software: you can redistribute it and/or modify
+//    it under the terms of the GNU General Public License as published by
+//    the Free Software Foundation, either version 3 of the License, or
+//    (at your option) any later version.
+//
+//    This program is distributed in the hope that it will be useful,
+//    but WITHOUT ANY WARRANTY; without even the implied warranty of
+//    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//    GNU General Public License for more details.
+//
+//    You should have received a copy of the GNU General Public License
+//    along with this program.  If not, see <https://www.gnu.org/licenses/>.
+// 	  **********************************************************************
+
+
+#include "DeviceTimer.hpp"
+
+#include <opencv2/core/ocl.hpp>
+#include <opencv2/core/opencl/runtime/opencl_core.hpp>
+
+#include "Directives.hpp"
+#include "Functions/Container.hpp"
+
+namespace lvk
+{
+
+    // Bounds the number of unfinished measurements if the device falls far behind.
+    constexpr size_t MAX_PENDING_SPANS = 64;
+
+//---------------------------------------------------------------------------------------------------------------------
+
+    static bool read_completion_time(const ocl::Event& marker, uint64_t& timestamp)
+    {
+        // Fails if the marker's queue was not created with profiling enabled.
+        return clGetEventProfilingInfo(
+            static_cast<cl_event>(marker.ptr()),
+            CL_PROFILING_COMMAND_END,
+            sizeof(timestamp),
+            &timestamp,
+            nullptr
+        ) == CL_SUCCESS;
+    }
+
+//---------------------------------------------------------------------------------------------------------------------
+
+    DeviceTimer::DeviceTimer(const size_t history)
+        : m_History(history)
+    {
+        LVK_ASSERT(history > 0);
+    }
+
+//---------------------------------------------------------------------------------------------------------------------
+
+    DeviceTimer::~DeviceTimer() = default;
+
+//---------------------------------------------------------------------------------------------------------------------
+
+    void DeviceTimer::start()
+    {
+        if(!cv::ocl::useOpenCL())
+            return;
+
+        auto& context = ocl::ExecutionContext::Default();
+        context.enable_profiling();
+
+        if(!context.is_profiled())
+            return;
+
+        auto start_marker = ocl::Event::Marker(context.queue(ocl::ExecutionContext::COMPUTE));
+        if(!start_marker.empty())
+            m_ActiveSpan = TimingSpan{std::move(start_marker), {}};
+    }
+
+//---------------------------------------------------------------------------------------------------------------------
+
+    void DeviceTimer::stop()
+    {
+        if(!is_running())
+            return;
+
+        auto& context = ocl::ExecutionContext::Default();
+
+        m_ActiveSpan->end_marker = ocl::Event::Marker(context.queue(ocl::ExecutionContext::COMPUTE));
+        if(!m_ActiveSpan->end_marker.empty())
+        {
+            // Submit the work without waiting for it, so the markers can complete.
+            context.flush(ocl::ExecutionContext::COMPUTE);
+            m_PendingSpans.push_back(std::move(*m_ActiveSpan));
+        }
+        m_ActiveSpan.reset();
+
+        collect_spans();
+    }
+
+//---------------------------------------------------------------------------------------------------------------------
+
+    bool DeviceTimer::is_running() const
+    {
+        return m_ActiveSpan.has_value();
+    }
+
+//---------------------------------------------------------------------------------------------------------------------
+
+    void DeviceTimer::collect_spans()
+    {
+        while(!m_PendingSpans.empty())
+        {
+            const auto& span = m_PendingSpans.front();
+
+            // Markers hold no references to the span, so an unfinished span can
+            // safely be dropped if there are too many outstanding measurements.
+            const bool complete = span.end_marker.is_complete();
+            if(!complete && m_PendingSpans.size() <= MAX_PENDING_SPANS)
+                break;
+
+            // The queue is in-order, so the start marker completed before the end marker.
+            uint64_t start_time = 0, end_time = 0;
+            if(complete && read_completion_time(span.start_marker, start_time)
+                        && read_completion_time(span.end_marker, end_time))
+            {
+                m_History.push(Time(end_time > start_time ? end_time - start_time : 0));
+            }
+
+            m_PendingSpans.pop_front();
+        }
+    }
+
+//---------------------------------------------------------------------------------------------------------------------
+
+    Time DeviceTimer::average() const
+    {
+        return m_History.is_empty() ? Time(0) : mean(m_History.begin(), m_History.end());
+    }
+
+//---------------------------------------------------------------------------------------------------------------------
+
+    Time DeviceTimer::deviation() const
+    {
+        if(m_History.size() < 2)
+            return Time(0);
+
+        const Time average_time = average();
+
+        Time total_deviation(0);
+        for(auto current_time : m_History)
+        {
+            if(average_time > current_time)
+                total_deviation += average_time - current_time;
+            else
+                total_deviation += current_time - average_time;
+        }
+
+        return total_deviation / static_cast<double>(m_History.size());
+    }
+
+//---------------------------------------------------------------------------------------------------------------------
+
+    void DeviceTimer::reset_history()
+    {
+        m_History.clear();
+    }
+
+//---------------------------------------------------------------------------------------------------------------------
+
+    const StreamBuffer<Time>& DeviceTimer::history() const
+    {
+        return m_History;
+    }
+
+//---------------------------------------------------------------------------------------------------------------------
+
+    void DeviceTimer::set_history_size(const size_t history)
+    {
+        LVK_ASSERT(history >= 1);
+
+        m_History.resize(history);
+    }
+
+//---------------------------------------------------------------------------------------------------------------------
+
+}
@@ -0,0 +1,76 @@
+//    Copyright (C) 2022  Sebastian Di Marco (crowsinc.dev@gmail.com)
+//
+//    This program is free software: you can redistribute it and/or modify
+//    it under the terms of the GNU General Public License as published by
+//    the Free Software Foundation, either version 3 of the License, or
+//    (at your option) any later version.
+//
+//    This program is distributed in the hope that it will be useful,
+//    but WITHOUT ANY WARRANTY; without even the implied warranty of
+//    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//    GNU General Public License for more details.
+//
+//    You should have received a copy of the GNU General Public License
+//    along with this program.  If not, see <https://www.gnu.org/licenses/>.
+// 	  **********************************************************************
+
+
+#pragma once
+
+#include <deque>
+#include <optional>
+
+#include "Time.hpp"
+#include "Data/StreamBuffer.hpp"
+#include "Functions/OpenCL/Execution.hpp"
+
+namespace lvk
+{
+
+    // NOTE: Times the device execution of all OpenCL work enqueued between start and
+    // stop on the compute queue of the thread's execution context, without waiting on
+    // the queue. Markers are placed around the work, and the device timestamps of their
+    // completion are read from OpenCL profiling once the device finishes them. Profiling
+    // is enabled on the compute queue when the timer is first started on a thread.
+    class DeviceTimer
+    {
+    public:
+
+        explicit DeviceTimer(const size_t history = 1);
+
+        DeviceTimer(const DeviceTimer& other) = delete;
+
+        ~DeviceTimer();
+
+        void start();
+
+        void stop();
+
+        bool is_running() const;
+
+        Time average() const;
+
+        Time deviation() const;
+
+        void reset_history();
+
+        const StreamBuffer<Time>& history() const;
+
+        void set_history_size(const size_t history);
+
+    private:
+
+        struct TimingSpan
+        {
+            ocl::Event start_marker, end_marker;
+        };
+
+        void collect_spans();
+
+    private:
+        StreamBuffer<Time> m_History;
+        std::optional<TimingSpan> m_ActiveSpan;
+        std::deque<TimingSpan> m_PendingSpans;
+    };
+
+}
@@ -0,0 +1,164 @@
+//    Copyright (C) 2022  Sebastian Di Marco (crowsinc.dev@gmail.com)
+//
+//    This program is free software: you can redistribute it and/or modify
+//    it under the terms of the GNU General Public License as published by
+//    the Free Software Foundation, either version 3 of the License, or
+//    (at your option) any later version.
+//
+//    This program is distributed in the hope that it will be useful,
+//    but WITHOUT ANY WARRANTY; without even the implied warranty of
+//    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//    GNU General Public License for more details.
+//
+//    You should have received a copy of the GNU General Public License
+//    along with this program.  If not, see <https://www.gnu.org/licenses/>.
+// 	  **********************************************************************
+
+#include "AllocationCounter.hpp"
+
+#ifdef LVK_COUNT_ALLOCATIONS
+#include <new>
+#include <cstdlib>
+#include <opencv2/core.hpp>
+#endif
+
+namespace lvk
+{
+
+//---------------------------------------------------------------------------------------------------------------------
+
+    static thread_local size_t thread_allocations = 0;
+
+//---------------------------------------------------------------------------------------------------------------------
+
+#ifdef LVK_COUNT_ALLOCATIONS
+
+    // NOTE: counts the cv::Mat data allocations, which do not pass through operator new.
+    class CountingMatAllocator final : public cv::MatAllocator
+    {
+    public:
+
+        cv::UMatData* allocate(
+            int dims,
+            const int* sizes,
+            int type,
+            void* data,
+            size_t* step,
+            cv::AccessFlag flags,
+            cv::UMatUsageFlags usage
+        ) const override
+        {
+            // The header allocated by the standard allocator is not counted, so that
+            // each new matrix counts as one allocation, like any other heap object.
+            const size_t allocations = thread_allocations;
+            auto* mat_data = cv::Mat::getStdAllocator()->allocate(dims, sizes, type, data, step, flags, usage);
+            thread_allocations = allocations + (data == nullptr ? 1 : 0);
+
+            return mat_data;
+        }
+
+        bool allocate(cv::UMatData* data, cv::AccessFlag flags, cv::UMatUsageFlags usage) const override
+        {
+            return cv::Mat::getStdAllocator()->allocate(data, flags, usage);
+        }
+
+        void deallocate(cv::UMatData* data) const override
+        {
+            cv::Mat::getStdAllocator()->deallocate(data);
+        }
+    };
+
+//---------------------------------------------------------------------------------------------------------------------
+
+    static void install_mat_allocator()
+    {
+        static CountingMatAllocator allocator;
+        [[maybe_unused]] static const bool installed = [](){
+            cv::Mat::setDefaultAllocator(&allocator);
+            return true;
+        }();
+    }
+
+#endif
+
+//---------------------------------------------------------------------------------------------------------------------
+
+    bool AllocationCounter::IsSupported()
+    {
+#ifdef LVK_COUNT_ALLOCATIONS
+        return true;
+#else
+        return false;
+#endif
+    }
+
+//---------------------------------------------------------------------------------------------------------------------
+
+    size_t AllocationCounter::ThreadTotal()
+    {
+        return thread_allocations;
+    }
+
+//---------------------------------------------------------------------------------------------------------------------
+
+    void AllocationCounter::start()
+    {
+#ifdef LVK_COUNT_ALLOCATIONS
+        install_mat_allocator();
+#endif
+        m_Running = true;
+        m_StartCount = thread_allocations;
+    }
+
+//---------------------------------------------------------------------------------------------------------------------
+
+    size_t AllocationCounter::stop()
+    {
+        if(m_Running)
+        {
+            m_Count = thread_allocations - m_StartCount;
+            m_Running = false;
+        }
+        return m_Count;
+    }
+
+//---------------------------------------------------------------------------------------------------------------------
+
+    size_t AllocationCounter::count() const
+    {
+        return m_Running ? thread_allocations - m_StartCount : m_Count;
+    }
+
+//---------------------------------------------------------------------------------------------------------------------
+
+    bool AllocationCounter::is_running() const
+    {
+        return m_Running;
+    }
+
+//---------------------------------------------------------------------------------------------------------------------
+
+}
+
+#ifdef LVK_COUNT_ALLOCATIONS
+
+// NOTE: the other allocation functions forward to these by default.
+
+void* operator new(std::size_t size)
+{
+    lvk::thread_allocations++;
+
+    if(void* ptr = std::malloc(size == 0 ? 1 : size))
+        return ptr;
+
+    throw std::bad_alloc();
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+
+void operator delete(void* ptr) noexcept
+{
+    std::free(ptr);
+}
+
+#endif
@@ -0,0 +1,49 @@
+//    Copyright (C) 2022  Sebastian Di Marco (crowsinc.dev@gmail.com)
+//
+//    This program is free software: you can redistribute it and/or modify
+//    it under the terms of the GNU General Public License as published by
+//    the Free Software Foundation, either version 3 of the License, or
+//    (at your option) any later version.
+//
+//    This program is distributed in the hope that it will be useful,
+//    but WITHOUT ANY WARRANTY; without even the implied warranty of
+//    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//    GNU General Public License for more details.
+//
+//    You should have received a copy of the GNU General Public License
+//    along with this program.  If not, see <https://www.gnu.org/licenses/>.
+// 	  **********************************************************************
+
+#pragma once
+
+#include <cstddef>
+
+namespace lvk
+{
+
+    // NOTE: Counts the heap allocations made by the calling thread, through the global operator
+    // new and the default cv::Mat allocator. Counting is only supported in builds which define
+    // LVK_COUNT_ALLOCATIONS, as it replaces the global operator new, otherwise it counts nothing.
+    class AllocationCounter
+    {
+    public:
+
+        static bool IsSupported();
+
+        static size_t ThreadTotal();
+
+
+        void start();
+
+        size_t stop();
+
+        size_t count() const;
+
+        bool is_running() const;
+
+    private:
+        bool m_Running = false;
+        size_t m_StartCount = 0, m_Count = 0;
+    };
+
+}
@@ -111,7 +111,7 @@ namespace lvk
 
 //---------------------------------------------------------------------------------------------------------------------
 
-	float FeatureDetector::detect(cv::InputArray frame, std::vector<cv::KeyPoint>& features)
+	float FeatureDetector::detect(cv::InputArray frame, FeatureTrackSet& features)
 	{
 		LVK_ASSERT(frame.size() == m_Settings.detection_resolution);
         LVK_ASSERT(frame.isMat() || frame.isUMat());
@@ -134,25 +134,25 @@ namespace lvk
                     m_FASTDetector->detect(frame.getUMat()(bounds), m_FASTFeatureBuffer);
 
                 // Process the features through the suppression grid for further non-maximal suppression.
-                // NOTE: user can use class id integer when propagating to prioritize features.
+                // NOTE: new features never replace propagated features which have aged.
                 std::for_each(m_FASTFeatureBuffer.begin(), m_FASTFeatureBuffer.end(), [&](cv::KeyPoint& feature)
                 {
                     // Update local region coordinate to global coordinate.
                     feature.pt += bounds.tl();
-                    feature.class_id = 0;
 
                     // Prefer maximal features
                     const auto& key = m_SuppressionGrid.key_of(feature.pt);
                     if(!m_SuppressionGrid.contains(key))
                     {
                         m_SuppressionGrid.emplace_at(key, m_Features.size());
-                        m_Features.emplace_back(feature);
+                        m_Features.add(feature.pt, feature.response, 0, m_NextTrackID++);
                     }
-                    else if(auto& max = m_Features[m_SuppressionGrid.at(key)];
-                        feature.response > max.response && max.class_id <= 0
+                    else if(const auto max = m_SuppressionGrid.at(key);
+                        feature.response > m_Features.responses()[max] && m_Features.ages()[max] == 0
                     )
                     {
-                        max = feature; // Replace existing feature
+                        // Replace existing feature
+                        m_Features.replace(max, feature.pt, feature.response, 0, m_NextTrackID++);
                     }
                 });
 
@@ -179,26 +179,31 @@ namespace lvk
 
 //---------------------------------------------------------------------------------------------------------------------
 
-	void FeatureDetector::propagate(const std::vector<cv::KeyPoint>& features)
+	void FeatureDetector::propagate(const FeatureTrackSet& features)
 	{
-		for(const auto& feature : features)
+        const auto& points = features.points();
+        const auto& responses = features.responses();
+        const auto& ages = features.ages();
+        const auto& ids = features.ids();
+
+		for(size_t i = 0; i < features.size(); i++)
 		{
 			// Silently ignore features which are out of bounds.
-			if(const auto& key = m_SuppressionGrid.try_key_of(feature.pt); key.has_value())
+			if(const auto& key = m_SuppressionGrid.try_key_of(points[i]); key.has_value())
 			{
-                // Perform non-maximal suppression
-                // NOTE: user can use class id integer to prioritize features.
+                // Perform non-maximal suppression, prioritizing older features.
                 if(!m_SuppressionGrid.contains(*key))
                 {
                     m_SuppressionGrid.emplace_at(*key, m_Features.size());
-                    m_DetectionRegions[feature.pt].load++;
-                    m_Features.emplace_back(feature);
+                    m_DetectionRegions[points[i]].load++;
+                    m_Features.add(points[i], responses[i], ages[i], ids[i]);
                 }
-                else if(auto& max = m_Features[m_SuppressionGrid.at(*key)];
-                    feature.response > max.response && feature.class_id >= max.class_id
+                else if(const auto max = m_SuppressionGrid.at(*key);
+                    responses[i] > m_Features.responses()[max] && ages[i] >= m_Features.ages()[max]
                 )
                 {
-                    max = feature; // Replace existing feature
+                    // Replace existing feature
+                    m_Features.replace(max, points[i], responses[i], ages[i], ids[i]);
                 }
 			}
 		}
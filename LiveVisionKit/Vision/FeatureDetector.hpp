@@ -21,6 +21,7 @@
 
 #include "Utility/Configurable.hpp"
 #include "Data/SpatialMap.hpp"
+#include "FeatureTrackSet.hpp"
 
 namespace lvk
 {
@@ -45,9 +46,9 @@ namespace lvk
 
         void configure(const FeatureDetectorSettings& settings) override;
 
-        float detect(cv::InputArray frame, std::vector<cv::KeyPoint>& features);
+        float detect(cv::InputArray frame, FeatureTrackSet& features);
 
-		void propagate(const std::vector<cv::KeyPoint>& features);
+		void propagate(const FeatureTrackSet& features);
 
 		void reset();
 
@@ -70,7 +71,8 @@ namespace lvk
 	private:
         SpatialMap<FASTRegion> m_DetectionRegions;
         SpatialMap<size_t> m_SuppressionGrid;
-        std::vector<cv::KeyPoint> m_Features;
+        FeatureTrackSet m_Features;
+        uint32_t m_NextTrackID = 0;
 
         std::vector<cv::KeyPoint> m_FASTFeatureBuffer;
         size_t m_FASTFeatureTarget = 0, m_MinimumFeatureLoad = 0;
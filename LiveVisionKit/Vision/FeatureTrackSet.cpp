@@ -0,0 +1,210 @@
+//     *************************** LiveVisionKit ****************************
+//     Copyright (C) 2022  Sebastian Di Marco (crowsinc.dev@gmail.com)
+//
+//     This program is free software: you can redistribute it and/or modify
+//     it under the terms of the GNU General Public License as published by
+//     the Free Software Foundation, either version 3 of the License, or
+//     (at your option) any later version.
+//
+//     This program is distributed in the hope that it will be useful,
+//     but WITHOUT ANY WARRANTY; without even the implied warranty of
+//     MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//     GNU General Public License for more details.
+//
+//     You should have received a copy of the GNU General Public License
+//     along with this program.  If not, see <https://www.gnu.org/licenses/>.
+//     **********************************************************************
+
+#include "FeatureTrackSet.hpp"
+
+#include "Directives.hpp"
+
+namespace lvk
+{
+
+//---------------------------------------------------------------------------------------------------------------------
+
+    template<typename T>
+    static void gather(std::vector<T>& data, const std::vector<uint32_t>& indices)
+    {
+        // NOTE: the indices are ascending and never less than their
+        // position, so the gather can be performed in place.
+        for(size_t i = 0; i < indices.size(); i++)
+            data[i] = data[indices[i]];
+
+        data.resize(indices.size());
+    }
+
+//---------------------------------------------------------------------------------------------------------------------
+
+    void FeatureTrackSet::reserve(const size_t capacity)
+    {
+        m_Points.reserve(capacity);
+        m_Responses.reserve(capacity);
+        m_Ages.reserve(capacity);
+        m_IDs.reserve(capacity);
+        m_KeptIndices.reserve(capacity);
+    }
+
+//---------------------------------------------------------------------------------------------------------------------
+
+    void FeatureTrackSet::clear()
+    {
+        m_Points.clear();
+        m_Responses.clear();
+        m_Ages.clear();
+        m_IDs.clear();
+    }
+
+//---------------------------------------------------------------------------------------------------------------------
+
+    void FeatureTrackSet::add(const cv::Point2f& point, const float response, const uint32_t age, const uint32_t id)
+    {
+        m_Points.push_back(point);
+        m_Responses.push_back(response);
+        m_Ages.push_back(age);
+        m_IDs.push_back(id);
+    }
+
+//---------------------------------------------------------------------------------------------------------------------
+
+    void FeatureTrackSet::replace(
+        const size_t index,
+        const cv::Point2f& point,
+        const float response,
+        const uint32_t age,
+        const uint32_t id
+    )
+    {
+        LVK_ASSERT(index < size());
+
+        m_Points[index] = point;
+        m_Responses[index] = response;
+        m_Ages[index] = age;
+        m_IDs[index] = id;
+    }
+
+//---------------------------------------------------------------------------------------------------------------------
+
+    void FeatureTrackSet::gather_kept_indices(const std::vector<uint8_t>& keep)
+    {
+        LVK_ASSERT(keep.size() == size());
+
+        m_KeptIndices.clear();
+
+        const auto length = static_cast<uint32_t>(keep.size());
+        const uint8_t* keep_data = keep.data();
+
+        uint32_t i = 0;
+#if CV_SIMD128
+        // Skip over whole blocks of discarded tracks, and bulk
+        // append whole blocks of kept tracks, which are common.
+        const cv::v_uint8x16 zero = cv::v_setzero_u8();
+        for(; i + 16 <= length; i += 16)
+        {
+            const cv::v_uint8x16 kept = cv::v_load(keep_data + i) != zero;
+            if(!cv::v_check_any(kept))
+                continue;
+
+            if(cv::v_check_all(kept))
+            {
+                for(uint32_t k = i; k < i + 16; k++)
+                    m_KeptIndices.push_back(k);
+            }
+            else
+            {
+                for(uint32_t k = i; k < i + 16; k++)
+                    if(keep_data[k] != 0) m_KeptIndices.push_back(k);
+            }
+        }
+#endif
+        for(; i < length; i++)
+            if(keep_data[i] != 0) m_KeptIndices.push_back(i);
+    }
+
+//---------------------------------------------------------------------------------------------------------------------
+
+    size_t FeatureTrackSet::compact(const std::vector<uint8_t>& keep)
+    {
+        gather_kept_indices(keep);
+
+        // Nothing to do if every track was kept.
+        if(m_KeptIndices.size() == size())
+            return size();
+
+        gather(m_Points, m_KeptIndices);
+        gather(m_Responses, m_KeptIndices);
+        gather(m_Ages, m_KeptIndices);
+        gather(m_IDs, m_KeptIndices);
+
+        return size();
+    }
+
+//---------------------------------------------------------------------------------------------------------------------
+
+    size_t FeatureTrackSet::compact(const std::vector<uint8_t>& keep, std::vector<cv::Point2f>& companion)
+    {
+        LVK_ASSERT(companion.size() == size());
+
+        compact(keep);
+        if(companion.size() != size())
+            gather(companion, m_KeptIndices);
+
+        return size();
+    }
+
+//---------------------------------------------------------------------------------------------------------------------
+
+    void FeatureTrackSet::advance(std::vector<cv::Point2f>& matched_points)
+    {
+        LVK_ASSERT(matched_points.size() == size());
+
+        std::swap(m_Points, matched_points);
+        for(auto& age : m_Ages) age++;
+    }
+
+//---------------------------------------------------------------------------------------------------------------------
+
+    size_t FeatureTrackSet::size() const
+    {
+        return m_Points.size();
+    }
+
+//---------------------------------------------------------------------------------------------------------------------
+
+    bool FeatureTrackSet::empty() const
+    {
+        return m_Points.empty();
+    }
+
+//---------------------------------------------------------------------------------------------------------------------
+
+    const std::vector<cv::Point2f>& FeatureTrackSet::points() const
+    {
+        return m_Points;
+    }
+
+//---------------------------------------------------------------------------------------------------------------------
+
+    const std::vector<float>& FeatureTrackSet::responses() const
+    {
+        return m_Responses;
+    }
+
+//---------------------------------------------------------------------------------------------------------------------
+
+    const std::vector<uint32_t>& FeatureTrackSet::ages() const
+    {
+        return m_Ages;
+    }
+
+//---------------------------------------------------------------------------------------------------------------------
+
+    const std::vector<uint32_t>& FeatureTrackSet::ids() const
+    {
+        return m_IDs;
+    }
+
+//---------------------------------------------------------------------------------------------------------------------
+
+}
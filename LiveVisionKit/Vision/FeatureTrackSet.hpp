@@ -0,0 +1,85 @@
+//     *************************** LiveVisionKit ****************************
+//     Copyright (C) 2022  Sebastian Di Marco (crowsinc.dev@gmail.com)
+//
+//     This program is free software: you can redistribute it and/or modify
+//     it under the terms of the GNU General Public License as published by
+//     the Free Software Foundation, either version 3 of the License, or
+//     (at your option) any later version.
+//
+//     This program is distributed in the hope that it will be useful,
+//     but WITHOUT ANY WARRANTY; without even the implied warranty of
+//     MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//     GNU General Public License for more details.
+//
+//     You should have received a copy of the GNU General Public License
+//     along with this program.  If not, see <https://www.gnu.org/licenses/>.
+//     **********************************************************************
+
+#pragma once
+
+#include <vector>
+#include <opencv2/opencv.hpp>
+
+namespace lvk
+{
+
+    // NOTE: Stores feature tracks as a structure of arrays so that the hot tracking
+    // loops only touch the data they use. Positions are kept as points so they can be
+    // passed straight to the optical flow and motion estimators. Track ids are given
+    // by the owner, and stay with the track when it is propagated or compacted.
+    class FeatureTrackSet
+    {
+    public:
+
+        FeatureTrackSet() = default;
+
+        void reserve(const size_t capacity);
+
+        void clear();
+
+        void add(const cv::Point2f& point, const float response, const uint32_t age, const uint32_t id);
+
+        void replace(
+            const size_t index,
+            const cv::Point2f& point,
+            const float response,
+            const uint32_t age,
+            const uint32_t id
+        );
+
+        // NOTE: preserves the order of the kept tracks.
+        size_t compact(const std::vector<uint8_t>& keep);
+
+        // NOTE: compacts the companion array along with the tracks.
+        size_t compact(const std::vector<uint8_t>& keep, std::vector<cv::Point2f>& companion);
+
+        // Moves the tracks to their matched points and ages them by one frame.
+        // NOTE: the matched points are swapped out for the previous positions.
+        void advance(std::vector<cv::Point2f>& matched_points);
+
+
+        size_t size() const;
+
+        bool empty() const;
+
+        const std::vector<cv::Point2f>& points() const;
+
+        const std::vector<float>& responses() const;
+
+        const std::vector<uint32_t>& ages() const;
+
+        const std::vector<uint32_t>& ids() const;
+
+    private:
+
+        void gather_kept_indices(const std::vector<uint8_t>& keep);
+
+    private:
+        std::vector<cv::Point2f> m_Points;
+        std::vector<float> m_Responses;
+        std::vector<uint32_t> m_Ages, m_IDs;
+
+        std::vector<uint32_t> m_KeptIndices;
+    };
+
+}
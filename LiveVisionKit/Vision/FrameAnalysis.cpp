@@ -0,0 +1,199 @@
+//     *************************** LiveVisionKit ****************************
+//     Copyright (C) 2022  Sebastian Di Marco (crowsinc.dev@gmail.com)
+//
+//     This program is free software: you can redistribute it and/or modify
+//     it under the terms of the GNU General Public License as published by
+//     the Free Software Foundation, either version 3 of the License, or
+//     (at your option) any later version.
+//
+//     This program is distributed in the hope that it will be useful,
+//     but WITHOUT ANY WARRANTY; without even the implied warranty of
+//     MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//     GNU General Public License for more details.
+//
+//     You should have received a copy of the GNU General Public License
+//     along with this program.  If not, see <https://www.gnu.org/licenses/>.
+//     **********************************************************************
+
+#include "FrameAnalysis.hpp"
+
+#include "Directives.hpp"
+#include "Functions/Conversion.hpp"
+#include "Functions/OpenCL/Execution.hpp"
+
+namespace lvk
+{
+
+//---------------------------------------------------------------------------------------------------------------------
+
+    FrameAnalysis::FrameAnalysis(const FrameTrackerSettings& settings)
+    {
+        configure(settings);
+    }
+
+//---------------------------------------------------------------------------------------------------------------------
+
+    void FrameAnalysis::configure(const FrameTrackerSettings& settings)
+    {
+        // The cached products no longer match the new detection resolution.
+        if(settings.detection_resolution != m_Settings.detection_resolution)
+        {
+            for(auto& pyramid : m_Pyramids)
+                pyramid.clear();
+            m_PyramidBuilt = false;
+        }
+
+        m_FrameTracker.configure(settings);
+        m_Settings = settings;
+    }
+
+//---------------------------------------------------------------------------------------------------------------------
+
+    void FrameAnalysis::advance(const VideoFrame& next_frame)
+    {
+        LVK_ASSERT(!next_frame.empty() && next_frame.has_known_format());
+
+        // Keep the tracker continuous over frames whose motion was never requested.
+        if(m_TrackingActive && !m_MotionResolved)
+            resolve_motion();
+
+        // Analyse the frame on the tracking queue, once the compute queue has finished
+        // producing it. This keeps the analysis out of the compute queue, which is left
+        // free for the filters.
+        auto& context = ocl::ExecutionContext::Default();
+        context.wait(ocl::ExecutionContext::TRACKING, context.record(ocl::ExecutionContext::COMPUTE));
+        {
+            ocl::ExecutionContext::Scope tracking_scope(context, ocl::ExecutionContext::TRACKING);
+            downscale_luma(next_frame, m_Luma, m_Settings.detection_resolution);
+        }
+
+        m_Timestamp = next_frame.timestamp;
+        m_FrameSize = next_frame.size();
+        m_MotionResolved = false;
+        m_HasMotion = false;
+
+        m_PyramidIndex = (m_PyramidIndex + 1) % m_Pyramids.size();
+        m_PyramidBuilt = false;
+    }
+
+//---------------------------------------------------------------------------------------------------------------------
+
+    void FrameAnalysis::restart()
+    {
+        m_FrameTracker.restart();
+        m_TrackingActive = false;
+        m_MotionResolved = false;
+        m_HasMotion = false;
+    }
+
+//---------------------------------------------------------------------------------------------------------------------
+
+    uint64_t FrameAnalysis::timestamp() const
+    {
+        return m_Timestamp;
+    }
+
+//---------------------------------------------------------------------------------------------------------------------
+
+    const cv::Size& FrameAnalysis::frame_size() const
+    {
+        return m_FrameSize;
+    }
+
+//---------------------------------------------------------------------------------------------------------------------
+
+    const cv::UMat& FrameAnalysis::luma() const
+    {
+        LVK_ASSERT(!m_Luma.empty());
+
+        return m_Luma;
+    }
+
+//---------------------------------------------------------------------------------------------------------------------
+
+    const std::vector<cv::Mat>& FrameAnalysis::pyramid()
+    {
+        LVK_ASSERT(!m_Luma.empty());
+
+        // NOTE: the pyramid buffers are re-used from two frames ago, which the tracker no longer reads.
+        auto& pyramid = m_Pyramids[m_PyramidIndex];
+        if(!m_PyramidBuilt)
+        {
+            auto& context = ocl::ExecutionContext::Default();
+            ocl::ExecutionContext::Scope tracking_scope(context, ocl::ExecutionContext::TRACKING);
+            FrameTracker::BuildPyramid(m_Luma, pyramid);
+            m_PyramidBuilt = true;
+        }
+        return pyramid;
+    }
+
+//---------------------------------------------------------------------------------------------------------------------
+
+    bool FrameAnalysis::has_motion()
+    {
+        if(!m_MotionResolved)
+            resolve_motion();
+
+        return m_HasMotion;
+    }
+
+//---------------------------------------------------------------------------------------------------------------------
+
+    const WarpMesh& FrameAnalysis::motion()
+    {
+        LVK_ASSERT(has_motion());
+
+        return m_Motion;
+    }
+
+//---------------------------------------------------------------------------------------------------------------------
+
+    const FeatureTrackSet& FrameAnalysis::features()
+    {
+        if(!m_MotionResolved)
+            resolve_motion();
+
+        return m_FrameTracker.features();
+    }
+
+//---------------------------------------------------------------------------------------------------------------------
+
+    float FrameAnalysis::tracking_stability()
+    {
+        if(!m_MotionResolved)
+            resolve_motion();
+
+        return m_FrameTracker.tracking_stability();
+    }
+
+//---------------------------------------------------------------------------------------------------------------------
+
+    const FrameTracker& FrameAnalysis::tracker() const
+    {
+        return m_FrameTracker;
+    }
+
+//---------------------------------------------------------------------------------------------------------------------
+
+    void FrameAnalysis::resolve_motion()
+    {
+        LVK_ASSERT(!m_Luma.empty());
+
+        auto& context = ocl::ExecutionContext::Default();
+        {
+            ocl::ExecutionContext::Scope tracking_scope(context, ocl::ExecutionContext::TRACKING);
+
+            // The optical flow shares the cached pyramid, which phase correlation does not use.
+            if(m_Settings.use_phase_correlation)
+                m_HasMotion = m_FrameTracker.track(m_Luma, m_Motion);
+            else
+                m_HasMotion = m_FrameTracker.track(m_Luma, pyramid(), m_Motion);
+        }
+
+        m_TrackingActive = true;
+        m_MotionResolved = true;
+    }
+
+//---------------------------------------------------------------------------------------------------------------------
+
+}
@@ -0,0 +1,93 @@
+//     *************************** LiveVisionKit ****************************
+//     Copyright (C) 2022  Sebastian Di Marco (crowsinc.dev@gmail.com)
+//
+//     This program is free software: you can redistribute it and/or modify
+//     it under the terms of the GNU General Public License as published by
+//     the Free Software Foundation, either version 3 of the License, or
+//     (at your option) any later version.
+//
+//     This program is distributed in the hope that it will be useful,
+//     but WITHOUT ANY WARRANTY; without even the implied warranty of
+//     MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//     GNU General Public License for more details.
+//
+//     You should have received a copy of the GNU General Public License
+//     along with this program.  If not, see <https://www.gnu.org/licenses/>.
+//     **********************************************************************
+
+#pragma once
+
+#include <array>
+#include <vector>
+#include <opencv2/opencv.hpp>
+
+#include "FrameTracker.hpp"
+#include "Math/WarpMesh.hpp"
+#include "Data/VideoFrame.hpp"
+#include "Utility/Configurable.hpp"
+
+namespace lvk
+{
+
+    // NOTE: Caches the analysis of the current frame so that it can be shared by many
+    // filters. The luma plane is produced when the frame is advanced, while the pyramid
+    // and the tracking results are only computed once they are first requested. Once
+    // the motion has been requested, every following frame is tracked to keep the
+    // tracker continuous, even if no filter asks for the motion of that frame. All
+    // filters sharing the analysis must be given the frame it was advanced with.
+    class FrameAnalysis final : public Configurable<FrameTrackerSettings>
+    {
+    public:
+
+        explicit FrameAnalysis(const FrameTrackerSettings& settings = {});
+
+        void configure(const FrameTrackerSettings& settings) override;
+
+        void advance(const VideoFrame& next_frame);
+
+        void restart();
+
+        uint64_t timestamp() const;
+
+        const cv::Size& frame_size() const;
+
+        // NOTE: the luma plane is at the detection resolution.
+        const cv::UMat& luma() const;
+
+        // NOTE: the host pyramid of the luma plane, with derivatives, which is also the
+        // pyramid used by the tracker's optical flow. See FrameTracker::BuildPyramid.
+        const std::vector<cv::Mat>& pyramid();
+
+        bool has_motion();
+
+        // NOTE: only valid if the frame has motion.
+        const WarpMesh& motion();
+
+        const FeatureTrackSet& features();
+
+        float tracking_stability();
+
+        const FrameTracker& tracker() const;
+
+    private:
+
+        void resolve_motion();
+
+    private:
+        FrameTracker m_FrameTracker;
+        bool m_TrackingActive = false;
+
+        uint64_t m_Timestamp = 0;
+        cv::Size m_FrameSize = {0,0};
+        cv::UMat m_Luma;
+
+        // NOTE: the tracker references the previous frame's pyramid, so they alternate.
+        std::array<std::vector<cv::Mat>, 2> m_Pyramids;
+        size_t m_PyramidIndex = 0;
+        bool m_PyramidBuilt = false;
+
+        bool m_MotionResolved = false, m_HasMotion = false;
+        WarpMesh m_Motion{WarpMesh::MinimumSize};
+    };
+
+}
@@ -21,21 +21,35 @@
 #include "Math/Homography.hpp"
 #include "Functions/Container.hpp"
 #include "Functions/Extensions.hpp"
+#include "Functions/Conversion.hpp"
 
 namespace lvk
 {
 
 //---------------------------------------------------------------------------------------------------------------------
 
-    // NOTE: if you set the window size to less than 9x9, OpenCV will
-    // run it on the CPU, leading to a large increase in CPU usage in
-    // exchange for it running much faster than the GPU version.
+    // NOTE: the optical tracker is given pre-built pyramids, which OpenCV only
+    // supports on the CPU. In exchange, the pyramid and derivatives of each
+    // frame are only built once, and are re-used when it is the previous frame.
     const cv::Size OPTICAL_TRACKER_WIN_SIZE = {11, 11};
     constexpr auto OPTICAL_TRACKER_PYR_LEVELS = 3;
     constexpr auto OPTICAL_TRACKER_MAX_ITERS = 5;
 
     constexpr auto HOMOGRAPHY_DISTRIBUTION_THRESHOLD = 0.6f;
 
+    // NOTE: tiles with a weak correlation peak most likely contain
+    // no texture, so they fall back to the global translation.
+    constexpr auto MIN_TILE_CORRELATION_RESPONSE = 0.1;
+    constexpr auto MIN_CORRELATION_TILE_SIZE = 32;
+
+    // NOTE: the correlation peak response is mapped onto the inlier ratio scale of the
+    // feature tracking, so that both share the same quality assurance thresholds. The
+    // response of uncorrelated frames sits near the floor, while a response above the
+    // reliable level is as trustworthy as a full set of inliers. These are estimates,
+    // which have not yet been calibrated against the inlier ratios on real footage.
+    constexpr auto CORRELATION_RESPONSE_FLOOR = 0.03;
+    constexpr auto CORRELATION_RESPONSE_RELIABLE = 0.25;
+
 //---------------------------------------------------------------------------------------------------------------------
 
 	FrameTracker::FrameTracker(const FrameTrackerSettings& settings)
@@ -67,10 +81,14 @@ namespace lvk
         m_FeatureDetector.configure(settings);
         m_MatchStatus.reserve(m_FeatureDetector.max_feature_capacity());
         m_InlierStatus.reserve(m_FeatureDetector.max_feature_capacity());
-        m_TrackedPoints.reserve(m_FeatureDetector.max_feature_capacity());
+        m_TrackedFeatures.reserve(m_FeatureDetector.max_feature_capacity());
         m_MatchedPoints.reserve(m_FeatureDetector.max_feature_capacity());
         m_TrackingRegion = cv::Rect2f({0,0}, settings.detection_resolution);
 
+        MotionEstimatorSettings estimator_settings = m_MotionEstimator.settings();
+        estimator_settings.inlier_threshold = settings.acceptance_threshold;
+        m_MotionEstimator.configure(estimator_settings);
+
         if(settings.motion_resolution != m_Settings.motion_resolution || m_MeshConstraints.empty())
         {
             m_OptimizedMesh = Eigen::VectorXf::Zero(2 * settings.motion_resolution.area());
@@ -86,7 +104,12 @@ namespace lvk
         {
             m_MatchedPoints.clear();
             m_FeatureDetector.reset();
-            cv::resize(m_CurrentFrame, m_CurrentFrame, m_Settings.detection_resolution, 0, 0, cv::INTER_LINEAR);
+            m_MotionEstimator.reset();
+            cv::resize(m_CurrentFrame, m_CurrentFrame, settings.detection_resolution, 0, 0, cv::INTER_LINEAR);
+
+            // The pyramid may be shared, so it is replaced rather than rebuilt in place.
+            m_CurrentPyramid.clear();
+            BuildPyramid(m_CurrentFrame, m_CurrentPyramid);
         }
 
         m_Settings = settings;
@@ -99,68 +122,137 @@ namespace lvk
         m_TrackingStability = 0.0f;
         m_TrackedFeatures.clear();
         m_FeatureDetector.reset();
+        m_MotionEstimator.reset();
         m_FrameInitialized = false;
         m_OptimizedMesh = Eigen::VectorXf::Zero(m_Settings.motion_resolution.area() * 2);
 	}
 
 //---------------------------------------------------------------------------------------------------------------------
 
-    std::optional<WarpMesh> FrameTracker::track(const cv::UMat& next_frame)
+    bool FrameTracker::track(const cv::UMat& next_frame, WarpMesh& motion)
 	{
 		LVK_ASSERT(!next_frame.empty() && next_frame.type() == CV_8UC1);
 
-        // Reset tracking metrics
-        m_TrackingStability = 0.0f;
+        // Advance time and import the next frame.
+        std::swap(m_PreviousFrame, m_CurrentFrame);
+        std::swap(m_PreviousPyramid, m_CurrentPyramid);
+        cv::resize(next_frame, m_CurrentFrame, m_Settings.detection_resolution, 0, 0, cv::INTER_AREA);
+        if(!m_Settings.use_phase_correlation)
+            BuildPyramid(m_CurrentFrame, m_CurrentPyramid);
+
+        return track_current_frame(motion);
+	}
+
+//---------------------------------------------------------------------------------------------------------------------
+
+    bool FrameTracker::track(const VideoFrame& next_frame, WarpMesh& motion)
+	{
+		LVK_ASSERT(!next_frame.empty() && next_frame.has_known_format());
 
         // Advance time and import the next frame.
         std::swap(m_PreviousFrame, m_CurrentFrame);
+        std::swap(m_PreviousPyramid, m_CurrentPyramid);
+        downscale_luma(next_frame, m_CurrentFrame, m_Settings.detection_resolution);
+        if(!m_Settings.use_phase_correlation)
+            BuildPyramid(m_CurrentFrame, m_CurrentPyramid);
+
+        return track_current_frame(motion);
+	}
+
+//---------------------------------------------------------------------------------------------------------------------
+
+    bool FrameTracker::track(const cv::UMat& next_frame, const std::vector<cv::Mat>& next_pyramid, WarpMesh& motion)
+    {
+        LVK_ASSERT(!next_frame.empty() && next_frame.type() == CV_8UC1);
+        LVK_ASSERT(!next_pyramid.empty() && next_pyramid.front().size() == m_Settings.detection_resolution);
+
+        // Advance time and import the next frame, sharing the given pyramid.
+        std::swap(m_PreviousFrame, m_CurrentFrame);
+        std::swap(m_PreviousPyramid, m_CurrentPyramid);
         cv::resize(next_frame, m_CurrentFrame, m_Settings.detection_resolution, 0, 0, cv::INTER_AREA);
+        m_CurrentPyramid.assign(next_pyramid.begin(), next_pyramid.end());
+
+        return track_current_frame(motion);
+    }
+
+//---------------------------------------------------------------------------------------------------------------------
+
+    void FrameTracker::BuildPyramid(const cv::UMat& frame, std::vector<cv::Mat>& pyramid)
+    {
+        LVK_ASSERT(!frame.empty() && frame.type() == CV_8UC1);
+
+        // NOTE: the frame is copied into the bordered base level, so the mapping ends here.
+        const cv::Mat host_frame = frame.getMat(cv::ACCESS_READ);
+        cv::buildOpticalFlowPyramid(
+            host_frame,
+            pyramid,
+            OPTICAL_TRACKER_WIN_SIZE,
+            OPTICAL_TRACKER_PYR_LEVELS,
+            true,
+            cv::BORDER_REFLECT_101,
+            cv::BORDER_CONSTANT,
+            false
+        );
+    }
+
+//---------------------------------------------------------------------------------------------------------------------
+
+    bool FrameTracker::track_current_frame(WarpMesh& motion)
+	{
+        // Reset tracking metrics
+        m_TrackingStability = 0.0f;
+
+        if(m_Settings.use_phase_correlation)
+        {
+            // Phase correlation works on floating point frames.
+            std::swap(m_PreviousCorrelationFrame, m_CurrentCorrelationFrame);
+            m_CurrentFrame.convertTo(m_CurrentCorrelationFrame, CV_32F);
+            m_TrackedFeatures.clear();
+        }
 
         // We need at least two frames for tracking.
         if(!m_FrameInitialized || m_CurrentFrame.size() != m_PreviousFrame.size())
         {
             m_FrameInitialized = true;
-            return std::nullopt;
+            return false;
         }
 
+        if(m_Settings.use_phase_correlation)
+            return correlate_motion(motion);
+
         // Detect features in the current frame.
         const auto distribution = m_FeatureDetector.detect(m_CurrentFrame, m_TrackedFeatures);
         if(m_TrackedFeatures.size() < m_Settings.min_motion_samples || distribution < m_Settings.uniformity_threshold)
         {
             m_TrackedFeatures.clear();
-            return std::nullopt;
+            return false;
         }
 
-        // Convert features to tracking points
-        m_TrackedPoints.clear();
-        for(const auto& feature : m_TrackedFeatures)
-            m_TrackedPoints.emplace_back(feature.pt);
-
 		// Match tracking points.
         m_OpticalTracker->calc(
-            m_PreviousFrame,
-            m_CurrentFrame,
-            m_TrackedPoints,
+            m_PreviousPyramid,
+            m_CurrentPyramid,
+            m_TrackedFeatures.points(),
             m_MatchedPoints,
             m_MatchStatus
         );
 
         // Filter out unmatched points
-        fast_filter(m_TrackedFeatures, m_TrackedPoints, m_MatchedPoints, m_MatchStatus);
+        m_TrackedFeatures.compact(m_MatchStatus, m_MatchedPoints);
         if(m_MatchedPoints.size() < m_Settings.min_motion_samples)
         {
             m_TrackedFeatures.clear();
-            return std::nullopt;
+            return false;
         }
 
         // Estimate motion using the tracking results
-        WarpMesh motion(m_Settings.motion_resolution);
+        motion.resize(m_Settings.motion_resolution);
         if(m_Settings.track_local_motions)
         {
             estimate_local_motions(
                 motion,
                 m_TrackingRegion,
-                m_TrackedPoints, m_MatchedPoints,
+                m_TrackedFeatures.points(), m_MatchedPoints,
                 m_InlierStatus
             );
         }
@@ -170,7 +262,7 @@ namespace lvk
                 motion,
                 distribution > HOMOGRAPHY_DISTRIBUTION_THRESHOLD,
                 m_TrackingRegion,
-                m_TrackedPoints, m_MatchedPoints,
+                m_TrackedFeatures.points(), m_MatchedPoints,
                 m_InlierStatus
             );
         }
@@ -180,21 +272,94 @@ namespace lvk
 
         // Filter outliers so we're left with only high quality points,
         // then propagate them so that they're re-used in the detector.
-        for(int i = m_InlierStatus.size() - 1; i >= 0; i--)
-        {
-            if(m_InlierStatus[i])
-            {
-                // Borrow class id integer to store feature age.
-                m_TrackedFeatures[i].class_id++;
-                m_TrackedFeatures[i].pt = m_MatchedPoints[i];
-            }
-            else fast_erase(m_TrackedFeatures, i);
-        }
+        m_TrackedFeatures.compact(m_InlierStatus, m_MatchedPoints);
+        m_TrackedFeatures.advance(m_MatchedPoints);
         m_FeatureDetector.propagate(m_TrackedFeatures);
 
-        return std::move(motion);
+        return true;
 	}
 
+//---------------------------------------------------------------------------------------------------------------------
+
+    bool FrameTracker::correlate_motion(WarpMesh& motion)
+    {
+        const cv::Size frame_size = m_CurrentCorrelationFrame.size();
+        if(m_PreviousCorrelationFrame.size() != frame_size)
+            return false;
+
+        if(m_CorrelationWindow.size() != frame_size)
+            cv::createHanningWindow(m_CorrelationWindow, frame_size, CV_32F);
+
+        // Estimate the global translation between the frames.
+        double response = 0.0;
+        const cv::Point2f translation = cv::phaseCorrelate(
+            m_PreviousCorrelationFrame,
+            m_CurrentCorrelationFrame,
+            m_CorrelationWindow,
+            &response
+        );
+
+        // The peak response measures how much of the frame agrees with the translation,
+        // but natural footage rarely peaks near 1, so it is rescaled to an inlier ratio.
+        m_TrackingStability = static_cast<float>(std::clamp(
+            (response - CORRELATION_RESPONSE_FLOOR) / (CORRELATION_RESPONSE_RELIABLE - CORRELATION_RESPONSE_FLOOR),
+            0.0, 1.0
+        ));
+
+        const cv::Size2f region_size = m_TrackingRegion.size();
+        motion.resize(m_Settings.motion_resolution);
+        motion.set_to(cv::Point2f(translation.x / region_size.width, translation.y / region_size.height));
+
+        // Optionally correlate a tile around each mesh vertex, to find coarse local translations.
+        const cv::Size mesh_size = motion.size(), grid_size = mesh_size - cv::Size(1, 1);
+        const cv::Size tile_size(frame_size.width / grid_size.width, frame_size.height / grid_size.height);
+        if(!m_Settings.correlate_tiles || mesh_size == WarpMesh::MinimumSize
+            || tile_size.width < MIN_CORRELATION_TILE_SIZE || tile_size.height < MIN_CORRELATION_TILE_SIZE)
+            return true;
+
+        if(m_TileCorrelationWindow.size() != tile_size)
+            cv::createHanningWindow(m_TileCorrelationWindow, tile_size, CV_32F);
+
+        auto& offsets = motion.offsets();
+        cv::parallel_for_(cv::Range(0, mesh_size.area()), [&](const cv::Range& range){
+            for(int i = range.start; i < range.end; i++)
+            {
+                const cv::Point vertex(i % mesh_size.width, i / mesh_size.width);
+
+                // Centre the tile on the vertex, shifting it back within the frame.
+                const cv::Point tile_centre(
+                    vertex.x * frame_size.width / grid_size.width,
+                    vertex.y * frame_size.height / grid_size.height
+                );
+                const cv::Rect tile(
+                    std::clamp(tile_centre.x - tile_size.width / 2, 0, frame_size.width - tile_size.width),
+                    std::clamp(tile_centre.y - tile_size.height / 2, 0, frame_size.height - tile_size.height),
+                    tile_size.width,
+                    tile_size.height
+                );
+
+                double tile_response = 0.0;
+                const cv::Point2f tile_translation = cv::phaseCorrelate(
+                    m_PreviousCorrelationFrame(tile),
+                    m_CurrentCorrelationFrame(tile),
+                    m_TileCorrelationWindow,
+                    &tile_response
+                );
+
+                // NOTE: we invert the motion as the warp is specified backwards.
+                if(tile_response >= MIN_TILE_CORRELATION_RESPONSE)
+                {
+                    offsets.at<cv::Point2f>(vertex) = cv::Point2f(
+                        -tile_translation.x / region_size.width,
+                        -tile_translation.y / region_size.height
+                    );
+                }
+            }
+        });
+
+        return true;
+    }
+
 //---------------------------------------------------------------------------------------------------------------------
 
     void FrameTracker::estimate_local_motions(
@@ -334,44 +499,18 @@ namespace lvk
         LVK_ASSERT(tracked_points.size() == matched_points.size());
         LVK_ASSERT(tracked_points.size() >= 4);
 
-        cv::UsacParams params;
-        params.threshold = m_Settings.acceptance_threshold;
-        params.confidence = 0.99;
-        params.maxIterations = 50;
-        params.sampler = cv::SAMPLING_UNIFORM;
-        params.score = cv::SCORE_METHOD_MAGSAC;
-        params.loMethod = cv::LOCAL_OPTIM_SIGMA;
-        params.loIterations = 10;
-        params.loSampleSize = 20;
-        params.final_polisher = cv::MAGSAC;
-        params.final_polisher_iterations = 0;
-
-        if(homography)
-        {
-            motion_mesh.set_to(
-                Homography(cv::findHomography(
-                    tracked_points,
-                    matched_points,
-                    inlier_status,
-                    params
-                )),
-                region.size()
-            );
-        }
-        else
-        {
-            motion_mesh.set_to(
-                Homography::FromAffineMatrix(cv::estimateAffinePartial2D(
-                    tracked_points,
-                    matched_points,
-                    inlier_status,
-                    cv::RANSAC,
-                    params.threshold,
-                    params.maxIterations
-                )),
-                region.size()
-            );
-        }
+        // NOTE: the estimator is seeded with the last motion, which makes it
+        // terminate very early when the motion is smooth between frames.
+        const auto motion = m_MotionEstimator.estimate(
+            tracked_points,
+            matched_points,
+            inlier_status,
+            homography
+        );
+
+        // If no motion was found, all points are outliers so the
+        // tracking stability will signal the failure to the user.
+        motion_mesh.set_to(motion.value_or(Homography::Identity()), region.size());
     }
 
 
@@ -479,7 +618,7 @@ namespace lvk
 
 //---------------------------------------------------------------------------------------------------------------------
 
-	const std::vector<cv::KeyPoint>& FrameTracker::features() const
+	const FeatureTrackSet& FrameTracker::features() const
 	{
 		return m_TrackedFeatures;
 	}
@@ -491,13 +630,9 @@ namespace lvk
         LVK_ASSERT(thickness > 0);
         LVK_ASSERT(size > 0);
 
-        std::vector<cv::Point2f> tracking_points;
-        tracking_points.reserve(m_TrackedFeatures.size());
-        cv::KeyPoint::convert(m_TrackedFeatures, tracking_points);
-
         draw_crosses(
             dst,
-            tracking_points,
+            m_TrackedFeatures.points(),
             colour,
             size, 4,
             cv::Size2f(dst.size()) / cv::Size2f(m_Settings.detection_resolution)
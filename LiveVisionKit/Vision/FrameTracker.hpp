@@ -22,6 +22,8 @@
 #include "Utility/Configurable.hpp"
 #include "FeatureDetector.hpp"
 #include "Math/WarpMesh.hpp"
+#include "Math/MotionEstimator.hpp"
+#include "Data/VideoFrame.hpp"
 #include "Eigen/Geometry"
 #include "Eigen/Sparse"
 
@@ -41,6 +43,11 @@ namespace lvk
         size_t min_motion_samples = 75;
         float acceptance_threshold = 8.0f;
         float uniformity_threshold = 0.20f;
+
+        // Phase Correlation Backend
+        // NOTE: only tracks translations, but is far cheaper than feature tracking.
+        bool use_phase_correlation = false;
+        bool correlate_tiles = false;
     };
 
 	class FrameTracker final : public Configurable<FrameTrackerSettings>
@@ -51,7 +58,21 @@ namespace lvk
 
         void configure(const FrameTrackerSettings& settings) override;
 
-		std::optional<WarpMesh> track(const cv::UMat& next_frame);
+        // NOTE: the motion is written into the given mesh, which is resized to the motion
+        // resolution so that it can be reused between frames. Returns false on failure.
+		bool track(const cv::UMat& next_frame, WarpMesh& motion);
+
+        // NOTE: accepts frames of any format, which are downscaled and
+        // converted to luma in one pass without a full resolution GRAY frame.
+		bool track(const VideoFrame& next_frame, WarpMesh& motion);
+
+        // NOTE: the pyramid must be built from the frame by BuildPyramid, so that
+        // the optical tracker uses it directly instead of building its own. Its
+        // buffers are referenced until the next frame after it has been tracked.
+        bool track(const cv::UMat& next_frame, const std::vector<cv::Mat>& next_pyramid, WarpMesh& motion);
+
+        // NOTE: builds the pyramid, with derivatives, used by the optical tracker.
+        static void BuildPyramid(const cv::UMat& frame, std::vector<cv::Mat>& pyramid);
 
 		void restart();
 
@@ -61,12 +82,16 @@ namespace lvk
 
         const cv::Size& tracking_resolution() const;
 
-		const std::vector<cv::KeyPoint>& features() const;
+		const FeatureTrackSet& features() const;
 
         void draw_trackers(cv::UMat& dst, const cv::Scalar& color, const int size = 10, const int thickness = 3) const;
 
     private:
 
+        bool track_current_frame(WarpMesh& motion);
+
+        bool correlate_motion(WarpMesh& motion);
+
         int generate_mesh_constraints(
             const cv::Rect2f& region,
             const cv::Size& mesh_size,
@@ -93,15 +118,20 @@ namespace lvk
     private:
         bool m_FrameInitialized = false;
         cv::UMat m_PreviousFrame, m_CurrentFrame;
+        std::vector<cv::Mat> m_PreviousPyramid, m_CurrentPyramid;
 
         FeatureDetector m_FeatureDetector;
-        std::vector<cv::KeyPoint> m_TrackedFeatures;
-        std::vector<cv::Point2f> m_TrackedPoints, m_MatchedPoints;
+        FeatureTrackSet m_TrackedFeatures;
+        std::vector<cv::Point2f> m_MatchedPoints;
 
         cv::Rect2f m_TrackingRegion;
         float m_TrackingStability = 0;
 		std::vector<uint8_t> m_MatchStatus, m_InlierStatus;
         cv::Ptr<cv::SparsePyrLKOpticalFlow> m_OpticalTracker = nullptr;
+        MotionEstimator m_MotionEstimator;
+
+        cv::Mat m_PreviousCorrelationFrame, m_CurrentCorrelationFrame;
+        cv::Mat m_CorrelationWindow, m_TileCorrelationWindow;
 
         Eigen::VectorXf m_OptimizedMesh;
         std::vector<Eigen::Triplet<float>> m_MeshConstraints;
@@ -0,0 +1,328 @@
+//     *************************** LiveVisionKit ****************************
+//     Copyright (C) 2022  Sebastian Di Marco (crowsinc.dev@gmail.com)
+//
+//     This program is free software: you can redistribute it and/or modify
+//     it under the terms of the GNU General Public License as published by
+//     the Free Software Foundation, either version 3 of the License, or
+//     (at your option) any later version.
+//
+//     This program is distributed in the hope that it will be useful,
+//     but WITHOUT ANY WARRANTY; without even the implied warranty of
+//     MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//     GNU General Public License for more details.
+//
+//     You should have received a copy of the GNU General Public License
+//     along with this program.  If not, see <https://www.gnu.org/licenses/>.
+//     **********************************************************************
+
+#include "GyroMotionSource.hpp"
+
+#include <fstream>
+#include <sstream>
+#include <algorithm>
+#include <cctype>
+
+#include "Directives.hpp"
+
+namespace lvk
+{
+
+//---------------------------------------------------------------------------------------------------------------------
+
+    constexpr double NANOSECONDS_PER_SECOND = 1e9;
+    constexpr double NANOSECONDS_PER_MILLISECOND = 1e6;
+
+    // Half of the frame width, for a 90 degree horizontal field of view.
+    constexpr double ASSUMED_FOCAL_RATIO = 0.5;
+
+//---------------------------------------------------------------------------------------------------------------------
+
+    GyroMotionSource::GyroMotionSource(const GyroMotionSourceSettings& settings)
+    {
+        configure(settings);
+    }
+
+//---------------------------------------------------------------------------------------------------------------------
+
+    void GyroMotionSource::configure(const GyroMotionSourceSettings& settings)
+    {
+        LVK_ASSERT(settings.camera_parameters.camera_matrix.size() == cv::Size(3, 3));
+        LVK_ASSERT(settings.camera_parameters.camera_matrix.type() == CV_64FC1);
+        LVK_ASSERT(settings.calibration_resolution.width >= 0 && settings.calibration_resolution.height >= 0);
+        LVK_ASSERT(settings.gyro_time_scale > 0.0);
+        LVK_ASSERT(settings.gyro_rate_scale > 0.0);
+
+        m_Settings = settings;
+    }
+
+//---------------------------------------------------------------------------------------------------------------------
+
+    static std::optional<double> parse_number(const std::string& text)
+    {
+        if(text.empty()) return std::nullopt;
+
+        char* end = nullptr;
+        const double value = std::strtod(text.c_str(), &end);
+        return end == text.c_str() + text.size() ? std::optional(value) : std::nullopt;
+    }
+
+//---------------------------------------------------------------------------------------------------------------------
+
+    // NOTE: Gyroflow orientations name the gyro axis of each camera axis, where
+    // upper case letters are the positive axis and lower case are the negative.
+    static std::optional<cv::Matx33d> parse_orientation(const std::string& text)
+    {
+        if(text.size() != 3) return std::nullopt;
+
+        cv::Matx33d orientation = cv::Matx33d::zeros();
+        for(int i = 0; i < 3; i++)
+        {
+            const char axis = text[i];
+            const int index = std::tolower(axis) - 'x';
+            if(index < 0 || index > 2)
+                return std::nullopt;
+
+            orientation(i, index) = std::isupper(axis) ? 1.0 : -1.0;
+        }
+        return orientation;
+    }
+
+//---------------------------------------------------------------------------------------------------------------------
+
+    bool GyroMotionSource::load(const std::filesystem::path& path)
+    {
+        std::ifstream stream(path);
+        if(!stream.good())
+            return false;
+
+        // NOTE: Gyroflow logs specify their own units and orientation as
+        // metadata rows, which override those given in the settings.
+        double time_scale = m_Settings.gyro_time_scale;
+        double rate_scale = m_Settings.gyro_rate_scale;
+        cv::Matx33d orientation = cv::Matx33d::eye();
+
+        std::vector<GyroSample> samples;
+        std::vector<std::string> fields;
+        std::string line, field;
+        while(std::getline(stream, line))
+        {
+            if(!line.empty() && line.back() == '\r')
+                line.pop_back();
+
+            fields.clear();
+            std::stringstream line_stream(line);
+            while(std::getline(line_stream, field, ','))
+                fields.push_back(field);
+
+            if(fields.empty())
+                continue;
+
+            // Data rows start with the timestamp, anything else is metadata or a header.
+            if(const auto time = parse_number(fields[0]); time.has_value())
+            {
+                if(fields.size() < 4) continue;
+
+                const auto gx = parse_number(fields[1]);
+                const auto gy = parse_number(fields[2]);
+                const auto gz = parse_number(fields[3]);
+                if(!gx.has_value() || !gy.has_value() || !gz.has_value() || *time < 0.0)
+                    continue;
+
+                samples.push_back({
+                    static_cast<uint64_t>(*time * time_scale * NANOSECONDS_PER_SECOND),
+                    orientation * (cv::Vec3d(*gx, *gy, *gz) * rate_scale)
+                });
+            }
+            else if(fields.size() >= 2)
+            {
+                if(fields[0] == "tscale")
+                    time_scale = parse_number(fields[1]).value_or(time_scale);
+                else if(fields[0] == "gscale")
+                    rate_scale = parse_number(fields[1]).value_or(rate_scale);
+                else if(fields[0] == "orientation")
+                    orientation = parse_orientation(fields[1]).value_or(orientation);
+            }
+        }
+
+        if(samples.size() < 2)
+            return false;
+
+        std::stable_sort(samples.begin(), samples.end(), [](const GyroSample& a, const GyroSample& b){
+            return a.timestamp < b.timestamp;
+        });
+
+        m_Samples = std::move(samples);
+        m_LastTimestamp.reset();
+        return true;
+    }
+
+//---------------------------------------------------------------------------------------------------------------------
+
+    void GyroMotionSource::add_sample(const GyroSample& sample)
+    {
+        LVK_ASSERT(m_Samples.empty() || m_Samples.back().timestamp <= sample.timestamp);
+
+        m_Samples.push_back(sample);
+    }
+
+//---------------------------------------------------------------------------------------------------------------------
+
+    void GyroMotionSource::clear()
+    {
+        m_Samples.clear();
+        m_LastTimestamp.reset();
+    }
+
+//---------------------------------------------------------------------------------------------------------------------
+
+    bool GyroMotionSource::next(
+        const uint64_t timestamp,
+        const cv::Size& frame_size,
+        WarpMesh& motion
+    )
+    {
+        LVK_ASSERT(frame_size.width > 0 && frame_size.height > 0);
+
+        if(m_Samples.size() < 2)
+            return false;
+
+        // Find the frame time on the gyro clock.
+        const auto sync_offset = static_cast<int64_t>(m_Settings.gyro_sync_offset_ms * NANOSECONDS_PER_MILLISECOND);
+        const int64_t gyro_time = static_cast<int64_t>(timestamp) - sync_offset;
+
+        const auto last_timestamp = m_LastTimestamp;
+        if(gyro_time < static_cast<int64_t>(m_Samples.front().timestamp)
+            || gyro_time > static_cast<int64_t>(m_Samples.back().timestamp))
+        {
+            m_LastTimestamp.reset();
+            return false;
+        }
+        m_LastTimestamp = static_cast<uint64_t>(gyro_time);
+
+        if(!last_timestamp.has_value() || *last_timestamp >= *m_LastTimestamp)
+            return false;
+
+        // A pure camera rotation R maps the previous view onto the next by K * R^T * K^-1.
+        const cv::Matx33d rotation = integrate_rotation(*last_timestamp, *m_LastTimestamp);
+        const cv::Matx33d intrinsics = camera_matrix(frame_size);
+        const cv::Matx33d homography = intrinsics * rotation.t() * intrinsics.inv();
+
+        motion.set_to(Homography(homography), frame_size);
+        return true;
+    }
+
+//---------------------------------------------------------------------------------------------------------------------
+
+    void GyroMotionSource::restart()
+    {
+        m_LastTimestamp.reset();
+    }
+
+//---------------------------------------------------------------------------------------------------------------------
+
+    bool GyroMotionSource::empty() const
+    {
+        return m_Samples.empty();
+    }
+
+//---------------------------------------------------------------------------------------------------------------------
+
+    size_t GyroMotionSource::sample_count() const
+    {
+        return m_Samples.size();
+    }
+
+//---------------------------------------------------------------------------------------------------------------------
+
+    cv::Vec3d GyroMotionSource::rate_at(const uint64_t timestamp) const
+    {
+        const auto upper = std::lower_bound(
+            m_Samples.begin(), m_Samples.end(), timestamp,
+            [](const GyroSample& sample, const uint64_t time){
+                return sample.timestamp < time;
+            }
+        );
+
+        if(upper == m_Samples.begin()) return m_Samples.front().rate;
+        if(upper == m_Samples.end()) return m_Samples.back().rate;
+
+        // Linearly interpolate between the surrounding samples.
+        const auto lower = upper - 1;
+        const double span = static_cast<double>(upper->timestamp - lower->timestamp);
+        const double t = span > 0.0 ? static_cast<double>(timestamp - lower->timestamp) / span : 0.0;
+
+        return lower->rate * (1.0 - t) + upper->rate * t;
+    }
+
+//---------------------------------------------------------------------------------------------------------------------
+
+    cv::Matx33d GyroMotionSource::integrate_rotation(const uint64_t start_time, const uint64_t end_time) const
+    {
+        LVK_ASSERT(start_time <= end_time);
+
+        auto sample = std::upper_bound(
+            m_Samples.begin(), m_Samples.end(), start_time,
+            [](const uint64_t time, const GyroSample& sample){
+                return time < sample.timestamp;
+            }
+        );
+
+        // Integrate each interval between the samples with the trapezoidal rule.
+        cv::Matx33d rotation = cv::Matx33d::eye(), step;
+        uint64_t time = start_time;
+        cv::Vec3d rate = rate_at(start_time);
+        while(time < end_time)
+        {
+            const uint64_t next_time = (sample != m_Samples.end() && sample->timestamp < end_time)
+                                     ? (sample++)->timestamp : end_time;
+            const cv::Vec3d next_rate = rate_at(next_time);
+
+            const double delta = static_cast<double>(next_time - time) / NANOSECONDS_PER_SECOND;
+            const cv::Vec3d angle = m_Settings.imu_orientation * ((rate + next_rate) * (0.5 * delta));
+
+            cv::Rodrigues(angle, step);
+            rotation = rotation * step;
+
+            time = next_time;
+            rate = next_rate;
+        }
+
+        return rotation;
+    }
+
+//---------------------------------------------------------------------------------------------------------------------
+
+    cv::Matx33d GyroMotionSource::camera_matrix(const cv::Size& frame_size) const
+    {
+        const cv::Matx33d calibration = m_Settings.camera_parameters.camera_matrix;
+        const auto width = static_cast<double>(frame_size.width);
+        const auto height = static_cast<double>(frame_size.height);
+
+        if(calibration == cv::Matx33d::eye())
+        {
+            const double focal_length = ASSUMED_FOCAL_RATIO * width;
+            return {
+                focal_length, 0.0, 0.5 * width,
+                0.0, focal_length, 0.5 * height,
+                0.0, 0.0, 1.0
+            };
+        }
+
+        // Scale the intrinsics from the calibration resolution to the frame.
+        cv::Matx33d intrinsics = calibration;
+        if(m_Settings.calibration_resolution.area() > 0)
+        {
+            const double scale_x = width / m_Settings.calibration_resolution.width;
+            const double scale_y = height / m_Settings.calibration_resolution.height;
+            for(int c = 0; c < 3; c++)
+            {
+                intrinsics(0, c) *= scale_x;
+                intrinsics(1, c) *= scale_y;
+            }
+        }
+        return intrinsics;
+    }
+
+//---------------------------------------------------------------------------------------------------------------------
+
+}
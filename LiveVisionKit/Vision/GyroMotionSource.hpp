@@ -0,0 +1,103 @@
+//     *************************** LiveVisionKit ****************************
+//     Copyright (C) 2022  Sebastian Di Marco (crowsinc.dev@gmail.com)
+//
+//     This program is free software: you can redistribute it and/or modify
+//     it under the terms of the GNU General Public License as published by
+//     the Free Software Foundation, either version 3 of the License, or
+//     (at your option) any later version.
+//
+//     This program is distributed in the hope that it will be useful,
+//     but WITHOUT ANY WARRANTY; without even the implied warranty of
+//     MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//     GNU General Public License for more details.
+//
+//     You should have received a copy of the GNU General Public License
+//     along with this program.  If not, see <https://www.gnu.org/licenses/>.
+//     **********************************************************************
+
+#pragma once
+
+#include <vector>
+#include <optional>
+#include <filesystem>
+#include <opencv2/opencv.hpp>
+
+#include "CameraCalibrator.hpp"
+#include "Math/WarpMesh.hpp"
+#include "Utility/Configurable.hpp"
+
+namespace lvk
+{
+
+    struct GyroSample
+    {
+        uint64_t timestamp = 0; // nanoseconds
+        cv::Vec3d rate; // radians per second
+    };
+
+    struct GyroMotionSourceSettings
+    {
+        // NOTE: the camera matrix is in pixels of the calibration resolution, which
+        // is assumed to be the frame resolution if empty. If no calibration is given,
+        // an action camera with a 90 degree horizontal field of view is assumed.
+        CameraParameters camera_parameters;
+        cv::Size calibration_resolution = {0, 0};
+
+        // Rotates the gyro axes into the camera axes (x right, y down, z forward).
+        cv::Matx33d imu_orientation = cv::Matx33d::eye();
+
+        // Added to the gyro timestamps to synchronize them with the video.
+        double gyro_sync_offset_ms = 0.0;
+
+        // Unit scaling of generic CSV logs, to seconds and radians per second.
+        double gyro_time_scale = 1.0;
+        double gyro_rate_scale = 1.0;
+    };
+
+    // NOTE: Derives the camera motion from a gyro log instead of the frames. The rotation
+    // between consecutive frame timestamps is integrated from the gyro samples and then
+    // projected through the camera intrinsics as a homography. Lens distortion and
+    // rolling shutter are not modelled, and translations cannot be observed.
+    class GyroMotionSource final : public Configurable<GyroMotionSourceSettings>
+    {
+    public:
+
+        explicit GyroMotionSource(const GyroMotionSourceSettings& settings = {});
+
+        void configure(const GyroMotionSourceSettings& settings) override;
+
+        // NOTE: supports generic 'time,gx,gy,gz' CSV logs and Gyroflow .gcsv exports.
+        bool load(const std::filesystem::path& path);
+
+        void add_sample(const GyroSample& sample);
+
+        void clear();
+
+        // Writes the motion since the last frame into the given mesh, at its
+        // current resolution. Returns false if the log does not cover both timestamps.
+        bool next(
+            const uint64_t timestamp,
+            const cv::Size& frame_size,
+            WarpMesh& motion
+        );
+
+        void restart();
+
+        bool empty() const;
+
+        size_t sample_count() const;
+
+    private:
+
+        cv::Vec3d rate_at(const uint64_t timestamp) const;
+
+        cv::Matx33d integrate_rotation(const uint64_t start_time, const uint64_t end_time) const;
+
+        cv::Matx33d camera_matrix(const cv::Size& frame_size) const;
+
+    private:
+        std::vector<GyroSample> m_Samples;
+        std::optional<uint64_t> m_LastTimestamp;
+    };
+
+}
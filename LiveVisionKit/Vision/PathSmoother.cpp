@@ -24,6 +24,16 @@
 namespace lvk
 {
 
+//---------------------------------------------------------------------------------------------------------------------
+
+    constexpr size_t MAX_LOOK_AHEAD_SAMPLES = 3;
+
+    // NOTE: only the ratio of the noises matters, as every vertex shares the
+    // same model. The process noise is further reduced by the smoothing factor.
+    constexpr double CAUSAL_PROCESS_NOISE = 0.05;
+    constexpr double CAUSAL_MEASUREMENT_NOISE = 1.0;
+    constexpr double CAUSAL_INITIAL_VARIANCE = 1000.0;
+
 //---------------------------------------------------------------------------------------------------------------------
 
 	PathSmoother::PathSmoother(const PathSmootherSettings& settings)
@@ -42,6 +52,7 @@ namespace lvk
         LVK_ASSERT(settings.predictive_samples > 0);
         LVK_ASSERT(settings.smoothing_steps > 0.0f);
         LVK_ASSERT_01(settings.response_rate);
+        LVK_ASSERT(settings.look_ahead_samples <= MAX_LOOK_AHEAD_SAMPLES);
 
         // Update motion resolution.
         if(m_Position.size() != settings.motion_resolution)
@@ -49,23 +60,36 @@ namespace lvk
             m_Trajectory.fill(settings.motion_resolution);
             m_Trace = WarpMesh(settings.motion_resolution);
             m_Position = WarpMesh(settings.motion_resolution);
+            m_Correction = WarpMesh(settings.motion_resolution);
+            m_LatestPosition = WarpMesh(settings.motion_resolution);
+            m_FilterPosition = WarpMesh(settings.motion_resolution);
+            m_FilterVelocity = WarpMesh(settings.motion_resolution);
         }
 
         // Update trajectory sizing.
-        if(const auto window_size = 2 * settings.predictive_samples + 1; m_Trajectory.size() != window_size)
+        // NOTE: the low latency mode only needs to hold the look-ahead samples.
+        const auto window_size = settings.low_latency ? settings.look_ahead_samples + 1
+                                                      : 2 * settings.predictive_samples + 1;
+        if(m_Trajectory.size() != window_size || settings.low_latency != m_Settings.low_latency)
         {
             // The trajectory is held in a circular buffer representing a windowed view on the
             // full path. The size of the window is based on the number of predictive samples
             // and is symmetrical with the center element, representing the current position.
             // When resizing, always pad the front to avoid invalid time-shifts in the data.
-            m_Trajectory.resize(2 * settings.predictive_samples + 1);
+            m_Trajectory.resize(window_size);
             m_Trajectory.pad_front(settings.motion_resolution);
+            m_SmoothingKernel.resize(window_size);
 
-            // Reset the current position tracker.
-            m_Position = m_Trajectory.oldest();
-            for(size_t i = 1; i <= m_Trajectory.centre_index(); i++)
+            if(settings.low_latency)
+                reset_causal_filter();
+            else
             {
-                m_Position += m_Trajectory[i];
+                // Reset the current position tracker.
+                m_Position = m_Trajectory.oldest();
+                for(size_t i = 1; i <= m_Trajectory.centre_index(); i++)
+                {
+                    m_Position += m_Trajectory[i];
+                }
             }
 
             // Adjust the base factor to stay consistent with different sample counts.
@@ -81,36 +105,21 @@ namespace lvk
 
 //---------------------------------------------------------------------------------------------------------------------
 
-    WarpMesh PathSmoother::next(const WarpMesh& motion)
+    const WarpMesh& PathSmoother::next(const WarpMesh& motion)
     {
         LVK_ASSERT(motion.size() == m_Settings.motion_resolution);
 
-        // Update the path's current state.
-        m_Position -= m_Trajectory.oldest();
-        m_Trajectory.push(motion);
-        m_Position += m_Trajectory.centre();
+        if(m_Settings.low_latency)
+            update_causal_trace(motion);
+        else
+            update_windowed_trace(motion);
 
-        // Generate adaptive smoothing filter.
-        const cv::Mat filter = cv::getGaussianKernel(
-            static_cast<int>(m_Trajectory.capacity()),
-            m_BaseSmoothingFactor + m_SmoothingFactor,
-            CV_32F
-        );
-
-        // Apply the filter to get smooth path correction.
-        float weight = 1.0f;
-        m_Trace = m_Trajectory.oldest();
-        for(size_t i = 1; i < m_Trajectory.size(); i++)
-        {
-            weight -= filter.at<float>(static_cast<int>(i) - 1);
-            m_Trace.combine(m_Trajectory[i], weight);
-        }
-        auto path_correction = m_Trace - m_Position;
+        m_Correction.evaluate(lazy(m_Trace) - lazy(m_Position));
 
         // Determine how much our smoothed path trace has drifted away from the path,
         // as a percentage of the corrective limits (1.0+ => out of scene bounds).
         float max_drift_error = 0.0f;
-        path_correction.read([&](const cv::Point2f& drift, const cv::Point& coord){
+        m_Correction.read([&](const cv::Point2f& drift, const cv::Point& coord){
             const auto x_drift = std::abs(drift.x) / m_SceneMargins.x;
             const auto y_drift = std::abs(drift.y) / m_SceneMargins.y;
             max_drift_error = std::max(max_drift_error, x_drift);
@@ -120,8 +129,18 @@ namespace lvk
         // Clamp drift within the corrective limits
         if(max_drift_error > 1.0f)
         {
-            path_correction.clamp(m_SceneMargins.tl());
+            m_Correction.clamp(m_SceneMargins.tl());
             max_drift_error = 1.0f;
+
+            // Pull the causal filter back along with the clamped correction,
+            // otherwise it would continue to drift beyond the limits.
+            if(m_Settings.low_latency)
+            {
+                m_FilterPosition.evaluate(
+                    lazy(m_Position) + lazy(m_Correction)
+                        + lazy(m_FilterVelocity) * static_cast<float>(m_Settings.look_ahead_samples)
+                );
+            }
         }
 
         // Adapt the smoothing factor to target a drift of 0.5.
@@ -131,7 +150,96 @@ namespace lvk
             m_Settings.response_rate
         );
 
-        return std::move(path_correction);
+        return m_Correction;
+    }
+
+//---------------------------------------------------------------------------------------------------------------------
+
+    void PathSmoother::update_windowed_trace(const WarpMesh& motion)
+    {
+        // Update the path's current state.
+        m_Position -= m_Trajectory.oldest();
+        m_Trajectory.push(motion);
+        m_Position += m_Trajectory.centre();
+
+        // Generate adaptive gaussian smoothing filter.
+        // NOTE: this is evaluated into the pre-allocated kernel, as the sigma changes every frame.
+        const double sigma = m_BaseSmoothingFactor + m_SmoothingFactor;
+        const double centre = static_cast<double>(m_SmoothingKernel.size() - 1) / 2.0;
+        const double exp_scale = -0.5 / (sigma * sigma);
+
+        double kernel_sum = 0.0;
+        for(size_t i = 0; i < m_SmoothingKernel.size(); i++)
+        {
+            const double x = static_cast<double>(i) - centre;
+            m_SmoothingKernel[i] = static_cast<float>(std::exp(x * x * exp_scale));
+            kernel_sum += m_SmoothingKernel[i];
+        }
+
+        // Apply the normalized filter to get smooth path trace.
+        float weight = 1.0f;
+        m_Trace = m_Trajectory.oldest();
+        for(size_t i = 1; i < m_Trajectory.size(); i++)
+        {
+            weight -= static_cast<float>(m_SmoothingKernel[i - 1] / kernel_sum);
+            m_Trace.combine(m_Trajectory[i], weight);
+        }
+    }
+
+//---------------------------------------------------------------------------------------------------------------------
+
+    void PathSmoother::update_causal_trace(const WarpMesh& motion)
+    {
+        // Update the latest position, then shift all positions to be relative
+        // to the path at the output frame, which is the oldest in the trajectory.
+        m_Trajectory.push(motion);
+        m_LatestPosition.evaluate(lazy(m_LatestPosition) + lazy(motion) - lazy(m_Trajectory.oldest()));
+
+        // Predict the path with a constant velocity Kalman filter, whose process
+        // noise shrinks with the smoothing factor to smooth harder while we can.
+        const double smoothing = 1.0 + m_SmoothingFactor;
+        const double process_noise = CAUSAL_PROCESS_NOISE / (smoothing * smoothing);
+        const cv::Matx22d transition(1.0, 1.0, 0.0, 1.0);
+        const cv::Matx22d covariance = transition * m_FilterCovariance * transition.t()
+                                     + process_noise * cv::Matx22d(0.25, 0.5, 0.5, 1.0);
+        m_FilterPosition.evaluate(lazy(m_FilterPosition) - lazy(m_Trajectory.oldest()) + lazy(m_FilterVelocity));
+
+        // Correct the prediction using the latest position. As all the vertices share
+        // the same noise model, they also share the same covariance and Kalman gains.
+        const double innovation_variance = covariance(0, 0) + CAUSAL_MEASUREMENT_NOISE;
+        const double position_gain = covariance(0, 0) / innovation_variance;
+        const double velocity_gain = covariance(1, 0) / innovation_variance;
+
+        // NOTE: the velocity is corrected first, as both share the innovation of the predicted position.
+        const auto innovation = lazy(m_LatestPosition) - lazy(m_FilterPosition);
+        m_FilterVelocity.evaluate(lazy(m_FilterVelocity) + innovation * static_cast<float>(velocity_gain));
+        m_FilterPosition.evaluate(lazy(m_FilterPosition) + innovation * static_cast<float>(position_gain));
+        m_FilterCovariance = cv::Matx22d(
+            (1.0 - position_gain) * covariance(0, 0), (1.0 - position_gain) * covariance(0, 1),
+            covariance(1, 0) - velocity_gain * covariance(0, 0), covariance(1, 1) - velocity_gain * covariance(0, 1)
+        );
+
+        // Look back from the latest filter state to estimate the smooth path at the output frame.
+        const auto look_ahead = static_cast<float>(m_Settings.look_ahead_samples);
+        m_Trace.evaluate(lazy(m_FilterPosition) - lazy(m_FilterVelocity) * look_ahead);
+    }
+
+//---------------------------------------------------------------------------------------------------------------------
+
+    void PathSmoother::reset_causal_filter()
+    {
+        // The latest position is the path from the output frame to the newest frame.
+        m_LatestPosition.set_identity();
+        for(size_t i = 1; i < m_Trajectory.size(); i++)
+        {
+            m_LatestPosition += m_Trajectory[i];
+        }
+
+        // NOTE: the causal filter keeps all positions relative to the output frame.
+        m_Position.set_identity();
+        m_FilterPosition.set_identity();
+        m_FilterVelocity.set_identity();
+        m_FilterCovariance = CAUSAL_INITIAL_VARIANCE * cv::Matx22d::eye();
     }
 
 //---------------------------------------------------------------------------------------------------------------------
@@ -142,13 +250,14 @@ namespace lvk
         for(auto& motion : m_Trajectory) motion.set_identity();
         m_Position.set_identity();
         m_Trace.set_identity();
+        reset_causal_filter();
     }
 
 //---------------------------------------------------------------------------------------------------------------------
 
     size_t PathSmoother::time_delay() const
     {
-        return m_Settings.predictive_samples;
+        return m_Settings.low_latency ? m_Settings.look_ahead_samples : m_Settings.predictive_samples;
     }
 
 //---------------------------------------------------------------------------------------------------------------------
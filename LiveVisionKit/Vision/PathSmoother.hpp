@@ -17,6 +17,7 @@
 
 #pragma once
 
+#include <vector>
 #include <opencv2/opencv.hpp>
 
 #include "Math/WarpMesh.hpp"
@@ -36,6 +37,12 @@ namespace lvk
         // Smoothing Characteristics
         float smoothing_steps = 20.0f;
         float response_rate = 0.04f;
+
+        // Low Latency Mode
+        // NOTE: replaces the predictive window with a causal filter,
+        // which only delays the output by the look-ahead samples (0-3).
+        bool low_latency = false;
+        size_t look_ahead_samples = 1;
     };
 
     class PathSmoother final : public Configurable<PathSmootherSettings>
@@ -46,7 +53,8 @@ namespace lvk
 
         void configure(const PathSmootherSettings& settings) override;
 
-        WarpMesh next(const WarpMesh& motion);
+        // NOTE: the correction is only valid until the next call.
+        const WarpMesh& next(const WarpMesh& motion);
 
         void restart();
 
@@ -56,12 +64,28 @@ namespace lvk
 
         const cv::Rect2f& scene_margins() const;
 
+    private:
+
+        void update_windowed_trace(const WarpMesh& motion);
+
+        void update_causal_trace(const WarpMesh& motion);
+
+        void reset_causal_filter();
+
     private:
         double m_SmoothingFactor = 0.0f;
         double m_BaseSmoothingFactor = 0.0f;
         StreamBuffer<WarpMesh> m_Trajectory{1};
+        std::vector<float> m_SmoothingKernel;
         WarpMesh m_Trace{WarpMesh::MinimumSize};
         WarpMesh m_Position{WarpMesh::MinimumSize};
+        WarpMesh m_Correction{WarpMesh::MinimumSize};
+
+        // NOTE: the causal filter is relative to the path at the output frame.
+        WarpMesh m_LatestPosition{WarpMesh::MinimumSize};
+        WarpMesh m_FilterPosition{WarpMesh::MinimumSize};
+        WarpMesh m_FilterVelocity{WarpMesh::MinimumSize};
+        cv::Matx22d m_FilterCovariance = cv::Matx22d::eye();
 
         cv::Rect2f m_SceneMargins{0,0,0,0};
         WarpMesh m_SceneCrop{WarpMesh::MinimumSize};
@@ -0,0 +1,140 @@
+//     *************************** LiveVisionKit ****************************
+//     Copyright (C) 2022  Sebastian Di Marco (crowsinc.dev@gmail.com)
+//
+//     This program is free software: you can redistribute it and/or modify
+//     it under the terms of the GNU General Public License as published by
+//     the Free Software Foundation, either version 3 of the License, or
+//     (at your option) any later version.
+//
+//     This program is distributed in the hope that it will be useful,
+//     but WITHOUT ANY WARRANTY; without even the implied warranty of
+//     MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//     GNU General Public License for more details.
+//
+//     You should have received a copy of the GNU General Public License
+//     along with this program.  If not, see <https://www.gnu.org/licenses/>.
+//     **********************************************************************
+
+#include <iostream>
+#include <numeric>
+#include <algorithm>
+#include <utility>
+
+#include "Benchmark.hpp"
+
+// NOTE: these checks require a build with COUNT_ALLOCATIONS=ON, otherwise they are skipped.
+//
+// Once the frame delay is built up, the motion and path stages of the StabilizationFilter must not
+// allocate, which the filter counts itself in timings().stage_allocations. The other stages still
+// allocate on every frame:
+//  - Feature detection and tracking (cv::FAST, cv::buildOpticalFlowPyramid and LK internals).
+//  - Motion estimation (cv::findHomography and the Eigen solvers of the local motions).
+//  - Frame warping (cv::remap and the OpenCL buffer pool of its temporary UMats).
+// These are only bounded, so the filter as a whole is checked for per-frame growth instead.
+// Allocations made by the OpenCV worker threads are not counted, as counting is per-thread.
+namespace bench
+{
+
+//---------------------------------------------------------------------------------------------------------------------
+
+    constexpr size_t ALLOCATION_TEST_FRAMES = 240;
+    constexpr double ALLOCATION_GROWTH_TOLERANCE = 1.1;
+
+//---------------------------------------------------------------------------------------------------------------------
+
+    static bool allocation_counting_supported()
+    {
+        if(!lvk::AllocationCounter::IsSupported())
+            std::cout << "    Skipped, the build does not define COUNT_ALLOCATIONS\n";
+        return lvk::AllocationCounter::IsSupported();
+    }
+
+//---------------------------------------------------------------------------------------------------------------------
+
+    // Records timings().stage_allocations, the motion and path stages of each apply() of the filter.
+    const Registrar stage_allocations("allocations/stabilization-stages", Kind::CHECK, []{
+        if(!allocation_counting_supported()) return true;
+
+        lvk::StabilizationFilterSettings cropped_settings;
+        cropped_settings.crop_to_stable_region = true;
+        cropped_settings.low_latency = true;
+
+        const std::vector<std::pair<const char*, lvk::StabilizationFilterSettings>> configurations = {
+            {"Default", {}},
+            {"Cropped, low latency", cropped_settings}
+        };
+
+        bool passed = true;
+        for(const auto& [name, settings] : configurations)
+        {
+            lvk::SyntheticSource source({.resolution = {640, 360}});
+            lvk::StabilizationFilter filter(settings);
+
+            lvk::VideoFrame input, output;
+            size_t total_allocations = 0, counted_frames = 0;
+            for(size_t i = 0; i < ALLOCATION_TEST_FRAMES; i++)
+            {
+                // Allow the trajectory and correction storage to be allocated during the frame delay.
+                const bool delay_built = filter.ready();
+
+                source.read(input);
+                filter.apply(std::move(input), output);
+
+                if(delay_built)
+                {
+                    total_allocations += filter.timings().stage_allocations.count();
+                    counted_frames++;
+                }
+            }
+
+            std::cout << "    " << name << " stage allocations: " << total_allocations
+                      << " over " << counted_frames << " frames\n";
+
+            passed &= expect(counted_frames > 0, "the filter never built up its frame delay");
+            passed &= expect(total_allocations == 0, "the motion and path stages allocate after the frame delay");
+        }
+        return passed;
+    });
+
+//---------------------------------------------------------------------------------------------------------------------
+
+    // Records timings().allocations for each apply() of the whole filter.
+    const Registrar stabilization_allocations("allocations/stabilization", Kind::CHECK, []{
+        if(!allocation_counting_supported()) return true;
+
+        lvk::SyntheticSource source({.resolution = {1280, 720}});
+        lvk::StabilizationFilter filter;
+
+        lvk::VideoFrame input, output;
+        std::vector<size_t> allocations;
+        for(size_t i = 0; i < ALLOCATION_TEST_FRAMES; i++)
+        {
+            source.read(input);
+            filter.apply(std::move(input), output);
+
+            if(filter.ready())
+                allocations.push_back(filter.timings().allocations.count());
+        }
+
+        if(!expect(allocations.size() >= 2, "the filter never built up its frame delay"))
+            return false;
+
+        // The residual allocations must be bounded, so the second half may not average above the first.
+        const auto middle = allocations.begin() + static_cast<std::ptrdiff_t>(allocations.size() / 2);
+        const double first_half = static_cast<double>(std::accumulate(allocations.begin(), middle, size_t{0}));
+        const double second_half = static_cast<double>(std::accumulate(middle, allocations.end(), size_t{0}));
+        const double first_average = first_half / static_cast<double>(middle - allocations.begin());
+        const double second_average = second_half / static_cast<double>(allocations.end() - middle);
+
+        std::cout << "    Allocations per apply: " << first_average << " -> " << second_average
+                  << " average, " << *std::max_element(allocations.begin(), allocations.end()) << " peak\n";
+
+        return expect(
+            second_average <= first_average * ALLOCATION_GROWTH_TOLERANCE,
+            "stabilization allocations grow from frame to frame"
+        );
+    });
+
+//---------------------------------------------------------------------------------------------------------------------
+
+}
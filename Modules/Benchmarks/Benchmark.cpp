@@ -0,0 +1,94 @@
+//     *************************** LiveVisionKit ****************************
+//     Copyright (C) 2022  Sebastian Di Marco (crowsinc.dev@gmail.com)
+//
+//     This program is free software: you can redistribute it and/or modify
+//     it under the terms of the GNU General Public License as published by
+//     the Free Software Foundation, either version 3 of the License, or
+//     (at your option) any later version.
+//
+//     This program is distributed in the hope that it will be useful,
+//     but WITHOUT ANY WARRANTY; without even the implied warranty of
+//     MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//     GNU General Public License for more details.
+//
+//     You should have received a copy of the GNU General Public License
+//     along with this program.  If not, see <https://www.gnu.org/licenses/>.
+//     **********************************************************************
+
+#include "Benchmark.hpp"
+
+#include <iostream>
+#include <iomanip>
+#include <algorithm>
+
+namespace bench
+{
+
+//---------------------------------------------------------------------------------------------------------------------
+
+    std::vector<Entry>& registry()
+    {
+        // NOTE: function-local so that registrars in other translation units
+        // never run before the registry has been constructed.
+        static std::vector<Entry> entries;
+        return entries;
+    }
+
+//---------------------------------------------------------------------------------------------------------------------
+
+    Registrar::Registrar(std::string name, const Kind kind, std::function<bool()> run)
+    {
+        registry().push_back({std::move(name), kind, std::move(run)});
+    }
+
+//---------------------------------------------------------------------------------------------------------------------
+
+    lvk::Time measure(
+        const std::string& label,
+        const std::function<void()>& operation,
+        const size_t iterations,
+        const size_t warmup
+    )
+    {
+        LVK_ASSERT(iterations > 0);
+
+        // Warm up any caches, kernel compilations and pooled buffers first.
+        for(size_t i = 0; i < warmup; i++)
+            operation();
+        cv::ocl::finish();
+
+        lvk::Stopwatch stopwatch(iterations);
+        for(size_t i = 0; i < iterations; i++)
+        {
+            stopwatch.start();
+            operation();
+            stopwatch.sync_gpu(cv::ocl::useOpenCL()).stop();
+        }
+
+        std::cout << "    " << std::left << std::setw(40) << label << std::right << std::fixed
+                  << std::setprecision(3) << std::setw(10) << stopwatch.average().milliseconds() << "ms  +/- "
+                  << std::setprecision(3) << stopwatch.deviation().milliseconds() << "ms\n";
+
+        return stopwatch.average();
+    }
+
+//---------------------------------------------------------------------------------------------------------------------
+
+    void report(const std::string& label, const lvk::Time& baseline, const lvk::Time& candidate)
+    {
+        const double speedup = baseline.nanoseconds() / std::max(candidate.nanoseconds(), 1.0);
+        std::cout << "    " << std::left << std::setw(40) << label << std::right << std::fixed
+                  << std::setprecision(2) << std::setw(10) << speedup << "x\n";
+    }
+
+//---------------------------------------------------------------------------------------------------------------------
+
+    bool expect(const bool condition, const std::string& message)
+    {
+        if(!condition) std::cerr << "    FAILED: " << message << "\n";
+        return condition;
+    }
+
+//---------------------------------------------------------------------------------------------------------------------
+
+}
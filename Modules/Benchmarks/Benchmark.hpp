@@ -0,0 +1,59 @@
+//     *************************** LiveVisionKit ****************************
+//     Copyright (C) 2022  Sebastian Di Marco (crowsinc.dev@gmail.com)
+//
+//     This program is free software: you can redistribute it and/or modify
+//     it under the terms of the GNU General Public License as published by
+//     the Free Software Foundation, either version 3 of the License, or
+//     (at your option) any later version.
+//
+//     This program is distributed in the hope that it will be useful,
+//     but WITHOUT ANY WARRANTY; without even the implied warranty of
+//     MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//     GNU General Public License for more details.
+//
+//     You should have received a copy of the GNU General Public License
+//     along with this program.  If not, see <https://www.gnu.org/licenses/>.
+//     **********************************************************************
+
+#pragma once
+
+#include <LiveVisionKit.hpp>
+#include <functional>
+#include <string>
+#include <vector>
+
+namespace bench
+{
+
+    enum class Kind {BENCHMARK, CHECK};
+
+    // NOTE: benchmarks only report their timings, while checks return whether
+    // they passed, so that they can be run as tests by ctest via --checks.
+    struct Entry
+    {
+        std::string name;
+        Kind kind = Kind::BENCHMARK;
+        std::function<bool()> run;
+    };
+
+    std::vector<Entry>& registry();
+
+    struct Registrar
+    {
+        Registrar(std::string name, const Kind kind, std::function<bool()> run);
+    };
+
+
+    // Times the operation over the given iterations, after warming up, and prints a report.
+    lvk::Time measure(
+        const std::string& label,
+        const std::function<void()>& operation,
+        const size_t iterations = 100,
+        const size_t warmup = 10
+    );
+
+    void report(const std::string& label, const lvk::Time& baseline, const lvk::Time& candidate);
+
+    bool expect(const bool condition, const std::string& message);
+
+}
@@ -0,0 +1,128 @@
+//     *************************** LiveVisionKit ****************************
+//     Copyright (C) 2022  Sebastian Di Marco (crowsinc.dev@gmail.com)
+//
+//     This program is free software: you can redistribute it and/or modify
+//     it under the terms of the GNU General Public License as published by
+//     the Free Software Foundation, either version 3 of the License, or
+//     (at your option) any later version.
+//
+//     This program is distributed in the hope that it will be useful,
+//     but WITHOUT ANY WARRANTY; without even the implied warranty of
+//     MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//     GNU General Public License for more details.
+//
+//     You should have received a copy of the GNU General Public License
+//     along with this program.  If not, see <https://www.gnu.org/licenses/>.
+//     **********************************************************************
+
+#include "Benchmark.hpp"
+
+namespace bench
+{
+
+//---------------------------------------------------------------------------------------------------------------------
+
+    constexpr std::array<const char*, lvk::VideoFrame::UNKNOWN> FORMAT_NAMES = {
+        "BGR", "BGRA", "RGB", "RGBA", "YUV", "GRAY", "YUV420P", "NV12"
+    };
+
+    constexpr cv::Size CONVERSION_RESOLUTION = {1920, 1080};
+
+//---------------------------------------------------------------------------------------------------------------------
+
+    static lvk::VideoFrame synthetic_frame(const lvk::VideoFrame::Format format)
+    {
+        lvk::SyntheticSource source({
+            .resolution = CONVERSION_RESOLUTION,
+            .format = format,
+            .noise_strength = 2.0f
+        });
+
+        lvk::VideoFrame frame;
+        source.read(frame);
+        return frame;
+    }
+
+//---------------------------------------------------------------------------------------------------------------------
+
+    // Times every (source, destination) pair of the packed conversion dispatch tables.
+    const Registrar packed_conversions("conversion/packed", Kind::BENCHMARK, []{
+        for(int s = lvk::VideoFrame::BGR; s <= lvk::VideoFrame::GRAY; s++)
+        {
+            const auto src_format = static_cast<lvk::VideoFrame::Format>(s);
+            const lvk::VideoFrame src = synthetic_frame(src_format);
+
+            cv::UMat dst(cv::UMatUsageFlags::USAGE_ALLOCATE_DEVICE_MEMORY);
+            for(int d = lvk::VideoFrame::BGR; d <= lvk::VideoFrame::GRAY; d++)
+            {
+                const auto dst_format = static_cast<lvk::VideoFrame::Format>(d);
+                if(src_format == dst_format) continue;
+
+                measure(std::string(FORMAT_NAMES[s]) + " -> " + FORMAT_NAMES[d], [&]{
+                    lvk::convert(src, dst, src_format, dst_format);
+                });
+            }
+        }
+        return true;
+    });
+
+//---------------------------------------------------------------------------------------------------------------------
+
+    // Times the planar pairs, which are packed via YUV unless converting to/from GRAY or YUV.
+    const Registrar planar_conversions("conversion/planar", Kind::BENCHMARK, []{
+        const std::array<lvk::VideoFrame::Format, 2> planar_formats = {lvk::VideoFrame::YUV420P, lvk::VideoFrame::NV12};
+        const std::array<lvk::VideoFrame::Format, 3> packed_formats = {
+            lvk::VideoFrame::YUV, lvk::VideoFrame::BGR, lvk::VideoFrame::GRAY
+        };
+
+        lvk::VideoFrame dst;
+        for(const auto planar_format : planar_formats)
+        {
+            for(const auto packed_format : packed_formats)
+            {
+                const lvk::VideoFrame planar = synthetic_frame(planar_format);
+                const lvk::VideoFrame packed = synthetic_frame(packed_format);
+
+                measure(std::string(FORMAT_NAMES[planar_format]) + " -> " + FORMAT_NAMES[packed_format], [&]{
+                    lvk::convert(planar, dst, packed_format);
+                });
+                measure(std::string(FORMAT_NAMES[packed_format]) + " -> " + FORMAT_NAMES[planar_format], [&]{
+                    lvk::convert(packed, dst, planar_format);
+                });
+            }
+        }
+        return true;
+    });
+
+//---------------------------------------------------------------------------------------------------------------------
+
+    // Compares the single-pass pairs against the two-pass chains they replaced.
+    const Registrar two_pass_conversions("conversion/two-pass", Kind::BENCHMARK, []{
+        cv::UMat dst, intermediate;
+
+        const lvk::VideoFrame bgra = synthetic_frame(lvk::VideoFrame::BGRA);
+        const auto bgra_chain = measure("BGRA -> BGR -> YUV (two-pass)", [&]{
+            cv::cvtColor(bgra, intermediate, cv::COLOR_BGRA2BGR);
+            cv::cvtColor(intermediate, dst, cv::COLOR_BGR2YUV);
+        });
+        const auto bgra_single = measure("BGRA -> YUV (single-pass)", [&]{
+            lvk::convert(bgra, dst, lvk::VideoFrame::BGRA, lvk::VideoFrame::YUV);
+        });
+        report("BGRA -> YUV speedup", bgra_chain, bgra_single);
+
+        const lvk::VideoFrame gray = synthetic_frame(lvk::VideoFrame::GRAY);
+        const cv::UMat chroma(gray.size(), CV_8UC1, cv::Scalar(128));
+        const auto gray_chain = measure("GRAY -> YUV (plane merge)", [&]{
+            cv::merge(std::vector<cv::UMat>{gray, chroma, chroma}, dst);
+        });
+        const auto gray_single = measure("GRAY -> YUV (single-pass)", [&]{
+            lvk::convert(gray, dst, lvk::VideoFrame::GRAY, lvk::VideoFrame::YUV);
+        });
+        report("GRAY -> YUV speedup", gray_chain, gray_single);
+
+        return true;
+    });
+
+//---------------------------------------------------------------------------------------------------------------------
+
+}
@@ -0,0 +1,202 @@
+//     *************************** LiveVisionKit ****************************
+//     Copyright (C) 2022  Sebastian Di Marco (crowsinc.dev@gmail.com)
+//
+//     This program is free software: you can redistribute it and/or modify
+//     it under the terms of the GNU General Public License as published by
+//     the Free Software Foundation, either version 3 of the License, or
+//     (at your option) any later version.
+//
+//     This program is distributed in the hope that it will be useful,
+//     but WITHOUT ANY WARRANTY; without even the implied warranty of
+//     MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//     GNU General Public License for more details.
+//
+//     You should have received a copy of the GNU General Public License
+//     along with this program.  If not, see <https://www.gnu.org/licenses/>.
+//     **********************************************************************
+
+#include <iostream>
+#include <functional>
+#include <algorithm>
+
+#include "Benchmark.hpp"
+
+namespace bench
+{
+
+//---------------------------------------------------------------------------------------------------------------------
+
+    constexpr size_t TRANSFORM_POINT_COUNT = 4099; // Not a multiple of the batch size, to cover the scalar tail.
+    constexpr cv::Size TRANSFORM_MESH_SIZE = {64, 64};
+    constexpr float TRANSFORM_TOLERANCE = 1e-4f; // Relative to the point magnitude
+    constexpr double MIN_TESTED_DIVISOR = 1e-3; // Float and double rounding may disagree closer to infinity
+
+//---------------------------------------------------------------------------------------------------------------------
+
+    static lvk::Homography perspective_homography()
+    {
+        return lvk::Homography(cv::Matx33d(
+            1.02, 0.03, -12.0,
+            -0.02, 0.98, 7.5,
+            2e-4, -1e-4, 1.0
+        ));
+    }
+
+//---------------------------------------------------------------------------------------------------------------------
+
+    static std::vector<cv::Point2f> random_points(const size_t count, const cv::Size2f& extent)
+    {
+        cv::RNG rng(0);
+        std::vector<cv::Point2f> points(count);
+        for(auto& point : points)
+            point = {rng.uniform(0.0f, extent.width), rng.uniform(0.0f, extent.height)};
+        return points;
+    }
+
+//---------------------------------------------------------------------------------------------------------------------
+
+    // The per-point transform which the Homography used before its batch transform.
+    static cv::Point2f previous_transform(const cv::Mat& matrix, const cv::Point2f& point)
+    {
+        std::vector<cv::Point2f> out, in = {point};
+        cv::perspectiveTransform(in, out, matrix);
+        return out[0];
+    }
+
+//---------------------------------------------------------------------------------------------------------------------
+
+    // The offset which the previous WarpMesh::set_to(Homography) wrote for each vertex.
+    static cv::Point2f previous_offset(
+        const cv::Mat& matrix,
+        const cv::Point& coord,
+        const cv::Size& mesh_size,
+        const cv::Size2f& motion_scale
+    )
+    {
+        const cv::Point2f sample_point(
+            static_cast<float>(coord.x) * motion_scale.width / static_cast<float>(mesh_size.width - 1),
+            static_cast<float>(coord.y) * motion_scale.height / static_cast<float>(mesh_size.height - 1)
+        );
+        const cv::Point2f offset = sample_point - previous_transform(matrix, sample_point);
+        return {offset.x / motion_scale.width, offset.y / motion_scale.height};
+    }
+
+//---------------------------------------------------------------------------------------------------------------------
+
+    static bool matches(const cv::Point2f& result, const cv::Point2f& expected)
+    {
+        const float tolerance = TRANSFORM_TOLERANCE * std::max(1.0f, static_cast<float>(cv::norm(expected)));
+        return cv::norm(result - expected) <= tolerance;
+    }
+
+//---------------------------------------------------------------------------------------------------------------------
+
+    const Registrar homography_transform("homography/transform", Kind::BENCHMARK, []{
+        const auto homography = perspective_homography();
+        const cv::Mat matrix(homography.data());
+
+        const auto points = random_points(TRANSFORM_POINT_COUNT, {1920.0f, 1080.0f});
+        std::vector<cv::Point2f> dst(points.size());
+
+        const auto per_point = measure("Per-point perspectiveTransform (previous)", [&]{
+            for(size_t i = 0; i < points.size(); i++)
+                dst[i] = previous_transform(matrix, points[i]);
+        });
+        const auto opencv_batch = measure("Batch cv::perspectiveTransform", [&]{
+            cv::perspectiveTransform(points, dst, matrix);
+        });
+        const auto batch = measure("Batch Homography::transform", [&]{
+            homography.transform(points.data(), dst.data(), points.size());
+        });
+        report("Speedup over per-point", per_point, batch);
+        report("Speedup over cv::perspectiveTransform", opencv_batch, batch);
+
+        return true;
+    });
+
+//---------------------------------------------------------------------------------------------------------------------
+
+    const Registrar mesh_set_to("homography/warpmesh-set-to", Kind::BENCHMARK, []{
+        const auto homography = perspective_homography();
+        const cv::Mat matrix(homography.data());
+        const cv::Size2f motion_scale(1920.0f, 1080.0f);
+
+        lvk::WarpMesh mesh(TRANSFORM_MESH_SIZE);
+
+        // NOTE: the previous set_to wrote each vertex through a std::function.
+        const std::function<void(cv::Point2f&, const cv::Point&)> previous_operation =
+            [&](cv::Point2f& offset, const cv::Point& coord){
+                offset = previous_offset(matrix, coord, mesh.size(), motion_scale);
+            };
+
+        const auto previous = measure("Per-vertex set_to (previous)", [&]{
+            mesh.write(previous_operation);
+        });
+        const auto batched = measure("Batched set_to", [&]{
+            mesh.set_to(homography, motion_scale);
+        });
+        report("Speedup", previous, batched);
+
+        return true;
+    });
+
+//---------------------------------------------------------------------------------------------------------------------
+
+    const Registrar transform_correctness("homography/transform-correctness", Kind::CHECK, []{
+        const auto homography = perspective_homography();
+        const cv::Matx33d& h = homography.data();
+        const cv::Mat matrix(h);
+
+        auto points = random_points(TRANSFORM_POINT_COUNT, {1920.0f, 1080.0f});
+        points.erase(std::remove_if(points.begin(), points.end(), [&](const cv::Point2f& p){
+            return std::abs(h(2, 0) * p.x + h(2, 1) * p.y + h(2, 2)) < MIN_TESTED_DIVISOR;
+        }), points.end());
+
+        std::vector<cv::Point2f> expected, result(points.size());
+        cv::perspectiveTransform(points, expected, matrix);
+        homography.transform(points.data(), result.data(), points.size());
+
+        size_t mismatches = 0;
+        for(size_t i = 0; i < points.size(); i++)
+            mismatches += matches(result[i], expected[i]) ? 0 : 1;
+
+        // NOTE: the divisor of these points is exactly zero in both float and double,
+        // so they must be mapped to zero by the vectorized and the scalar paths alike.
+        const lvk::Homography projective(cv::Matx33d(
+            1.0, 0.0, 0.0,
+            0.0, 1.0, 0.0,
+            0.5, 0.25, -50.0
+        ));
+        const std::vector<cv::Point2f> infinite_points = {
+            {100.0f, 0.0f}, {60.0f, 80.0f}, {0.0f, 200.0f}, {20.0f, 160.0f}, // Vectorized batch
+            {90.0f, 20.0f}, {40.0f, 120.0f}, {80.0f, 40.0f}                  // Scalar tail
+        };
+
+        std::vector<cv::Point2f> expected_infinite, result_infinite(infinite_points.size());
+        cv::perspectiveTransform(infinite_points, expected_infinite, cv::Mat(projective.data()));
+        projective.transform(infinite_points.data(), result_infinite.data(), infinite_points.size());
+
+        for(size_t i = 0; i < infinite_points.size(); i++)
+        {
+            mismatches += matches(result_infinite[i], expected_infinite[i]) ? 0 : 1;
+            mismatches += matches(projective.transform(infinite_points[i]), expected_infinite[i]) ? 0 : 1;
+        }
+
+        // The batched WarpMesh::set_to must match the previous per-vertex implementation.
+        const cv::Size2f motion_scale(1920.0f, 1080.0f);
+        lvk::WarpMesh mesh(TRANSFORM_MESH_SIZE), reference(TRANSFORM_MESH_SIZE);
+        mesh.set_to(homography, motion_scale);
+
+        reference.write([&](cv::Point2f& offset, const cv::Point& coord){
+            offset = previous_offset(matrix, coord, reference.size(), motion_scale);
+        });
+        const double mesh_error = cv::norm(mesh.offsets(), reference.offsets(), cv::NORM_INF);
+
+        std::cout << "    Mismatched points: " << mismatches << ", set_to error: " << mesh_error << "\n";
+        return expect(mismatches == 0, "the batch transform does not match cv::perspectiveTransform")
+            && expect(mesh_error <= TRANSFORM_TOLERANCE, "set_to does not match the per-vertex implementation");
+    });
+
+//---------------------------------------------------------------------------------------------------------------------
+
+}
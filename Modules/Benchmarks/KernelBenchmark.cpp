@@ -0,0 +1,89 @@
+//     *************************** LiveVisionKit ****************************
+//     Copyright (C) 2022  Sebastian Di Marco (crowsinc.dev@gmail.com)
+//
+//     This program is free software: you can redistribute it and/or modify
+//     it under the terms of the GNU General Public License as published by
+//     the Free Software Foundation, either version 3 of the License, or
+//     (at your option) any later version.
+//
+//     This program is distributed in the hope that it will be useful,
+//     but WITHOUT ANY WARRANTY; without even the implied warranty of
+//     MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//     GNU General Public License for more details.
+//
+//     You should have received a copy of the GNU General Public License
+//     along with this program.  If not, see <https://www.gnu.org/licenses/>.
+//     **********************************************************************
+
+#include <iostream>
+
+#include "Benchmark.hpp"
+
+namespace bench
+{
+
+//---------------------------------------------------------------------------------------------------------------------
+
+    constexpr size_t DISPATCH_ITERATIONS = 1000;
+
+    // NOTE: a small frame keeps the kernel execution negligible, so that the launch is dispatch bound.
+    constexpr cv::Size DISPATCH_RESOLUTION = {64, 64};
+
+//---------------------------------------------------------------------------------------------------------------------
+
+    static void launch_conversion(cv::ocl::Kernel& kernel, const cv::UMat& src, cv::UMat& dst)
+    {
+        size_t global_work_size[3], local_work_size[3];
+        lvk::ocl::optimal_groups("conversion", kernel, src, global_work_size, local_work_size);
+
+        kernel.args(
+            cv::ocl::KernelArg::ReadOnly(src),
+            cv::ocl::KernelArg::WriteOnlyNoSize(dst)
+        );
+        lvk::ocl::launch(kernel, 2, global_work_size, local_work_size);
+    }
+
+//---------------------------------------------------------------------------------------------------------------------
+
+    // Compares creating a fresh kernel for every launch against the thread-local kernel rings of next_kernel,
+    // which reuse their kernels once their last launch has completed.
+    const Registrar kernel_dispatch("opencl/next_kernel", Kind::BENCHMARK, []{
+        if(!cv::ocl::useOpenCL())
+        {
+            std::cout << "    Skipped, OpenCL is not available\n";
+            return true;
+        }
+
+        const auto program = lvk::ocl::load_program("conversion", lvk::ocl::src::conversion_source);
+        LVK_ASSERT(!program.empty());
+
+        const auto fresh_creation = measure("Kernel creation (fresh)", [&]{
+            cv::ocl::Kernel kernel("bgr_to_gray", program);
+        }, DISPATCH_ITERATIONS);
+        const auto ring_creation = measure("Kernel creation (next_kernel)", [&]{
+            auto kernel = lvk::ocl::next_kernel(program, "bgr_to_gray");
+        }, DISPATCH_ITERATIONS);
+        report("Creation speedup", fresh_creation, ring_creation);
+
+        lvk::SyntheticSource source({.resolution = DISPATCH_RESOLUTION, .format = lvk::VideoFrame::BGR});
+        lvk::VideoFrame src;
+        source.read(src);
+
+        cv::UMat dst(src.size(), CV_8UC1, cv::UMatUsageFlags::USAGE_ALLOCATE_DEVICE_MEMORY);
+
+        const auto fresh_launch = measure("Kernel launch (fresh)", [&]{
+            cv::ocl::Kernel kernel("bgr_to_gray", program);
+            launch_conversion(kernel, src, dst);
+        }, DISPATCH_ITERATIONS);
+        const auto ring_launch = measure("Kernel launch (next_kernel)", [&]{
+            auto kernel = lvk::ocl::next_kernel(program, "bgr_to_gray");
+            launch_conversion(kernel, src, dst);
+        }, DISPATCH_ITERATIONS);
+        report("Launch speedup", fresh_launch, ring_launch);
+
+        return true;
+    });
+
+//---------------------------------------------------------------------------------------------------------------------
+
+}
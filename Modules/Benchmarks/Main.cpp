@@ -0,0 +1,67 @@
+//     *************************** LiveVisionKit ****************************
+//     Copyright (C) 2022  Sebastian Di Marco (crowsinc.dev@gmail.com)
+//
+//     This program is free software: you can redistribute it and/or modify
+//     it under the terms of the GNU General Public License as published by
+//     the Free Software Foundation, either version 3 of the License, or
+//     (at your option) any later version.
+//
+//     This program is distributed in the hope that it will be useful,
+//     but WITHOUT ANY WARRANTY; without even the implied warranty of
+//     MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//     GNU General Public License for more details.
+//
+//     You should have received a copy of the GNU General Public License
+//     along with this program.  If not, see <https://www.gnu.org/licenses/>.
+//     **********************************************************************
+
+#include <iostream>
+#include <algorithm>
+#include <cstring>
+
+#include "Benchmark.hpp"
+
+// NOTE: usage: lvk-bench [--checks | --benchmarks] [--cpu] [name filters...]
+int main(int argc, char* argv[])
+{
+    bool run_checks = true, run_benchmarks = true;
+    std::vector<std::string> filters;
+
+    for(int i = 1; i < argc; i++)
+    {
+        if(std::strcmp(argv[i], "--checks") == 0)
+            run_benchmarks = false;
+        else if(std::strcmp(argv[i], "--benchmarks") == 0)
+            run_checks = false;
+        else if(std::strcmp(argv[i], "--cpu") == 0)
+            cv::ocl::setUseOpenCL(false);
+        else
+            filters.emplace_back(argv[i]);
+    }
+
+    std::cout << "OpenCL: " << (cv::ocl::useOpenCL() ? "enabled" : "disabled")
+              << ", Allocation Counting: " << (lvk::AllocationCounter::IsSupported() ? "enabled" : "disabled") << "\n";
+
+    size_t failures = 0;
+    for(const auto& entry : bench::registry())
+    {
+        const bool is_check = entry.kind == bench::Kind::CHECK;
+        if((is_check && !run_checks) || (!is_check && !run_benchmarks))
+            continue;
+
+        const bool filtered = !filters.empty() && std::none_of(filters.begin(), filters.end(), [&](auto& filter){
+            return entry.name.find(filter) != std::string::npos;
+        });
+        if(filtered) continue;
+
+        std::cout << "\n[" << (is_check ? "check" : "benchmark") << "] " << entry.name << "\n";
+        if(!entry.run())
+        {
+            std::cerr << "[failed] " << entry.name << "\n";
+            failures++;
+        }
+    }
+
+    std::cout << "\n" << failures << " failure(s)\n";
+    return failures == 0 ? 0 : 1;
+}
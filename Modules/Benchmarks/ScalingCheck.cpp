@@ -0,0 +1,123 @@
+//     *************************** LiveVisionKit ****************************
+//     Copyright (C) 2022  Sebastian Di Marco (crowsinc.dev@gmail.com)
+//
+//     This program is free software: you can redistribute it and/or modify
+//     it under the terms of the GNU General Public License as published by
+//     the Free Software Foundation, either version 3 of the License, or
+//     (at your option) any later version.
+//
+//     This program is distributed in the hope that it will be useful,
+//     but WITHOUT ANY WARRANTY; without even the implied warranty of
+//     MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//     GNU General Public License for more details.
+//
+//     You should have received a copy of the GNU General Public License
+//     along with this program.  If not, see <https://www.gnu.org/licenses/>.
+//     **********************************************************************
+
+#include <iostream>
+#include <string>
+
+#include "Benchmark.hpp"
+
+namespace bench
+{
+
+//---------------------------------------------------------------------------------------------------------------------
+
+    constexpr cv::Size SCALING_INPUT_SIZE = {640, 360};
+    constexpr cv::Size SCALING_OUTPUT_SIZE = {1280, 720};
+    constexpr float SCALING_SHARPNESS = 0.8f;
+
+    // NOTE: the paths only differ by the rounding of their reciprocals, which can flip the
+    // truncation of an upscaled pixel by one level. RCAS amplifies this by at most 1/(1 - 0.75).
+    constexpr double MAX_LEVEL_ERROR = 4.0;
+    constexpr double MEAN_LEVEL_ERROR = 0.05;
+
+    constexpr cv::Size UHD_OUTPUT_SIZE = {3840, 2160};
+
+//---------------------------------------------------------------------------------------------------------------------
+
+    static bool compare_paths(
+        const std::string& label,
+        const cv::Size& output_size,
+        const lvk::VideoFrame::Format format
+    )
+    {
+        lvk::SyntheticSource source({.resolution = SCALING_INPUT_SIZE, .format = format});
+        lvk::VideoFrame frame;
+        source.read(frame);
+
+        const bool yuv = format == lvk::VideoFrame::YUV;
+        lvk::TileProcessor tiler;
+
+        cv::UMat gpu_output, cpu_output;
+        lvk::upscale_sharpen(frame, gpu_output, output_size, SCALING_SHARPNESS, yuv);
+        lvk::upscale_sharpen(frame, cpu_output, output_size, SCALING_SHARPNESS, yuv, tiler);
+
+        cv::Mat error;
+        cv::absdiff(gpu_output, cpu_output, error);
+
+        double max_error = 0.0;
+        cv::minMaxLoc(error.reshape(1), nullptr, &max_error);
+        const double mean_error = cv::mean(error.reshape(1))[0];
+
+        std::cout << "    " << label << ": max " << max_error << " levels, mean " << mean_error << " levels\n";
+        return expect(max_error <= MAX_LEVEL_ERROR, label + " max error exceeds tolerance")
+            && expect(mean_error <= MEAN_LEVEL_ERROR, label + " mean error exceeds tolerance");
+    }
+
+//---------------------------------------------------------------------------------------------------------------------
+
+    // The CPU upscale_sharpen must produce the same output as the fused OpenCL kernel,
+    // including on the frame border, for upscales as well as for sharpening alone.
+    const Registrar scaling_equivalence("scaling/cpu-equivalence", Kind::CHECK, []{
+        if(!cv::ocl::useOpenCL())
+        {
+            std::cout << "    Skipped, OpenCL is not available\n";
+            return true;
+        }
+
+        bool passed = true;
+        passed &= compare_paths("BGR upscale", SCALING_OUTPUT_SIZE, lvk::VideoFrame::BGR);
+        passed &= compare_paths("YUV upscale", SCALING_OUTPUT_SIZE, lvk::VideoFrame::YUV);
+        passed &= compare_paths("BGR sharpen", SCALING_INPUT_SIZE, lvk::VideoFrame::BGR);
+        passed &= compare_paths("YUV sharpen", SCALING_INPUT_SIZE, lvk::VideoFrame::YUV);
+        return passed;
+    });
+
+//---------------------------------------------------------------------------------------------------------------------
+
+    // Compares the fused EASU + RCAS kernel against an upscale followed by a sharpen, at 4K output.
+    const Registrar fused_scaling("scaling/fused-4k", Kind::BENCHMARK, []{
+        if(!cv::ocl::useOpenCL())
+        {
+            std::cout << "    Skipped, OpenCL is not available\n";
+            return true;
+        }
+
+        for(const cv::Size input_size : {cv::Size(1920, 1080), cv::Size(2560, 1440)})
+        {
+            lvk::SyntheticSource source({.resolution = input_size, .format = lvk::VideoFrame::YUV});
+            lvk::VideoFrame frame;
+            source.read(frame);
+
+            const std::string label = std::to_string(input_size.height) + "p -> 2160p";
+
+            cv::UMat dst, intermediate;
+            const auto two_pass = measure(label + " (two-pass)", [&]{
+                lvk::upscale(frame, intermediate, UHD_OUTPUT_SIZE, true);
+                lvk::sharpen(intermediate, dst, SCALING_SHARPNESS);
+            });
+            const auto fused = measure(label + " (fused)", [&]{
+                lvk::upscale_sharpen(frame, dst, UHD_OUTPUT_SIZE, SCALING_SHARPNESS, true);
+            });
+            report(label + " speedup", two_pass, fused);
+        }
+
+        return true;
+    });
+
+//---------------------------------------------------------------------------------------------------------------------
+
+}
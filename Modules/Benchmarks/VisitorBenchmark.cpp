@@ -0,0 +1,110 @@
+//     *************************** LiveVisionKit ****************************
+//     Copyright (C) 2022  Sebastian Di Marco (crowsinc.dev@gmail.com)
+//
+//     This program is free software: you can redistribute it and/or modify
+//     it under the terms of the GNU General Public License as published by
+//     the Free Software Foundation, either version 3 of the License, or
+//     (at your option) any later version.
+//
+//     This program is distributed in the hope that it will be useful,
+//     but WITHOUT ANY WARRANTY; without even the implied warranty of
+//     MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//     GNU General Public License for more details.
+//
+//     You should have received a copy of the GNU General Public License
+//     along with this program.  If not, see <https://www.gnu.org/licenses/>.
+//     **********************************************************************
+
+#include <iostream>
+#include <functional>
+#include <optional>
+#include <cmath>
+
+#include "Benchmark.hpp"
+
+namespace bench
+{
+
+//---------------------------------------------------------------------------------------------------------------------
+
+    constexpr std::array<int, 9> VISITOR_MESH_SIZES = {4, 8, 16, 24, 32, 48, 64, 128, 256};
+
+//---------------------------------------------------------------------------------------------------------------------
+
+    // NOTE: a typical per-vertex operation, which is far cheaper than the dispatch of a parallel loop.
+    static void visit_vertex(cv::Point2f& offset, const cv::Point& coord)
+    {
+        offset = offset * 0.9f + cv::Point2f(coord) * 1e-3f;
+    }
+
+//---------------------------------------------------------------------------------------------------------------------
+
+    // Times the WarpMesh visitors serially and in parallel over increasing mesh sizes, to find the
+    // size at which a parallel loop starts to pay off. MIN_PARALLEL_MESH_VERTICES should sit there.
+    const Registrar mesh_visitors("mesh/visitors", Kind::BENCHMARK, []{
+        const std::function<void(cv::Point2f&, const cv::Point&)> erased_operation = visit_vertex;
+
+        std::optional<int> crossover;
+        for(const int size : VISITOR_MESH_SIZES)
+        {
+            lvk::WarpMesh mesh(cv::Size(size, size));
+            const std::string label = std::to_string(size) + "x" + std::to_string(size);
+
+            measure(label + " write (std::function)", [&]{
+                mesh.write(erased_operation, false);
+            });
+            const auto serial = measure(label + " write (serial)", [&]{
+                mesh.write(visit_vertex, false);
+            });
+
+            // NOTE: the parallel loop is run directly, as write() never runs it below the threshold.
+            const auto parallel = measure(label + " write (parallel)", [&]{
+                mesh.offsets().forEach<cv::Point2f>([&](cv::Point2f& offset, const int coord[]){
+                    visit_vertex(offset, cv::Point(coord[1], coord[0]));
+                });
+            });
+
+            if(!crossover.has_value() && parallel.nanoseconds() < serial.nanoseconds())
+                crossover = size;
+        }
+
+        if(crossover.has_value())
+            std::cout << "    Parallel visits pay off from " << *crossover << "x" << *crossover << " vertices\n";
+        else
+            std::cout << "    Parallel visits never paid off\n";
+
+        return true;
+    });
+
+//---------------------------------------------------------------------------------------------------------------------
+
+    const Registrar grid_visitors("mesh/grid-visitors", Kind::BENCHMARK, []{
+        for(const int size : VISITOR_MESH_SIZES)
+        {
+            const lvk::VirtualGrid grid(cv::Size(size, size), cv::Rect2f(0.0f, 0.0f, 1920.0f, 1080.0f));
+            const std::string label = std::to_string(size) + "x" + std::to_string(size);
+
+            float checksum = 0.0f;
+            const std::function<void(int, const cv::Point2f&)> erased_operation = [&](int, const cv::Point2f& point){
+                checksum += point.x - point.y;
+            };
+
+            const auto erased = measure(label + " for_each_aligned (std::function)", [&]{
+                grid.for_each_aligned(erased_operation);
+            });
+            const auto inlined = measure(label + " for_each_aligned (template)", [&]{
+                grid.for_each_aligned([&](int, const cv::Point2f& point){
+                    checksum += point.x - point.y;
+                });
+            });
+            report(label + " speedup", erased, inlined);
+
+            // NOTE: the checksum stops the loops from being optimized away.
+            if(std::isnan(checksum)) std::cout << checksum;
+        }
+        return true;
+    });
+
+//---------------------------------------------------------------------------------------------------------------------
+
+}
@@ -0,0 +1,215 @@
+//     *************************** LiveVisionKit ****************************
+//     Copyright (C) 2022  Sebastian Di Marco (crowsinc.dev@gmail.com)
+//
+//     This program is free software: you can redistribute it and/or modify
+//     it under the terms of the GNU General Public License as published by
+//     the Free Software Foundation, either version 3 of the License, or
+//     (at your option) any later version.
+//
+//     This program is distributed in the hope that it will be useful,
+//     but WITHOUT ANY WARRANTY; without even the implied warranty of
+//     MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//     GNU General Public License for more details.
+//
+//     You should have received a copy of the GNU General Public License
+//     along with this program.  If not, see <https://www.gnu.org/licenses/>.
+//     **********************************************************************
+
+#include <iostream>
+#include <cmath>
+#include <algorithm>
+
+#include "Benchmark.hpp"
+
+namespace bench
+{
+
+//---------------------------------------------------------------------------------------------------------------------
+
+    // NOTE: at this size, each pixel holds its own coordinates in 8-bit levels, so a level is one pixel.
+    constexpr cv::Size COMPOSE_FRAME_SIZE = {256, 256};
+    constexpr float LENS_TOLERANCE = 0.25f; // Pixels, as used by the StabilizationFilter
+    constexpr double MAX_COMPOSE_ERROR = 2.0; // Pixels, allowing for the rounding of the sequential warp
+    constexpr double MEAN_COMPOSE_ERROR = 0.75; // Pixels
+
+//---------------------------------------------------------------------------------------------------------------------
+
+    // A frame which holds the x and y coordinates of each pixel in its first two channels,
+    // and a constant third channel. A warp of the frame is then a map of where each output
+    // pixel was sampled from, and bilinear sampling is exact, so resampling does not blur it.
+    static lvk::VideoFrame coordinate_frame()
+    {
+        cv::Mat frame(COMPOSE_FRAME_SIZE, CV_8UC3);
+        for(int r = 0; r < frame.rows; r++)
+        {
+            auto* row = frame.ptr<cv::Vec3b>(r);
+            for(int c = 0; c < frame.cols; c++)
+                row[c] = cv::Vec3b(static_cast<uchar>(c), static_cast<uchar>(r), 128);
+        }
+        return lvk::VideoFrame(frame.getUMat(cv::ACCESS_READ).clone(), 0, lvk::VideoFrame::BGR);
+    }
+
+//---------------------------------------------------------------------------------------------------------------------
+
+    // The undistortion mesh of a wide angle lens, prepared as by the StabilizationFilter.
+    static lvk::WarpMesh lens_correction(const bool dense)
+    {
+        const cv::Matx33d camera_matrix(
+            200.0, 0.0, 128.0,
+            0.0, 200.0, 128.0,
+            0.0, 0.0, 1.0
+        );
+        const cv::Vec4d distortion(-0.25, 0.05, 0.0, 0.0);
+
+        cv::Rect view_region;
+        const cv::Mat optimal_camera_matrix = cv::getOptimalNewCameraMatrix(
+            camera_matrix, distortion, COMPOSE_FRAME_SIZE, 0, COMPOSE_FRAME_SIZE, &view_region
+        );
+
+        cv::Mat correction_map;
+        cv::initUndistortRectifyMap(
+            camera_matrix, distortion, cv::noArray(), optimal_camera_matrix,
+            COMPOSE_FRAME_SIZE, CV_32FC2, correction_map, cv::noArray()
+        );
+
+        const cv::Size2f frame_size(COMPOSE_FRAME_SIZE);
+        lvk::WarpMesh correction(std::move(correction_map), false, false);
+        correction.crop_in({
+            static_cast<float>(view_region.x) / frame_size.width,
+            static_cast<float>(view_region.y) / frame_size.height,
+            static_cast<float>(view_region.width) / frame_size.width,
+            static_cast<float>(view_region.height) / frame_size.height
+        });
+
+        if(!dense) correction.resample(correction.fit_resolution(COMPOSE_FRAME_SIZE, LENS_TOLERANCE));
+        return correction;
+    }
+
+//---------------------------------------------------------------------------------------------------------------------
+
+    static lvk::WarpMesh homography_mesh(const double degrees, const cv::Point2d& shift, const double perspective)
+    {
+        const double radians = degrees * CV_PI / 180.0;
+        const cv::Matx33d rotation(
+            std::cos(radians), -std::sin(radians), shift.x,
+            std::sin(radians), std::cos(radians), shift.y,
+            perspective, 0.0, 1.0
+        );
+        return lvk::WarpMesh(lvk::Homography(rotation), cv::Size2f(COMPOSE_FRAME_SIZE));
+    }
+
+//---------------------------------------------------------------------------------------------------------------------
+
+    static lvk::WarpMesh wave_mesh(const cv::Size& size, const float amplitude)
+    {
+        lvk::WarpMesh mesh(size);
+        mesh.write([&](cv::Point2f& offset, const cv::Point& coord){
+            offset.x = amplitude * std::sin(static_cast<float>(coord.y) * 1.3f);
+            offset.y = amplitude * std::cos(static_cast<float>(coord.x) * 0.7f);
+        });
+        return mesh;
+    }
+
+//---------------------------------------------------------------------------------------------------------------------
+
+    // Compares the sampled coordinates of two warps of the coordinate frame, ignoring any
+    // pixels which were blended with the background, which have lost their third channel.
+    static bool compare_warps(
+        const std::string& label,
+        const lvk::VideoFrame& expected,
+        const lvk::VideoFrame& result,
+        const double max_tolerance,
+        const double mean_tolerance
+    )
+    {
+        const cv::Mat expected_frame = expected.getMat(cv::ACCESS_READ);
+        const cv::Mat result_frame = result.getMat(cv::ACCESS_READ);
+
+        double max_error = 0.0, total_error = 0.0;
+        size_t samples = 0;
+        for(int r = 0; r < expected_frame.rows; r++)
+        {
+            const auto* expected_row = expected_frame.ptr<cv::Vec3b>(r);
+            const auto* result_row = result_frame.ptr<cv::Vec3b>(r);
+            for(int c = 0; c < expected_frame.cols; c++)
+            {
+                if(expected_row[c][2] != 128 || result_row[c][2] != 128)
+                    continue;
+
+                const double error = std::hypot(
+                    static_cast<double>(expected_row[c][0]) - static_cast<double>(result_row[c][0]),
+                    static_cast<double>(expected_row[c][1]) - static_cast<double>(result_row[c][1])
+                );
+                max_error = std::max(max_error, error);
+                total_error += error;
+                samples++;
+            }
+        }
+
+        const double mean_error = samples > 0 ? total_error / static_cast<double>(samples) : 0.0;
+        std::cout << "    " << label << ": " << mean_error << "px mean, " << max_error << "px max error over "
+                  << samples << " pixels\n";
+
+        return expect(samples > static_cast<size_t>(COMPOSE_FRAME_SIZE.area() / 2), label + " left too few pixels")
+            && expect(max_error <= max_tolerance && mean_error <= mean_tolerance, label + " is out of tolerance");
+    }
+
+//---------------------------------------------------------------------------------------------------------------------
+
+    // The composed warp must match applying the inner and then the outer warp, for 2x2
+    // homography meshes as well as larger meshes, and for lens meshes which fit to 2x2.
+    const Registrar mesh_compose("mesh/compose", Kind::CHECK, []{
+        const lvk::VideoFrame frame = coordinate_frame();
+
+        const std::vector<std::pair<std::string, lvk::WarpMesh>> outer_meshes = {
+            {"homography", homography_mesh(2.0, {4.0, -3.0}, 2e-4)},
+            {"wave", wave_mesh({6, 6}, 0.01f)}
+        };
+        const std::vector<std::pair<std::string, lvk::WarpMesh>> inner_meshes = {
+            {"lens", lens_correction(false)},
+            {"homography", homography_mesh(-1.0, {-2.0, 5.0}, -1e-4)},
+            {"wave", wave_mesh({9, 9}, 0.008f)}
+        };
+
+        bool passed = true;
+        lvk::VideoFrame intermediate, sequential, composed;
+        lvk::WarpMesh composition(lvk::WarpMesh::MinimumSize);
+        for(const auto& [outer_name, outer] : outer_meshes)
+        {
+            for(const auto& [inner_name, inner] : inner_meshes)
+            {
+                inner.apply(frame, intermediate);
+                outer.apply(intermediate, sequential);
+
+                const cv::Size resolution(
+                    std::max(outer.cols(), inner.cols()),
+                    std::max(outer.rows(), inner.rows())
+                );
+                composition.compose(outer, inner, resolution);
+                composition.apply(frame, composed);
+
+                passed &= compare_warps(
+                    outer_name + " after " + inner_name + " (" + std::to_string(resolution.width) + "x"
+                        + std::to_string(resolution.height) + ")",
+                    sequential, composed, MAX_COMPOSE_ERROR, MEAN_COMPOSE_ERROR
+                );
+            }
+        }
+
+        // The fitted lens mesh must warp within tolerance of the dense lens map.
+        lvk::VideoFrame dense_warp, fitted_warp;
+        const auto fitted_lens = lens_correction(false);
+        lens_correction(true).apply(frame, dense_warp);
+        fitted_lens.apply(frame, fitted_warp);
+
+        passed &= compare_warps(
+            "fitted lens (" + std::to_string(fitted_lens.cols()) + "x" + std::to_string(fitted_lens.rows()) + ")",
+            dense_warp, fitted_warp, 1.0 + LENS_TOLERANCE, 0.5
+        );
+
+        return passed;
+    });
+
+//---------------------------------------------------------------------------------------------------------------------
+
+}
@@ -92,7 +92,15 @@ namespace lvk
     {
         LVK_ASSERT(test_obs_frame(src) && src->format == m_OBSFormat);
 
-        to_ocl(src, dst);
+        // NOTE: The upload is done on the transfer queue so that it does not wait behind
+        // the compute work of previous frames. The destination is never still in use by
+        // the compute queue, as OBS filters either consume or download their frames.
+        auto& context = ocl::ExecutionContext::Default();
+        {
+            ocl::ExecutionContext::Scope transfer_scope(context, ocl::ExecutionContext::TRANSFER);
+            to_ocl(src, dst);
+        }
+        context.wait(ocl::ExecutionContext::COMPUTE, context.record(ocl::ExecutionContext::TRANSFER));
 
         // Update Metadata.
         dst.timestamp = src->timestamp;
@@ -106,9 +114,16 @@ namespace lvk
         LVK_ASSERT(test_obs_frame(dst) && dst->format == m_OBSFormat);
         LVK_ASSERT(src.has_known_format());
 
-        // Attempt to convert the source to the expected format before downloading.
-        src.viewAsFormat(m_FormatConversionBuffer, m_OCLFormat);
-        to_obs(m_FormatConversionBuffer, dst);
+        // Download on the transfer queue once the compute work on the frame is done.
+        auto& context = ocl::ExecutionContext::Default();
+        context.wait(ocl::ExecutionContext::TRANSFER, context.record(ocl::ExecutionContext::COMPUTE));
+        {
+            ocl::ExecutionContext::Scope transfer_scope(context, ocl::ExecutionContext::TRANSFER);
+
+            // Attempt to convert the source to the expected format before downloading.
+            src.viewAsFormat(m_FormatConversionBuffer, m_OCLFormat);
+            to_obs(m_FormatConversionBuffer, dst);
+        }
 
         // Update Metadata.
         dst->timestamp = src.timestamp;
@@ -476,7 +491,10 @@ namespace lvk
 //---------------------------------------------------------------------------------------------------------------------
 
 	I4XXIngest::I4XXIngest(video_format i4xx_format)
-		: FrameIngest(i4xx_format, VideoFrame::YUV),
+		: FrameIngest(
+              i4xx_format,
+              any_of(i4xx_format, VIDEO_FORMAT_I40A, VIDEO_FORMAT_I420) ? VideoFrame::YUV420P : VideoFrame::YUV
+          ),
 		  m_ChromaScaling(
 			 any_of(i4xx_format, VIDEO_FORMAT_YUVA, VIDEO_FORMAT_I444) ? 1.0f : 0.5f,
 			 any_of(i4xx_format, VIDEO_FORMAT_I40A, VIDEO_FORMAT_I420) ? 0.5f : 1.0f
@@ -511,7 +529,14 @@ namespace lvk
 		LVK_ASSERT(!u_roi.empty());
 		LVK_ASSERT(!v_roi.empty());
 
-		if(chroma_size != frame_size)
+        // 4:2:0 formats are kept planar, so the chroma does not need up-sampling.
+        if(ocl_format() == VideoFrame::YUV420P)
+        {
+            y_roi.copyTo(dst);
+            u_roi.copyTo(dst.chroma[0]);
+            v_roi.copyTo(dst.chroma[1]);
+        }
+		else if(chroma_size != frame_size)
 		{
 			cv::resize(u_roi, m_UPlane, frame_size, 0, 0, cv::INTER_LINEAR);
 			cv::resize(v_roi, m_VPlane, frame_size, 0, 0, cv::INTER_LINEAR);
@@ -529,6 +554,12 @@ namespace lvk
 
         auto& frame = *dst;
 
+        if(ocl_format() == VideoFrame::YUV420P)
+        {
+            download_planes(src, src.chroma[0], src.chroma[1], frame);
+            return;
+        }
+
 		split_planes(src, m_YPlane, m_UPlane, m_VPlane);
 
 		if(m_ChromaScaling.width != 1.0f || m_ChromaScaling.height != 1.0f)
@@ -559,7 +590,7 @@ namespace lvk
 //---------------------------------------------------------------------------------------------------------------------
 
 	NV12Ingest::NV12Ingest()
-		: FrameIngest(VIDEO_FORMAT_NV12, VideoFrame::YUV)
+		: FrameIngest(VIDEO_FORMAT_NV12, VideoFrame::NV12)
 	{}
 
 //---------------------------------------------------------------------------------------------------------------------
@@ -578,9 +609,9 @@ namespace lvk
 			chroma_size, 2
 		);
 
-		cv::resize(uv_roi, m_UVPlane, frame_size, 0, 0, cv::INTER_LINEAR);
-		dst.create(frame_size, CV_8UC3, cv::UMatUsageFlags::USAGE_ALLOCATE_DEVICE_MEMORY);
-		cv::mixChannels({{y_roi, m_UVPlane}}, std::vector<cv::UMat>{dst}, {0,0,  1,1,  2,2});
+		// NOTE: NV12 is kept planar, so the planes only need to be copied.
+		y_roi.copyTo(dst);
+		uv_roi.copyTo(dst.chroma[0]);
 	}
 
 //---------------------------------------------------------------------------------------------------------------------
@@ -591,14 +622,7 @@ namespace lvk
 
 		auto& frame = *dst;
 
-		m_YPlane.create(src.size(), CV_8UC1);
-		m_UVPlane.create(src.size(), CV_8UC2);
-
-		cv::mixChannels({src}, std::vector<cv::UMat>{m_YPlane, m_UVPlane}, {0,0, 1,1,  2,2});
-
-		cv::resize(m_UVPlane, m_UVSubPlane, cv::Size(), 0.5, 0.5, cv::INTER_AREA);
-
-		download_planes(m_YPlane, m_UVSubPlane, frame);
+		download_planes(src, src.chroma[0], frame);
 	}
 
 //---------------------------------------------------------------------------------------------------------------------
@@ -163,10 +163,6 @@ namespace lvk
         void to_ocl(const obs_source_frame* src, VideoFrame& dst) override;
 		
 		void to_obs(const VideoFrame& src, obs_source_frame* dst) override;
-
-	private:
-		// NOTE: We assume this will automatically initialize on the GPU
-		cv::UMat m_YPlane, m_UVPlane, m_UVSubPlane;
 	};
 
 	// Packed 422 formats
@@ -125,6 +125,11 @@ namespace lvk::ocl
 				return false;
 			}
 			else lvk::log::print("The OpenCL interop context passed all validation tests!");
+
+			// Compile and tune all the LVK programs for the new context ahead of the first
+			// frame. Tuning results are persisted, so this is only slow on the first run.
+			warmup();
+			autotune();
 		}
 
 		// NOTE: We are making the assumption that 
@@ -142,14 +142,15 @@ namespace lvk
 	{
         LVK_PROFILE;
 
-		const auto frame_time_ms = m_Filter.timings().average().milliseconds();
-		const auto deviation_ms = m_Filter.timings().deviation().milliseconds();
+		const auto frame_time_ms = m_Filter.timings().host.average().milliseconds();
+		const auto deviation_ms = m_Filter.timings().host.deviation().milliseconds();
+		const double device_time_ms = m_Filter.timings().device.average().milliseconds();
 
 		draw_text(
 			frame,
-            cv::format("%.2fms (%.2fms)", frame_time_ms, deviation_ms),
+            cv::format("%.2fms (%.2fms) | GPU %.2fms", frame_time_ms, deviation_ms, device_time_ms),
 			cv::Point(5, 40),
-			frame_time_ms < TIMING_THRESHOLD_MS ? col::GREEN[frame.format] : col::RED[frame.format]
+			std::max(frame_time_ms, device_time_ms) < TIMING_THRESHOLD_MS ? col::GREEN[frame.format] : col::RED[frame.format]
 		);
 	}
 
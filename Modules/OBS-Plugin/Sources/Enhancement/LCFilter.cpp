@@ -179,6 +179,7 @@ namespace lvk
         if(m_TestMode)
         {
             // Draw grid so that the correction warp is visible.
+            if(frame.is_planar()) frame.reformat(VideoFrame::YUV);
             lvk::draw_grid(frame, PROP_TEST_MODE_GRID, col::MAGENTA[frame.format], 1);
         }
 
@@ -186,7 +187,12 @@ namespace lvk
 		{
 			prepare_undistort_maps(frame);
 
-            m_CorrectionMesh.apply(frame, m_CorrectedFrame);
+            // Without OpenCL, remap in cache-sized tiles on the CPU.
+            if(cv::ocl::useOpenCL())
+                m_CorrectionMesh.apply(frame, m_CorrectedFrame);
+            else
+                m_CorrectionMesh.apply(frame, m_CorrectedFrame, m_TileProcessor);
+
             std::swap(frame, m_CorrectedFrame);
 		}
 	}
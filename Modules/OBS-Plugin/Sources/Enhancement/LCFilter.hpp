@@ -54,6 +54,7 @@ namespace lvk
 
         OBSFrame m_CorrectedFrame;
         WarpMesh m_CorrectionMesh{WarpMesh::MinimumSize};
+        TileProcessor m_TileProcessor;
         bool m_MeshOutdated = true;
 	};
 
@@ -17,7 +17,9 @@
 
 #include <csignal>
 #include <obs-module.h>
+#include <util/config-file.h>
 #include <opencv2/core/ocl.hpp>
+#include <LiveVisionKit.hpp>
 
 #include "Interop/InteropContext.hpp"
 #include "Utility/Logging.hpp"
@@ -60,6 +62,32 @@ void register_ingest_test_source();
 
 //---------------------------------------------------------------------------------------------------------------------
 
+constexpr auto SETTINGS_FILE = "settings.ini";
+
+//---------------------------------------------------------------------------------------------------------------------
+
+bool load_queue_overlapping()
+{
+	// NOTE: Overlapped OpenCL queues are experimental, so they are only enabled if
+	// the user explicitly sets 'OverlapQueues=true' under the '[OpenCL]' section
+	// of the plugin's settings file, found in the OBS plugin config directory.
+	char* settings_path = obs_module_config_path(SETTINGS_FILE);
+
+	config_t* settings = nullptr;
+	const bool loaded = config_open(&settings, settings_path, CONFIG_OPEN_EXISTING) == CONFIG_SUCCESS;
+	bfree(settings_path);
+
+	if(!loaded)
+		return false;
+
+	const bool overlap_queues = config_get_bool(settings, "OpenCL", "OverlapQueues");
+	config_close(settings);
+
+	return overlap_queues;
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+
 void attach_ocl_interop_context(void* param, uint32_t cx, uint32_t cy)
 {
 	// NOTE: We need to attach (create) the OpenCL context based on the graphics
@@ -90,25 +118,36 @@ bool obs_module_load()
 #endif
 	const bool has_fsr_effect = lvk::FSREffect::IsCompiled();
 	const bool has_cas_effect = lvk::CASEffect::IsCompiled();
+	const bool overlap_queues = has_opencl && load_queue_overlapping();
 	
 	lvk::log::print_block(
 		"Initializing..."
 		"\n    Version: %s"
 		"\n    OpenCL Support: %s"
 		"\n    OpenCL Interop Support: %s"
+		"\n    OpenCL Queue Overlapping: %s"
 		"\n    FSR Effect Loaded: %s"
 		"\n    CAS Effect Loaded: %s"
 		,
 		VERSION,
 		has_opencl ? "Yes" : "No",
 		has_interop ? "Yes" : "No",
+		overlap_queues ? "Yes" : "No",
 		has_fsr_effect ? "Yes" : "No",
 		has_cas_effect ? "Yes" : "No"
 	);
 
+	// Overlapped queues must be opted into before any execution contexts are used.
+	lvk::ocl::ExecutionContext::SetOverlapping(overlap_queues);
+
 	// Attach OpenCL context
 	if(has_interop)
 		obs_add_main_render_callback(&attach_ocl_interop_context, nullptr);
+	else if(has_opencl)
+	{
+		lvk::ocl::warmup();
+		lvk::ocl::autotune();
+	}
 
 	// Register Filters...
 	register_fsr_source();
@@ -36,9 +36,14 @@ namespace lvk
 	constexpr auto PROP_STREAM_DELAY_INFO_MAX = 60000;
 	constexpr auto PROP_STREAM_DELAY_INFO_MIN = 0;
 
+    constexpr auto PROP_LOW_LATENCY = "LOW_LATENCY";
+    constexpr auto PROP_LOW_LATENCY_DEFAULT = false;
+    constexpr auto PROP_LOW_LATENCY_LOOK_AHEAD = 1;
+
     constexpr auto PROP_SUBSYSTEM = "MOTION_QUALITY";
     constexpr auto PROP_SUBSYSTEM_HOMOG = "vs.subsystem.1";
     constexpr auto PROP_SUBSYSTEM_FIELD = "vs.subsystem.2";
+    constexpr auto PROP_SUBSYSTEM_TRANS = "vs.subsystem.3";
     constexpr auto PROP_SUBSYSTEM_DEFAULT = PROP_SUBSYSTEM_HOMOG;
 
     constexpr auto PROP_QUALITY_ASSURANCE = "SUPPRESSION_MODE";
@@ -100,6 +105,13 @@ namespace lvk
 		obs_property_int_set_suffix(property, "ms");
 		obs_property_set_enabled(property, false);
 
+        // Low Latency Toggle
+        obs_properties_add_bool(
+            properties,
+            PROP_LOW_LATENCY,
+            L("vs.low-latency")
+        );
+
         // Motion Subsystem Selection
         property = obs_properties_add_list(
             properties,
@@ -110,6 +122,7 @@ namespace lvk
         );
         obs_property_list_add_string(property, L(PROP_SUBSYSTEM_HOMOG), L(PROP_SUBSYSTEM_HOMOG));
         obs_property_list_add_string(property, L(PROP_SUBSYSTEM_FIELD), L(PROP_SUBSYSTEM_FIELD));
+        obs_property_list_add_string(property, L(PROP_SUBSYSTEM_TRANS), L(PROP_SUBSYSTEM_TRANS));
 
         property = obs_properties_add_list(
             properties,
@@ -209,6 +222,7 @@ namespace lvk
 
         obs_data_set_default_string(settings,PROP_PREDICTIVE_SAMPLES, PROP_PREDICTIVE_SAMPLES_DEFAULT);
         obs_data_set_default_string(settings, PROP_QUALITY_ASSURANCE, PROP_QUALITY_ASSURANCE_DEFAULT);
+        obs_data_set_default_bool(settings, PROP_LOW_LATENCY, PROP_LOW_LATENCY_DEFAULT);
 		obs_data_set_default_int(settings, PROP_BACKGROUND_COLOUR, PROP_BACKGROUND_COLOUR_DEFAULT);
         obs_data_set_default_double(settings, PROP_CROP_PERCENTAGE_X, PROP_CROP_PERCENTAGE_DEFAULT);
         obs_data_set_default_double(settings, PROP_CROP_PERCENTAGE_Y, PROP_CROP_PERCENTAGE_DEFAULT);
@@ -233,6 +247,7 @@ namespace lvk
         const float crop_y = independent_crop ? obs_data_get_double(settings, PROP_CROP_PERCENTAGE_Y) * 0.01f : crop_x;
 
         m_Filter.reconfigure([&](StabilizationFilterSettings& stab_settings) {
+            stab_settings.frame_analysis = m_FrameAnalysis;
             stab_settings.crop_to_stable_region = obs_data_get_bool(settings, PROP_APPLY_CROP) && !m_TestMode;
 			stab_settings.stabilize_output = !obs_data_get_bool(settings, PROP_STAB_DISABLED);
             stab_settings.corrective_limits.height = crop_y;
@@ -242,6 +257,10 @@ namespace lvk
             const std::string samples = obs_data_get_string(settings, PROP_PREDICTIVE_SAMPLES);
             if(!samples.empty()) stab_settings.predictive_samples = std::stoi(samples);
 
+            // NOTE: the low latency mode ignores the smoothing radius.
+            stab_settings.low_latency = obs_data_get_bool(settings, PROP_LOW_LATENCY);
+            stab_settings.look_ahead_samples = PROP_LOW_LATENCY_LOOK_AHEAD;
+
 			// Decode the background colour in RGB.
 			uint32_t colour = obs_data_get_int(settings, PROP_BACKGROUND_COLOUR);
 			stab_settings.background_colour[0] = static_cast<float>(colour & 0xff);
@@ -258,6 +277,7 @@ namespace lvk
             {
                 stab_settings.detection_resolution = {480, 270};
                 stab_settings.acceptance_threshold = 10.0f;
+                stab_settings.use_phase_correlation = false;
                 stab_settings.track_local_motions = true;
                 stab_settings.motion_resolution = {16, 16};
                 stab_settings.detection_regions = {2, 2};
@@ -266,10 +286,19 @@ namespace lvk
                 stab_settings.min_feature_density = 0.06f;
                 stab_settings.accumulation_rate = 3.0f;
             }
+            else if(subsystem == L(PROP_SUBSYSTEM_TRANS))
+            {
+                stab_settings.detection_resolution = {480, 270};
+                stab_settings.use_phase_correlation = true;
+                stab_settings.correlate_tiles = false;
+                stab_settings.track_local_motions = false;
+                stab_settings.motion_resolution = {2, 2};
+            }
             else
             {
                 stab_settings.detection_resolution = {480, 270};
                 stab_settings.acceptance_threshold = 3.0f;
+                stab_settings.use_phase_correlation = false;
                 stab_settings.track_local_motions = false;
                 stab_settings.motion_resolution = {2, 2};
                 stab_settings.detection_regions = {2, 1};
@@ -293,6 +322,9 @@ namespace lvk
             }
 		});
 
+        // The filter reads its motion from our analysis, which tracks with the filter's settings.
+        m_FrameAnalysis->configure(m_Filter.settings());
+
         // Get FPS info for the stream.
         obs_video_info video_info = {};
         obs_get_video_info(&video_info);
@@ -353,6 +385,10 @@ namespace lvk
 	{
         LVK_PROFILE;
 
+        // The analysis is only read while stabilizing, so it is not advanced otherwise.
+        if(m_Filter.settings().stabilize_output)
+            m_FrameAnalysis->advance(frame);
+
         if(m_TestMode)
         {
             m_Filter.apply(std::move(frame), frame, true);
@@ -369,15 +405,16 @@ namespace lvk
 	{
         LVK_PROFILE;
 
-		const double frame_time_ms = m_Filter.timings().average().milliseconds();
-		const double deviation_ms = m_Filter.timings().deviation().milliseconds();
+		const double frame_time_ms = m_Filter.timings().host.average().milliseconds();
+		const double deviation_ms = m_Filter.timings().host.deviation().milliseconds();
+		const double device_time_ms = m_Filter.timings().device.average().milliseconds();
 		const auto& crop_region = m_Filter.stable_region();
 
 		draw_text(
 			frame,
-            cv::format("%.2fms (%.2fms)", frame_time_ms, deviation_ms),
+            cv::format("%.2fms (%.2fms) | GPU %.2fms", frame_time_ms, deviation_ms, device_time_ms),
 			crop_region.tl() + cv::Point(5, 40),
-			frame_time_ms < TIMING_THRESHOLD_MS ? col::GREEN[frame.format] : col::RED[frame.format]
+			std::max(frame_time_ms, device_time_ms) < TIMING_THRESHOLD_MS ? col::GREEN[frame.format] : col::RED[frame.format]
 		);
 		draw_rect(frame, crop_region, col::MAGENTA[frame.format]);
 	}
@@ -52,6 +52,7 @@ namespace lvk
 		obs_source_t* m_Context = nullptr;
 
 		StabilizationFilter m_Filter;
+		std::shared_ptr<FrameAnalysis> m_FrameAnalysis = std::make_shared<FrameAnalysis>();
 		bool m_TestMode = false;
 	};
 
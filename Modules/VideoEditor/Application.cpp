@@ -71,6 +71,12 @@ int main(int argc, char* argv[])
     nice(-40);
 #endif
 
+    // Overlapped queues must be opted into before any execution contexts are used.
+    lvk::ocl::ExecutionContext::SetOverlapping(configuration.overlap_queues);
+
+    // Compile and tune the OpenCL programs before processing starts.
+    lvk::ocl::warmup();
+    lvk::ocl::autotune();
 
     // Run the video processor
     if(auto error = processor.run(); error.has_value())
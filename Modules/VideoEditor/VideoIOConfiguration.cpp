@@ -17,7 +17,9 @@
 
 #include "VideoIOConfiguration.hpp"
 
+#include <algorithm>
 #include <fstream>
+#include <sstream>
 #include <opencv2/opencv.hpp>
 
 namespace clt
@@ -402,6 +404,15 @@ namespace clt
                 log_target = path;
             }
         );
+
+        // Runtime Options
+
+        m_OptionParser.add_switch(
+            "-q",
+            "Enables separate OpenCL queues for transfers, filtering and tracking, so that they can overlap. "
+            "This is experimental and has not been validated on all OpenCL runtimes.",
+            &overlap_queues
+        );
     }
 
 //---------------------------------------------------------------------------------------------------------------------
@@ -412,7 +423,7 @@ namespace clt
         m_FilterParser.add_filter<lvk::StabilizationFilter, lvk::StabilizationFilterSettings>(
             {"vs", "stab"},
             "A video stabilization filter used to smoothen percieved camera motions.",
-            [](clt::OptionsParser& config_parser, lvk::StabilizationFilterSettings& config){
+            [this](clt::OptionsParser& config_parser, lvk::StabilizationFilterSettings& config){
                 config_parser.add_variable<float>(
                     {".crop_prop", ".cp"},
                     "Used to set percentage crop and movement area allowed for stabilization",
@@ -431,6 +442,87 @@ namespace clt
                     "The amount of camera smoothing to apply to the video.",
                     &config.predictive_samples
                 );
+                config_parser.add_switch(
+                    {".low_latency", ".ll"},
+                    "Use a causal smoothing filter, which only delays the video by the look-ahead.",
+                    &config.low_latency
+                );
+                config_parser.add_variable(
+                    {".look_ahead", ".la"},
+                    "The number of frames (0-3) the low latency mode looks ahead.",
+                    &config.look_ahead_samples
+                );
+                config_parser.add_switch(
+                    {".compact_queue", ".cq"},
+                    "Store the delayed frames as NV12, to reduce the memory used by the delay.",
+                    &config.compact_frame_storage
+                );
+                config_parser.add_variable(
+                    {".queue_limit", ".ql"},
+                    "The device memory (MB) the delayed frames may use before spilling to host memory.",
+                    &config.frame_memory_limit_mb
+                );
+                config_parser.add_switch(
+                    {".shared_analysis", ".sa"},
+                    "Read the motion from the frame analysis shared by the filter chain, which is tracked once per "
+                    "frame using the tracking options of the first filter to share it.",
+                    [&, this](){
+                        if(frame_analysis == nullptr)
+                            frame_analysis = std::make_shared<lvk::FrameAnalysis>();
+                        config.frame_analysis = frame_analysis;
+                    }
+                );
+                config_parser.add_switch(
+                    {".translation", ".tr"},
+                    "Only stabilize translations, using fast phase correlation.",
+                    &config.use_phase_correlation
+                );
+                config_parser.add_variable(
+                    {".gyro", ".g"},
+                    "Stabilize using the rotations of a gyro log (CSV or Gyroflow .gcsv), instead of tracking.",
+                    &config.gyro_log
+                );
+                config_parser.add_variable(
+                    {".gyro_sync"},
+                    "The offset in milliseconds added to the gyro log timestamps to synchronize them with the video.",
+                    &config.gyro_sync_offset_ms
+                );
+                config_parser.add_parser(
+                    {".lens", ".l"},
+                    "Corrects lens distortion in the same warp as the stabilization, using the camera_matrix and "
+                    "distortion_coefficients (and optional image_width, image_height) of an OpenCV calibration file.",
+                    [&](ArgQueue& arguments){
+                        if(arguments.size() < 2)
+                            return false;
+
+                        cv::FileStorage file(arguments[1], cv::FileStorage::READ);
+                        if(!file.isOpened())
+                            return false;
+
+                        cv::Mat camera_matrix, distortion_coefficients;
+                        file["camera_matrix"] >> camera_matrix;
+                        file["distortion_coefficients"] >> distortion_coefficients;
+                        if(camera_matrix.size() != cv::Size(3, 3))
+                            return false;
+
+                        cv::Mat_<double> coefficients;
+                        distortion_coefficients.convertTo(coefficients, CV_64FC1);
+                        auto& distortion = config.camera_parameters.distortion_coefficients;
+                        distortion.assign(coefficients.begin(), coefficients.end());
+                        camera_matrix.convertTo(config.camera_parameters.camera_matrix, CV_64FC1);
+                        if(!file["image_width"].empty() && !file["image_height"].empty())
+                        {
+                            config.calibration_resolution.width = static_cast<int>(file["image_width"]);
+                            config.calibration_resolution.height = static_cast<int>(file["image_height"]);
+                        }
+                        config.correct_lens = true;
+
+                        // Only consume the arguments once the parameters are loaded.
+                        arguments.pop_front();
+                        arguments.pop_front();
+                        return true;
+                    }
+                );
             }
         );
 
@@ -443,6 +535,61 @@ namespace clt
                     "Used to specify the number of deblocking passes to perform.",
                     &config.detection_levels
                 );
+                config_parser.add_switch(
+                    {".tiled", ".t"},
+                    "Used to process the frame in cache-sized tiles, for CPU-only systems.",
+                    &config.tiled_processing
+                );
+            }
+        );
+
+        m_FilterParser.add_filter<lvk::ScalingLadderFilter, lvk::ScalingLadderFilterSettings>(
+            {"sl", "ladder"},
+            "A scaling filter which produces several output resolutions from one input, such as for an ABR ladder. "
+            "When last in the chain, each rung after the first is written next to the output target.",
+            [](clt::OptionsParser& config_parser, lvk::ScalingLadderFilterSettings& config){
+                config_parser.add_parser(
+                    {".rungs", ".r"},
+                    "The comma separated output sizes of the ladder, e.g. 1920x1080,1280x720,854x480. The first "
+                    "size is the filter output, the others are suffixed with their size in the output file name.",
+                    [&](ArgQueue& arguments){
+                        if(arguments.size() < 2)
+                            return false;
+
+                        std::vector<cv::Size> rungs;
+                        std::stringstream rung_list(arguments[1]);
+                        for(std::string rung; std::getline(rung_list, rung, ',');)
+                        {
+                            cv::Size size;
+                            char separator = 0;
+
+                            std::stringstream parser(rung);
+                            parser >> size.width >> separator >> size.height;
+                            if(parser.fail() || separator != 'x' || size.width <= 0 || size.height <= 0)
+                                return false;
+
+                            // Each rung is written to a file named by its size, so they must be unique.
+                            if(std::find(rungs.begin(), rungs.end(), size) != rungs.end())
+                                return false;
+
+                            rungs.push_back(size);
+                        }
+
+                        if(rungs.empty())
+                            return false;
+                        config.rungs = std::move(rungs);
+
+                        // Only consume the arguments once the rungs are parsed.
+                        arguments.pop_front();
+                        arguments.pop_front();
+                        return true;
+                    }
+                );
+                config_parser.add_variable(
+                    {".sharpness", ".s"},
+                    "The sharpness, between 0 and 1, applied to the rungs which are upscaled.",
+                    &config.sharpness
+                );
             }
         );
     }
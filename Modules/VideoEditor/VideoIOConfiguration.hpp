@@ -34,6 +34,7 @@ namespace clt
         // Input / Process Settings
         std::variant<std::monostate, std::filesystem::path, uint32_t> input_source;
         std::vector<std::shared_ptr<lvk::VideoFilter>> filter_chain;
+        std::shared_ptr<lvk::FrameAnalysis> frame_analysis;
 
         // Output Settings
         std::optional<std::filesystem::path> output_target;
@@ -48,6 +49,8 @@ namespace clt
         bool print_timings = false;
         std::optional<std::filesystem::path> log_target;
 
+        bool overlap_queues = false;
+
         lvk::Time update_period = lvk::Time::Seconds(0.5);
 
     public:
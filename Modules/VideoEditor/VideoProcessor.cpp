@@ -68,6 +68,20 @@ namespace clt
         if(input_error.has_value())
             return input_error;
 
+        // Track the shared analysis with the settings of the first filter which reads it.
+        if(const auto& analysis = m_Configuration.frame_analysis; analysis != nullptr)
+        {
+            for(auto& filter : m_Configuration.filter_chain)
+            {
+                auto stabilizer = std::dynamic_pointer_cast<lvk::StabilizationFilter>(filter);
+                if(stabilizer != nullptr && stabilizer->settings().frame_analysis == analysis)
+                {
+                    analysis->configure(stabilizer->settings());
+                    break;
+                }
+            }
+        }
+
         // Configure the filter
         m_Processor.reconfigure([&](lvk::CompositeFilterSettings& settings){
             for(auto& filter : m_Configuration.filter_chain)
@@ -75,6 +89,7 @@ namespace clt
                 filter->set_timing_samples(FILTER_TIMING_SAMPLES);
                 settings.filter_chain.push_back(filter);
             }
+            settings.frame_analysis = m_Configuration.frame_analysis;
         });
 
         // Load data logger
@@ -92,19 +107,53 @@ namespace clt
 
 //---------------------------------------------------------------------------------------------------------------------
 
-    std::optional<std::string> VideoProcessor::initialize_output_stream(const cv::Size frame_size)
+    std::optional<std::string> VideoProcessor::initialize_output_stream(const lvk::Frame& frame)
     {
         if(!m_Configuration.output_target.has_value())
             return "Could not create output stream, no target was specified";
 
+        const auto& target = *m_Configuration.output_target;
+        if(auto stream_error = open_output_stream(m_OutputStream, target, frame.size()); stream_error.has_value())
+            return stream_error;
+
+        // Each other rendition of the output, such as the other rungs of a scaling ladder, is written next
+        // to the output target, with a separate stream whose file name is suffixed with the rendition size.
+        m_RungStreams.clear();
+        m_RungStreams.resize(frame.renditions.size());
+        for(size_t i = 0; i < frame.renditions.size(); i++)
+        {
+            const cv::Size rung_size = frame.renditions[i].size();
+
+            auto rung_target = target;
+            rung_target.replace_filename(
+                target.stem().string()
+                + cv::format("_%dx%d", rung_size.width, rung_size.height)
+                + target.extension().string()
+            );
+
+            if(auto stream_error = open_output_stream(m_RungStreams[i], rung_target, rung_size))
+                return stream_error;
+        }
+
+        return std::nullopt;
+    }
+
+//---------------------------------------------------------------------------------------------------------------------
+
+    std::optional<std::string> VideoProcessor::open_output_stream(
+        cv::VideoWriter& stream,
+        const std::filesystem::path& target,
+        const cv::Size frame_size
+    )
+    {
         try {
             std::vector<int> properties = {
                 cv::VideoWriterProperties::VIDEOWRITER_PROP_HW_ACCELERATION, 1,
                 cv::VideoWriterProperties::VIDEOWRITER_PROP_HW_ACCELERATION_USE_OPENCL, 1
             };
 
-            m_OutputStream = cv::VideoWriter(
-                m_Configuration.output_target->string(),
+            stream = cv::VideoWriter(
+                target.string(),
                 cv::CAP_FFMPEG,
                 m_Configuration.output_codec.value_or(
                     static_cast<int>(m_InputStream.get(cv::CAP_PROP_FOURCC))
@@ -125,11 +174,11 @@ namespace clt
         }
 
         // If stream is still not opened, then creation failed
-        if(!m_OutputStream.isOpened())
+        if(!stream.isOpened())
         {
             return cv::format(
                 "Failed to create an output stream at \'%s\'",
-                m_Configuration.output_target->string().c_str()
+                target.string().c_str()
             );
         }
 
@@ -172,12 +221,22 @@ namespace clt
                     // Lazily initialize the output stream on first output frame
                     if(!m_OutputStream.isOpened())
                     {
-                        runtime_error = initialize_output_stream(frame.size());
+                        runtime_error = initialize_output_stream(frame);
                         if(runtime_error.has_value())
                             return true;
                     }
 
+                    // NOTE: the rungs are carried by the frame, as the ladder may
+                    // already be filtering later frames on the filter thread.
+                    if(frame.renditions.size() != m_RungStreams.size())
+                    {
+                        runtime_error = "The number of output renditions changed after the output streams were opened";
+                        return true;
+                    }
+
                     m_OutputStream.write(frame);
+                    for(size_t i = 0; i < m_RungStreams.size(); i++)
+                        m_RungStreams[i].write(frame.renditions[i]);
                 }
 
                 // Display output
@@ -296,13 +355,14 @@ namespace clt
         for(size_t i = 0; i < m_Processor.filter_count(); i++)
         {
             auto filter = m_Processor.filters(i);
-            auto average_timing = filter->timings().average();
+            auto average_timing = filter->timings().host.average();
 
             m_ConsoleLogger << std::to_string(i) <<  ".   "
                             << filter->alias()
                             << "\t" << average_timing.milliseconds() << "ms"
-                            << " +/- " << filter->timings().deviation().milliseconds() << "ms"
+                            << " +/- " << filter->timings().host.deviation().milliseconds() << "ms"
                             << "   (" << static_cast<uint64_t>(average_timing.frequency()) << "FPS)"
+                            << "   GPU: " << filter->timings().device.average().milliseconds() << "ms"
                             << ConsoleLogger::Next;
         }
     }
@@ -324,6 +384,7 @@ namespace clt
             // 3. All filter frametimes
             // 4. Processor deviation
             // 5. All filter deviations
+            // 6. All filter device times
 
             logger << "Output Frame";
 
@@ -336,6 +397,10 @@ namespace clt
             for(auto& filter : m_Processor.filters())
                 logger << (filter->alias() + " Deviation (ms)");
 
+            // Then log all the device times
+            for(auto& filter : m_Processor.filters())
+                logger << (filter->alias() + " Device Time (ms)");
+
             logger.next();
         }
 
@@ -345,12 +410,16 @@ namespace clt
         // write all frametimes
         logger << m_FrameTimer.average().milliseconds();
         for(auto& filter : m_Processor.filters())
-            logger << filter->timings().average().milliseconds();
+            logger << filter->timings().host.average().milliseconds();
 
         // write all frame deviation times
         logger << m_FrameTimer.deviation().milliseconds();
         for(auto& filter : m_Processor.filters())
-            logger << filter->timings().deviation().milliseconds();
+            logger << filter->timings().host.deviation().milliseconds();
+
+        // write all device times
+        for(auto& filter : m_Processor.filters())
+            logger << filter->timings().device.average().milliseconds();
 
         logger.next();
     }
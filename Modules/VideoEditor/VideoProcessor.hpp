@@ -40,7 +40,13 @@ namespace clt
 
         std::optional<std::string> initialize_configuration();
 
-        std::optional<std::string> initialize_output_stream(const cv::Size frame_size);
+        std::optional<std::string> initialize_output_stream(const lvk::Frame& frame);
+
+        std::optional<std::string> open_output_stream(
+            cv::VideoWriter& stream,
+            const std::filesystem::path& target,
+            const cv::Size frame_size
+        );
 
         void write_to_loggers();
 
@@ -64,6 +70,8 @@ namespace clt
         cv::VideoWriter m_OutputStream;
         lvk::CompositeFilter m_Processor;
 
+        std::vector<cv::VideoWriter> m_RungStreams;
+
         bool m_Terminate = false;
         lvk::TickTimer m_FrameTimer;
         lvk::Stopwatch m_ProcessTimer;